@@ -0,0 +1,204 @@
+/**
+ * @file gateway_route_table_benchmark.cpp
+ * @brief 网关路由表基准测试 - 全局读写锁 vs 分片路由表（5000 连接）
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include "gateway/route_table.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+constexpr uint64_t kSessionCount = 5000;
+// 每隔多少次查找做一次全表清理（模拟 CleanupStaleRoutes 与登记/注销的写锁）
+constexpr uint64_t kCleanupInterval = 4096;
+
+/**
+ * @brief 仅用于构造会话的空 Socket
+ */
+class IdleSocket : public mir2::network::SocketAdapter {
+public:
+    explicit IdleSocket(mir2::network::IoExecutor executor) : executor_(std::move(executor)) {}
+
+    void async_read_some(const asio::mutable_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+    void async_write(const asio::const_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+    void shutdown(asio::ip::tcp::socket::shutdown_type /*type*/, asio::error_code& ec) override {
+        ec.clear();
+    }
+    void close(asio::error_code& ec) override { ec.clear(); }
+    asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override {
+        ec.clear();
+        return {};
+    }
+    mir2::network::IoExecutor GetExecutor() override { return executor_; }
+
+private:
+    mir2::network::IoExecutor executor_;
+};
+
+struct SessionFixture {
+    asio::io_context io_context;
+    std::vector<std::shared_ptr<mir2::network::TcpSession>> sessions;
+
+    SessionFixture() {
+        sessions.reserve(kSessionCount);
+        for (uint64_t id = 1; id <= kSessionCount; ++id) {
+            sessions.push_back(std::make_shared<mir2::network::TcpSession>(
+                std::make_shared<mir2::network::TcpConnection>(
+                    std::make_unique<IdleSocket>(io_context.get_executor()), id)));
+        }
+    }
+};
+
+SessionFixture& Fixture() {
+    static SessionFixture fixture;
+    return fixture;
+}
+
+int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief 旧实现：一把 shared_mutex 保护整张路由表，等待时间同样在发生竞争时统计
+ */
+struct GlobalRouteTable {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<mir2::network::TcpSession>> routes;
+    mutable std::atomic<uint64_t> lock_wait_ns{0};
+
+    std::shared_ptr<mir2::network::TcpSession> Find(uint64_t key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            const int64_t start_ns = SteadyNowNs();
+            lock.lock();
+            lock_wait_ns.fetch_add(static_cast<uint64_t>(SteadyNowNs() - start_ns),
+                                   std::memory_order_relaxed);
+        }
+        auto it = routes.find(key);
+        return it != routes.end() ? it->second : nullptr;
+    }
+
+    void Cleanup() {
+        std::unique_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            const int64_t start_ns = SteadyNowNs();
+            lock.lock();
+            lock_wait_ns.fetch_add(static_cast<uint64_t>(SteadyNowNs() - start_ns),
+                                   std::memory_order_relaxed);
+        }
+        for (const auto& [key, session] : routes) {
+            benchmark::DoNotOptimize(session->GetState());
+        }
+    }
+};
+
+GlobalRouteTable& GlobalTable() {
+    static GlobalRouteTable* table = [] {
+        auto* created = new GlobalRouteTable();
+        for (const auto& session : Fixture().sessions) {
+            created->routes[session->GetSessionId()] = session;
+        }
+        return created;
+    }();
+    return *table;
+}
+
+mir2::gateway::RouteTable& ShardedTable() {
+    static mir2::gateway::RouteTable* table = [] {
+        auto* created = new mir2::gateway::RouteTable();
+        for (const auto& session : Fixture().sessions) {
+            created->Insert(session->GetSessionId(), session);
+        }
+        return created;
+    }();
+    return *table;
+}
+
+}  // namespace
+
+/**
+ * @brief 基线：所有查找与清理争用同一把全局读写锁
+ */
+static void BM_RouteLookup_GlobalSharedMutex(benchmark::State& state) {
+    auto& table = GlobalTable();
+    if (state.thread_index() == 0) {
+        table.lock_wait_ns.store(0);
+    }
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) * 7919;
+    uint64_t ops = 0;
+    for (auto _ : state) {
+        id = id % kSessionCount + 1;
+        benchmark::DoNotOptimize(table.Find(id));
+        if (++ops % kCleanupInterval == 0) {
+            table.Cleanup();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        state.counters["lock_wait_ns_per_op"] = benchmark::Counter(
+            static_cast<double>(table.lock_wait_ns.load()) /
+            static_cast<double>(state.iterations() * static_cast<uint64_t>(state.threads())));
+    }
+}
+
+/**
+ * @brief 分片路由表：查找只锁一个分片，清理逐分片进行
+ */
+static void BM_RouteLookup_ShardedRouteTable(benchmark::State& state) {
+    auto& table = ShardedTable();
+    const uint64_t wait_before = table.GetLockWaitNs();
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) * 7919;
+    uint64_t ops = 0;
+    for (auto _ : state) {
+        id = id % kSessionCount + 1;
+        benchmark::DoNotOptimize(table.Find(id));
+        if (++ops % kCleanupInterval == 0) {
+            table.EraseIf([](uint64_t, const std::shared_ptr<mir2::network::TcpSession>& session) {
+                benchmark::DoNotOptimize(session->GetState());
+                return false;
+            });
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        state.counters["lock_wait_ns_per_op"] = benchmark::Counter(
+            static_cast<double>(table.GetLockWaitNs() - wait_before) /
+            static_cast<double>(state.iterations() * static_cast<uint64_t>(state.threads())));
+    }
+}
+
+/**
+ * @brief 会话上的路由缓存：Tick 检查是否已登记只读一个原子标记
+ */
+static void BM_RouteLookup_SessionCachedFlag(benchmark::State& state) {
+    const auto& sessions = Fixture().sessions;
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        id = id % kSessionCount;
+        benchmark::DoNotOptimize(sessions[id]->IsRouteRegistered());
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RouteLookup_GlobalSharedMutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_RouteLookup_ShardedRouteTable)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_RouteLookup_SessionCachedFlag)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+/**
+ * @file io_uring_benchmark.cpp
+ * @brief Socket 后端对比基准测试 - 本地回环 TCP，asio 与 io_uring 并列
+ *
+ * 参数首项为后端：0 = asio，1 = io_uring（不可用时跳过）。
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/write.hpp>
+
+#include "network/packet_codec.h"
+#include "network/socket_backend.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+mir2::network::SocketBackend BackendArg(int64_t value) {
+    return value == 0 ? mir2::network::SocketBackend::kAsio
+                      : mir2::network::SocketBackend::kIoUring;
+}
+
+/**
+ * @brief 回环连接：服务端连接使用指定后端，对端为普通 asio socket
+ */
+struct BackendPair {
+    asio::io_context io_context;
+    asio::ip::tcp::socket peer{io_context};
+    std::shared_ptr<mir2::network::TcpConnection> connection;
+    std::array<uint8_t, 64 * 1024> drain_buffer{};
+    uint64_t bytes_received = 0;
+
+    explicit BackendPair(mir2::network::SocketBackend backend) {
+        asio::ip::tcp::acceptor acceptor(
+            io_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        peer.connect(acceptor.local_endpoint());
+        peer.set_option(asio::ip::tcp::no_delay(true));
+        asio::ip::tcp::socket server_socket(io_context);
+        acceptor.accept(server_socket);
+
+        connection = std::make_shared<mir2::network::TcpConnection>(
+            mir2::network::CreateSocketAdapter(std::move(server_socket), backend), 1);
+    }
+
+    void Drain() {
+        peer.async_read_some(asio::buffer(drain_buffer),
+                             [this](const asio::error_code& ec, std::size_t bytes) {
+                                 if (ec) {
+                                     return;
+                                 }
+                                 bytes_received += bytes;
+                                 Drain();
+                             });
+    }
+
+    void RunUntilReceived(uint64_t target) {
+        while (bytes_received < target) {
+            io_context.run_one();
+        }
+    }
+};
+
+bool SkipUnavailable(benchmark::State& state, mir2::network::SocketBackend backend) {
+    if (mir2::network::IsSocketBackendAvailable(backend)) {
+        return false;
+    }
+    state.SkipWithError("socket backend unavailable");
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief 请求-应答往返：对端写入一个帧，服务端原样回显，统计单次往返时延
+ *
+ * 参数：{后端, 负载字节}
+ */
+static void BM_EchoRoundTrip(benchmark::State& state) {
+    const auto backend = BackendArg(state.range(0));
+    if (SkipUnavailable(state, backend)) {
+        return;
+    }
+    const std::vector<uint8_t> payload(static_cast<size_t>(state.range(1)), 0x5A);
+
+    BackendPair pair(backend);
+    pair.connection->SetReadHandler([&pair](const uint8_t* data, size_t size) {
+        pair.connection->SendRaw(std::vector<uint8_t>(data, data + size));
+    });
+    pair.connection->Start();
+    pair.Drain();
+
+    uint64_t expected = 0;
+    for (auto _ : state) {
+        asio::write(pair.peer, asio::buffer(payload));
+        expected += payload.size();
+        pair.RunUntilReceived(expected);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(expected));
+    pair.connection->Close();
+}
+
+BENCHMARK(BM_EchoRoundTrip)
+    ->ArgsProduct({{0, 1}, {32, 1024}})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 单向吞吐：一次 tick 内的突发小包经会话写出，对端持续读空
+ *
+ * 参数：{后端, 每次突发包数, 负载字节}
+ */
+static void BM_BurstThroughput(benchmark::State& state) {
+    const auto backend = BackendArg(state.range(0));
+    if (SkipUnavailable(state, backend)) {
+        return;
+    }
+    const int burst = static_cast<int>(state.range(1));
+    const std::vector<uint8_t> payload(static_cast<size_t>(state.range(2)), 0x3C);
+    const auto frame_size = mir2::network::PacketCodec::Encode(1, payload.data(), payload.size()).size();
+
+    BackendPair pair(backend);
+    auto session = std::make_shared<mir2::network::TcpSession>(pair.connection);
+    session->Start();
+    pair.Drain();
+
+    uint64_t expected = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < burst; ++i) {
+            session->Send(1, payload);
+        }
+        expected += frame_size * static_cast<uint64_t>(burst);
+        pair.RunUntilReceived(expected);
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+    state.SetBytesProcessed(static_cast<int64_t>(expected));
+    session->Close();
+}
+
+BENCHMARK(BM_BurstThroughput)
+    ->ArgsProduct({{0, 1}, {8, 200}, {16, 512}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
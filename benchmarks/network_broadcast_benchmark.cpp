@@ -0,0 +1,136 @@
+/**
+ * @file network_broadcast_benchmark.cpp
+ * @brief 广播性能基准测试 - 逐会话编码 vs 共享帧
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+
+#include "network/shared_frame.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+constexpr uint16_t kBroadcastMsgId = 1001;
+constexpr size_t kPayloadSize = 256;
+
+/**
+ * @brief 丢弃写入数据的 Socket，写完成经 io_context 回调
+ */
+class NullSocket : public mir2::network::SocketAdapter {
+public:
+    explicit NullSocket(mir2::network::IoExecutor executor) : executor_(std::move(executor)) {}
+
+    void async_read_some(const asio::mutable_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+
+    void async_write(const asio::const_buffer& buffer, IoHandler handler) override {
+        const auto bytes = buffer.size();
+        asio::post(executor_, [handler = std::move(handler), bytes]() { handler({}, bytes); });
+    }
+
+    void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                            IoHandler handler) override {
+        const auto bytes = asio::buffer_size(buffers);
+        asio::post(executor_, [handler = std::move(handler), bytes]() { handler({}, bytes); });
+    }
+
+    void shutdown(asio::ip::tcp::socket::shutdown_type /*type*/, asio::error_code& ec) override {
+        ec.clear();
+    }
+
+    void close(asio::error_code& ec) override { ec.clear(); }
+
+    asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override {
+        ec.clear();
+        return {};
+    }
+
+    mir2::network::IoExecutor GetExecutor() override { return executor_; }
+
+private:
+    mir2::network::IoExecutor executor_;
+};
+
+/**
+ * @brief 创建挂在 NullSocket 上的会话集合
+ */
+std::vector<std::shared_ptr<mir2::network::TcpSession>> CreateSessions(
+    asio::io_context& io_context, int count, mir2::network::ProtocolVersion version) {
+    std::vector<std::shared_ptr<mir2::network::TcpSession>> sessions;
+    sessions.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto connection = std::make_shared<mir2::network::TcpConnection>(
+            std::make_unique<NullSocket>(io_context.get_executor()), static_cast<uint32_t>(i + 1));
+        auto session = std::make_shared<mir2::network::TcpSession>(connection);
+        session->SetProtocolVersion(version);
+        session->Start();
+        sessions.push_back(std::move(session));
+    }
+    return sessions;
+}
+
+void DrainIo(asio::io_context& io_context) {
+    io_context.restart();
+    io_context.poll();
+}
+
+mir2::network::ProtocolVersion VersionArg(const benchmark::State& state) {
+    return state.range(1) == 2 ? mir2::network::ProtocolVersion::kV2
+                               : mir2::network::ProtocolVersion::kV1;
+}
+
+}  // namespace
+
+/**
+ * @brief 基线：每个会话各自编码一次（旧 Broadcast 行为）
+ */
+static void BM_Broadcast_PerSessionEncode(benchmark::State& state) {
+    asio::io_context io_context;
+    const auto sessions = CreateSessions(io_context, static_cast<int>(state.range(0)),
+                                         VersionArg(state));
+    const std::vector<uint8_t> payload(kPayloadSize, 0x5A);
+
+    for (auto _ : state) {
+        for (const auto& session : sessions) {
+            session->Send(kBroadcastMsgId, payload);
+        }
+        DrainIo(io_context);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief 共享帧：负载只编码一次，会话间共享字节
+ */
+static void BM_Broadcast_SharedFrame(benchmark::State& state) {
+    asio::io_context io_context;
+    const auto sessions = CreateSessions(io_context, static_cast<int>(state.range(0)),
+                                         VersionArg(state));
+    const std::vector<uint8_t> payload(kPayloadSize, 0x5A);
+
+    for (auto _ : state) {
+        const auto frame = mir2::network::SharedFrame::Create(kBroadcastMsgId, payload);
+        for (const auto& session : sessions) {
+            session->SendFrame(frame);
+        }
+        DrainIo(io_context);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 注册基准测试：{会话数, 协议版本}
+BENCHMARK(BM_Broadcast_PerSessionEncode)
+    ->ArgsProduct({{100, 1000, 5000}, {1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Broadcast_SharedFrame)
+    ->ArgsProduct({{100, 1000, 5000}, {1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,257 @@
+/**
+ * @file network_loopback_benchmark.cpp
+ * @brief 传输栈基准测试 - 本地回环上的 NetworkManager 与多个并发客户端
+ *
+ * 覆盖 TcpServer → TcpConnection → TcpSession（拆包、解码）→ MessageDispatcher 全链路，
+ * 报告消息/字节吞吐、客户端写出到处理函数执行的延迟分位数，以及服务端 IO 线程上
+ * 每条消息的堆分配次数。作为网络层各项优化的对照基线。
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/write.hpp>
+
+#include "network/network_manager.h"
+#include "network/packet_codec.h"
+
+namespace {
+
+std::atomic<uint64_t> g_server_allocations{0};
+// 只统计服务端 IO 线程上的分配，客户端编码与发送不计入
+thread_local bool g_count_allocations = false;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (g_count_allocations) {
+        g_server_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+namespace {
+
+constexpr uint16_t kBenchMsgId = 0x7F01;
+
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief 对数分桶延迟直方图（每个 2 的幂区间 16 个子桶，相对误差约 6%），记录时不分配
+ */
+class LatencyHistogram {
+public:
+    void Record(uint64_t value) {
+        ++counts_[Index(value)];
+        ++total_;
+    }
+
+    uint64_t Percentile(double p) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        const auto target = static_cast<uint64_t>(p * static_cast<double>(total_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                return LowerBound(i);
+            }
+        }
+        return LowerBound(counts_.size() - 1);
+    }
+
+private:
+    static constexpr int kSubBits = 4;
+    static constexpr uint64_t kSubCount = uint64_t{1} << kSubBits;
+
+    static size_t Index(uint64_t value) {
+        if (value < kSubCount) {
+            return static_cast<size_t>(value);
+        }
+        const int msb = 63 - std::countl_zero(value);
+        const uint64_t sub = (value >> (msb - kSubBits)) & (kSubCount - 1);
+        return (static_cast<size_t>(msb - kSubBits + 1) << kSubBits) + static_cast<size_t>(sub);
+    }
+
+    static uint64_t LowerBound(size_t index) {
+        if (index < kSubCount) {
+            return index;
+        }
+        const int msb = static_cast<int>(index >> kSubBits) + kSubBits - 1;
+        return (kSubCount + (index & (kSubCount - 1))) << (msb - kSubBits);
+    }
+
+    std::array<uint64_t, (64 - kSubBits + 1) << kSubBits> counts_{};
+    uint64_t total_ = 0;
+};
+
+/**
+ * @brief 回环服务端：独立 IO 线程运行 NetworkManager，处理函数记录分发延迟
+ */
+struct LoopbackServer {
+    asio::io_context io_context;
+    asio::executor_work_guard<asio::io_context::executor_type> work{io_context.get_executor()};
+    mir2::network::NetworkManager network{io_context};
+    LatencyHistogram latency;
+    std::atomic<uint64_t> received{0};
+    std::thread io_thread;
+
+    LoopbackServer() {
+        // 压测流量远超默认的每会话限速
+        network.SetRateLimit(0, 0);
+        network.RegisterHandler(kBenchMsgId, [this](const std::shared_ptr<mir2::network::TcpSession>&,
+                                                    std::span<const uint8_t> payload) {
+            int64_t sent_ns = 0;
+            std::memcpy(&sent_ns, payload.data(), sizeof(sent_ns));
+            latency.Record(static_cast<uint64_t>(std::max<int64_t>(NowNs() - sent_ns, 0)));
+            received.fetch_add(1, std::memory_order_release);
+        });
+        network.Start("127.0.0.1", 0, 4096);
+        io_thread = std::thread([this]() {
+            g_count_allocations = true;
+            io_context.run();
+        });
+    }
+
+    ~LoopbackServer() {
+        network.Stop();
+        work.reset();
+        io_context.stop();
+        io_thread.join();
+    }
+
+    void WaitForReceived(uint64_t target) const {
+        while (received.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * @brief 阻塞式客户端：每次突发把若干帧拼成一次写出
+ */
+struct LoopbackClient {
+    asio::ip::tcp::socket socket;
+    uint16_t sequence = 0;
+    std::vector<uint8_t> burst_bytes;
+
+    LoopbackClient(asio::io_context& io_context, uint16_t port) : socket(io_context) {
+        socket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+        socket.set_option(asio::ip::tcp::no_delay(true));
+    }
+
+    void SendBurst(int version, int burst, std::vector<uint8_t>& payload) {
+        burst_bytes.clear();
+        for (int i = 0; i < burst; ++i) {
+            const int64_t now_ns = NowNs();
+            std::memcpy(payload.data(), &now_ns, sizeof(now_ns));
+            const auto frame =
+                version == 2
+                    ? mir2::network::PacketCodec::EncodeV2(kBenchMsgId, payload.data(), payload.size(),
+                                                           ++sequence)
+                    : mir2::network::PacketCodec::Encode(kBenchMsgId, payload.data(), payload.size());
+            burst_bytes.insert(burst_bytes.end(), frame.begin(), frame.end());
+        }
+        asio::write(socket, asio::buffer(burst_bytes));
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief 多客户端并发上行：每轮每个客户端写出一次突发，等待服务端全部分发
+ *
+ * 参数：{协议版本, 客户端数, 负载字节, 每客户端每轮消息数}
+ * p50/p99/p999_us 为客户端编码时刻到处理函数执行的延迟；allocs_per_message 为服务端
+ * IO 线程上每条消息的堆分配次数。
+ */
+static void BM_LoopbackDispatch(benchmark::State& state) {
+    const int version = static_cast<int>(state.range(0));
+    const int client_count = static_cast<int>(state.range(1));
+    const int burst = static_cast<int>(state.range(3));
+    std::vector<uint8_t> payload(std::max<size_t>(static_cast<size_t>(state.range(2)), sizeof(int64_t)),
+                                 0x5A);
+
+    LoopbackServer server;
+    asio::io_context client_context;
+    std::vector<std::unique_ptr<LoopbackClient>> clients;
+    for (int i = 0; i < client_count; ++i) {
+        clients.push_back(std::make_unique<LoopbackClient>(client_context, server.network.GetListenPort()));
+    }
+    while (server.network.GetConnectionCount() < static_cast<size_t>(client_count)) {
+        std::this_thread::yield();
+    }
+
+    // 预热：建立会话缓冲、检测协议版本
+    uint64_t expected = 0;
+    for (auto& client : clients) {
+        client->SendBurst(version, burst, payload);
+        expected += static_cast<uint64_t>(burst);
+    }
+    server.WaitForReceived(expected);
+    server.latency = LatencyHistogram{};
+
+    const uint64_t alloc_before = g_server_allocations.load(std::memory_order_relaxed);
+    const uint64_t received_before = expected;
+    for (auto _ : state) {
+        for (auto& client : clients) {
+            client->SendBurst(version, burst, payload);
+        }
+        expected += static_cast<uint64_t>(client_count) * static_cast<uint64_t>(burst);
+        server.WaitForReceived(expected);
+    }
+    const uint64_t allocations = g_server_allocations.load(std::memory_order_relaxed) - alloc_before;
+    const uint64_t messages = expected - received_before;
+    const size_t frame_size = version == 2
+                                  ? mir2::network::PacketCodec::EncodeV2(kBenchMsgId, payload.data(),
+                                                                         payload.size(), 0)
+                                        .size()
+                                  : mir2::network::PacketCodec::Encode(kBenchMsgId, payload.data(),
+                                                                       payload.size())
+                                        .size();
+
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+    state.SetBytesProcessed(static_cast<int64_t>(messages * frame_size));
+    state.counters["p50_us"] = benchmark::Counter(static_cast<double>(server.latency.Percentile(0.50)) / 1000.0);
+    state.counters["p99_us"] = benchmark::Counter(static_cast<double>(server.latency.Percentile(0.99)) / 1000.0);
+    state.counters["p999_us"] = benchmark::Counter(static_cast<double>(server.latency.Percentile(0.999)) / 1000.0);
+    state.counters["allocs_per_message"] = benchmark::Counter(
+        messages == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(messages));
+
+    for (auto& client : clients) {
+        asio::error_code ec;
+        client->socket.close(ec);
+    }
+}
+
+BENCHMARK(BM_LoopbackDispatch)
+    ->ArgsProduct({{1, 2}, {1, 16, 128}, {32, 512}, {16}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+/**
+ * @file network_send_benchmark.cpp
+ * @brief 发送路径基准测试 - 池化帧缓冲下的每消息堆分配次数
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+
+#include "network/buffer_pool.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+namespace {
+
+/**
+ * @brief 丢弃写入数据的 Socket，写完成经 io_context 回调
+ */
+class NullSocket : public mir2::network::SocketAdapter {
+public:
+    explicit NullSocket(mir2::network::IoExecutor executor) : executor_(std::move(executor)) {}
+
+    void async_read_some(const asio::mutable_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+
+    void async_write(const asio::const_buffer& buffer, IoHandler handler) override {
+        const auto bytes = buffer.size();
+        asio::post(executor_, [handler = std::move(handler), bytes]() { handler({}, bytes); });
+    }
+
+    void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                            IoHandler handler) override {
+        const auto bytes = asio::buffer_size(buffers);
+        asio::post(executor_, [handler = std::move(handler), bytes]() { handler({}, bytes); });
+    }
+
+    void shutdown(asio::ip::tcp::socket::shutdown_type /*type*/, asio::error_code& ec) override {
+        ec.clear();
+    }
+
+    void close(asio::error_code& ec) override { ec.clear(); }
+
+    asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override {
+        ec.clear();
+        return {};
+    }
+
+    mir2::network::IoExecutor GetExecutor() override { return executor_; }
+
+private:
+    mir2::network::IoExecutor executor_;
+};
+
+}  // namespace
+
+/**
+ * @brief 一次 tick 内向单个会话发送的突发小包
+ *
+ * 参数：{负载字节, 协议版本}；allocs_per_message 为稳态下每条消息的堆分配次数
+ * （包含 io_context 投递与写完成回调本身的分配）。
+ */
+static void BM_SessionSend(benchmark::State& state) {
+    constexpr int kMessagesPerTick = 32;
+    const std::vector<uint8_t> payload(static_cast<size_t>(state.range(0)), 0x42);
+
+    asio::io_context io_context;
+    auto session = std::make_shared<mir2::network::TcpSession>(
+        std::make_shared<mir2::network::TcpConnection>(
+            std::make_unique<NullSocket>(io_context.get_executor()), 1));
+    if (state.range(1) == 2) {
+        session->SetProtocolVersion(mir2::network::ProtocolVersion::kV2);
+    }
+    session->Start();
+
+    auto run_tick = [&]() {
+        for (int i = 0; i < kMessagesPerTick; ++i) {
+            session->Send(1, payload);
+        }
+        io_context.restart();
+        io_context.run();
+    };
+    // 预热：填充线程缓存、写队列与 asio 处理器回收缓存
+    for (int i = 0; i < 8; ++i) {
+        run_tick();
+    }
+
+    const uint64_t alloc_before = g_allocations.load(std::memory_order_relaxed);
+    const auto pool_before = mir2::network::BufferPool::GetStats();
+    for (auto _ : state) {
+        run_tick();
+    }
+    const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - alloc_before;
+    const uint64_t messages = static_cast<uint64_t>(state.iterations()) * kMessagesPerTick;
+
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+    state.counters["allocs_per_message"] = benchmark::Counter(
+        static_cast<double>(allocations) / static_cast<double>(messages));
+    state.counters["pool_heap_allocs"] = benchmark::Counter(static_cast<double>(
+        mir2::network::BufferPool::GetStats().heap_allocs - pool_before.heap_allocs));
+}
+
+BENCHMARK(BM_SessionSend)
+    ->ArgsProduct({{16, 128, 1024}, {1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
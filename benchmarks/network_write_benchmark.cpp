@@ -0,0 +1,136 @@
+/**
+ * @file network_write_benchmark.cpp
+ * @brief 写合并基准测试 - 本地回环 TCP，经 SocketAdapter 统计写调用次数
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include "network/packet_codec.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+/**
+ * @brief 包装 AsioSocketAdapter，统计发起的写操作次数
+ */
+class CountingSocket : public mir2::network::SocketAdapter {
+public:
+    CountingSocket(asio::ip::tcp::socket socket, uint64_t* write_calls)
+        : inner_(std::move(socket)), write_calls_(write_calls) {}
+
+    void async_read_some(const asio::mutable_buffer& buffer, IoHandler handler) override {
+        inner_.async_read_some(buffer, std::move(handler));
+    }
+
+    void async_write(const asio::const_buffer& buffer, IoHandler handler) override {
+        ++*write_calls_;
+        inner_.async_write(buffer, std::move(handler));
+    }
+
+    void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                            IoHandler handler) override {
+        ++*write_calls_;
+        inner_.async_write_gather(buffers, std::move(handler));
+    }
+
+    void shutdown(asio::ip::tcp::socket::shutdown_type type, asio::error_code& ec) override {
+        inner_.shutdown(type, ec);
+    }
+
+    void close(asio::error_code& ec) override { inner_.close(ec); }
+
+    asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override {
+        return inner_.remote_endpoint(ec);
+    }
+
+    mir2::network::IoExecutor GetExecutor() override { return inner_.GetExecutor(); }
+
+private:
+    mir2::network::AsioSocketAdapter inner_;
+    uint64_t* write_calls_;
+};
+
+/**
+ * @brief 回环连接：服务端会话写出，对端持续读空
+ */
+struct LoopbackPair {
+    asio::io_context io_context;
+    asio::ip::tcp::socket peer{io_context};
+    std::shared_ptr<mir2::network::TcpSession> session;
+    std::array<uint8_t, 64 * 1024> drain_buffer{};
+    uint64_t bytes_received = 0;
+    uint64_t write_calls = 0;
+
+    LoopbackPair() {
+        asio::ip::tcp::acceptor acceptor(
+            io_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        peer.connect(acceptor.local_endpoint());
+        asio::ip::tcp::socket server_socket(io_context);
+        acceptor.accept(server_socket);
+
+        auto connection = std::make_shared<mir2::network::TcpConnection>(
+            std::make_unique<CountingSocket>(std::move(server_socket), &write_calls), 1);
+        session = std::make_shared<mir2::network::TcpSession>(connection);
+        session->Start();
+        Drain();
+    }
+
+    void Drain() {
+        peer.async_read_some(asio::buffer(drain_buffer),
+                             [this](const asio::error_code& ec, std::size_t bytes) {
+                                 if (ec) {
+                                     return;
+                                 }
+                                 bytes_received += bytes;
+                                 Drain();
+                             });
+    }
+
+    void RunUntilReceived(uint64_t target) {
+        while (bytes_received < target) {
+            io_context.run_one();
+        }
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief 一次 tick 内的突发小包（移动/伤害同步）经回环写出
+ *
+ * 参数：{每次突发包数, 负载字节}；writes_per_burst 即每次突发的写系统调用次数。
+ */
+static void BM_LoopbackBurst(benchmark::State& state) {
+    const int burst = static_cast<int>(state.range(0));
+    const std::vector<uint8_t> payload(static_cast<size_t>(state.range(1)), 0x3C);
+    const auto frame_size = mir2::network::PacketCodec::Encode(1, payload.data(), payload.size()).size();
+
+    LoopbackPair pair;
+    uint64_t expected = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < burst; ++i) {
+            pair.session->Send(1, payload);
+        }
+        expected += frame_size * static_cast<uint64_t>(burst);
+        pair.RunUntilReceived(expected);
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+    state.SetBytesProcessed(static_cast<int64_t>(expected));
+    state.counters["writes_per_burst"] = benchmark::Counter(
+        static_cast<double>(pair.write_calls) / static_cast<double>(state.iterations()));
+}
+
+BENCHMARK(BM_LoopbackBurst)
+    ->ArgsProduct({{1, 8, 40, 200}, {16, 128}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
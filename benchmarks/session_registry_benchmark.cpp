@@ -0,0 +1,138 @@
+/**
+ * @file session_registry_benchmark.cpp
+ * @brief 会话表查找基准测试 - 单互斥锁 vs 分片快照
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include "network/session_registry.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+constexpr uint64_t kSessionCount = 5000;
+
+/**
+ * @brief 仅用于构造会话的空 Socket
+ */
+class IdleSocket : public mir2::network::SocketAdapter {
+public:
+    explicit IdleSocket(mir2::network::IoExecutor executor) : executor_(std::move(executor)) {}
+
+    void async_read_some(const asio::mutable_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+    void async_write(const asio::const_buffer& /*buffer*/, IoHandler /*handler*/) override {}
+    void shutdown(asio::ip::tcp::socket::shutdown_type /*type*/, asio::error_code& ec) override {
+        ec.clear();
+    }
+    void close(asio::error_code& ec) override { ec.clear(); }
+    asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override {
+        ec.clear();
+        return {};
+    }
+    mir2::network::IoExecutor GetExecutor() override { return executor_; }
+
+private:
+    mir2::network::IoExecutor executor_;
+};
+
+/**
+ * @brief 共享的会话集合（所有线程复用）
+ */
+struct SessionFixture {
+    asio::io_context io_context;
+    std::vector<std::shared_ptr<mir2::network::TcpSession>> sessions;
+
+    SessionFixture() {
+        sessions.reserve(kSessionCount);
+        for (uint64_t id = 1; id <= kSessionCount; ++id) {
+            sessions.push_back(std::make_shared<mir2::network::TcpSession>(
+                std::make_shared<mir2::network::TcpConnection>(
+                    std::make_unique<IdleSocket>(io_context.get_executor()), id)));
+        }
+    }
+};
+
+SessionFixture& Fixture() {
+    static SessionFixture fixture;
+    return fixture;
+}
+
+/**
+ * @brief 旧实现：单互斥锁保护的 unordered_map
+ */
+struct MutexSessionTable {
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<mir2::network::TcpSession>> sessions;
+
+    std::shared_ptr<mir2::network::TcpSession> Find(uint64_t id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(id);
+        return it != sessions.end() ? it->second : nullptr;
+    }
+};
+
+MutexSessionTable& MutexTable() {
+    static MutexSessionTable* table = [] {
+        auto* created = new MutexSessionTable();
+        for (const auto& session : Fixture().sessions) {
+            created->sessions[session->GetSessionId()] = session;
+        }
+        return created;
+    }();
+    return *table;
+}
+
+mir2::network::SessionRegistry& Registry() {
+    static mir2::network::SessionRegistry* registry = [] {
+        auto* created = new mir2::network::SessionRegistry();
+        for (const auto& session : Fixture().sessions) {
+            created->Insert(session);
+        }
+        return created;
+    }();
+    return *registry;
+}
+
+}  // namespace
+
+/**
+ * @brief 基线：每次查找获取全局互斥锁（对应 EntityBroadcastService 的 GetSession + Send）
+ */
+static void BM_SessionLookup_GlobalMutex(benchmark::State& state) {
+    auto& table = MutexTable();
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        id = id % kSessionCount + 1;
+        benchmark::DoNotOptimize(table.Find(id));
+        benchmark::DoNotOptimize(table.Find(id));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/**
+ * @brief 分片快照：查找只做一次原子加载
+ */
+static void BM_SessionLookup_ShardedRegistry(benchmark::State& state) {
+    auto& registry = Registry();
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        id = id % kSessionCount + 1;
+        benchmark::DoNotOptimize(registry.Find(id));
+        benchmark::DoNotOptimize(registry.Find(id));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(BM_SessionLookup_GlobalMutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SessionLookup_ShardedRegistry)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+/**
+ * @file world_update_benchmark.cpp
+ * @brief 多地图 World 更新基准测试 - 16 张繁忙地图串行 vs 并行
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "ecs/components/character_components.h"
+#include "ecs/registry_manager.h"
+#include "ecs/systems/combat_system.h"
+#include "ecs/systems/level_up_system.h"
+#include "ecs/systems/movement_system.h"
+#include "ecs/world.h"
+
+namespace {
+
+constexpr uint32_t kMapCount = 16;
+constexpr uint32_t kFirstMapId = 20001;
+constexpr int kEntitiesPerMap = 1000;
+constexpr float kDeltaTime = 0.05f;  // 50ms tick
+
+void PopulateWorld(mir2::ecs::World& world, uint32_t map_id) {
+    auto& registry = world.Registry();
+    for (int i = 0; i < kEntitiesPerMap; ++i) {
+        const auto entity = registry.create();
+
+        auto& identity = registry.emplace<mir2::ecs::CharacterIdentityComponent>(entity);
+        identity.id = map_id * 100000 + static_cast<uint32_t>(i);
+        identity.name = "Player" + std::to_string(identity.id);
+        identity.char_class = legend2::CharacterClass::WARRIOR;
+        identity.gender = legend2::Gender::MALE;
+
+        auto& attrs = registry.emplace<mir2::ecs::CharacterAttributesComponent>(entity);
+        attrs.level = 1 + (i % 10);
+        attrs.max_hp = 100 + attrs.level * 20;
+        attrs.hp = attrs.max_hp;
+        attrs.max_mp = 50 + attrs.level * 10;
+        attrs.mp = attrs.max_mp;
+        attrs.attack = 10 + attrs.level * 3;
+        attrs.defense = 5 + attrs.level * 2;
+        attrs.speed = 100;
+
+        auto& state = registry.emplace<mir2::ecs::CharacterStateComponent>(entity);
+        state.map_id = map_id;
+        state.position = {(i % 100) * 10, (i / 100) * 10};
+        state.direction = legend2::Direction::DOWN;
+    }
+}
+
+/**
+ * @brief 16 张地图，每张 1000 个实体与移动/战斗/升级系统（所有基准共用）
+ */
+mir2::ecs::RegistryManager& BusyMaps() {
+    static mir2::ecs::RegistryManager* manager = [] {
+        auto& created = mir2::ecs::RegistryManager::Instance();
+        for (uint32_t map_id = kFirstMapId; map_id < kFirstMapId + kMapCount; ++map_id) {
+            auto* world = created.CreateWorld(map_id, kEntitiesPerMap);
+            world->CreateSystem<mir2::ecs::MovementSystem>();
+            world->CreateSystem<mir2::ecs::CombatSystem>();
+            world->CreateSystem<mir2::ecs::LevelUpSystem>();
+            PopulateWorld(*world, map_id);
+        }
+        return &created;
+    }();
+    return *manager;
+}
+
+}  // namespace
+
+/**
+ * @brief 基线：逻辑线程依次更新 16 张地图
+ */
+static void BM_UpdateAll_16Maps_Serial(benchmark::State& state) {
+    auto& manager = BusyMaps();
+    manager.SetParallelUpdate(0);
+    for (auto _ : state) {
+        manager.UpdateAll(kDeltaTime);
+    }
+    state.SetItemsProcessed(state.iterations() * kMapCount * kEntitiesPerMap);
+    state.counters["maps"] = kMapCount;
+}
+
+/**
+ * @brief 并行：地图分发到 range(0) 个工作线程（调用线程同样参与）
+ */
+static void BM_UpdateAll_16Maps_Parallel(benchmark::State& state) {
+    auto& manager = BusyMaps();
+    manager.SetParallelUpdate(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        manager.UpdateAll(kDeltaTime);
+    }
+    manager.SetParallelUpdate(0);
+    state.SetItemsProcessed(state.iterations() * kMapCount * kEntitiesPerMap);
+    state.counters["maps"] = kMapCount;
+    state.counters["worker_threads"] = static_cast<double>(state.range(0));
+}
+
+BENCHMARK(BM_UpdateAll_16Maps_Serial)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_UpdateAll_16Maps_Parallel)
+    ->Arg(1)
+    ->Arg(3)
+    ->Arg(7)
+    ->Arg(15)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
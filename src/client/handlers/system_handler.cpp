@@ -19,6 +19,7 @@ const char* proto_error_to_string(mir2::proto::ErrorCode code) {
         case mir2::proto::ErrorCode::ERR_TARGET_NOT_FOUND: return "Target not found";
         case mir2::proto::ErrorCode::ERR_TARGET_OUT_OF_RANGE: return "Target out of range";
         case mir2::proto::ErrorCode::ERR_INSUFFICIENT_MP: return "Insufficient MP";
+        case mir2::proto::ErrorCode::ERR_SERVER_BUSY: return "Server busy";
         default: return "Unknown error";
     }
 }
@@ -15,6 +15,7 @@
 #include <chrono>
 
 #include "common/enums.h"
+#include "common/protocol/payload_compression.h"
 #include "common/types/constants.h"
 #include "flatbuffers/flatbuffers.h"
 #include "system_generated.h"
@@ -37,6 +38,12 @@ using PacketHeaderV2 = mir2::common::PacketHeaderV2;
 using ProtocolVersion = mir2::common::ProtocolVersion;
 namespace constants = mir2::common::constants;
 constexpr uint16_t kSequenceWindow = 256;
+// 服务器拥塞时会丢弃过期的可替换状态（EntityMove/EntityUpdate），序号可能向前大幅跳跃，
+// 因此前向按序号空间的一半判断
+constexpr uint16_t kForwardSequenceWindow = 0x8000;
+constexpr uint8_t kCompressedFlag = static_cast<uint8_t>(mir2::common::PacketFlags::kCompressed);
+constexpr uint8_t kAcceptCompressedFlag =
+    static_cast<uint8_t>(mir2::common::PacketFlags::kAcceptCompressed);
 } // namespace
 
 /**
@@ -168,7 +175,18 @@ void NetworkClient::send(uint16_t msg_id, const std::vector<uint8_t>& payload) {
     }
 
     const uint16_t seq = send_sequence_.fetch_add(1, std::memory_order_relaxed);
-    auto encoded = mir2::common::EncodePacketV2(msg_id, payload.data(), payload.size(), seq, 0);
+    const bool compression = compression_enabled_.load(std::memory_order_relaxed);
+    const uint8_t flags = compression ? kAcceptCompressedFlag : 0;
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> compressed;
+    if (compression && server_accepts_compression_.load(std::memory_order_relaxed) &&
+        payload.size() >= mir2::common::kDefaultCompressionThreshold &&
+        mir2::common::CompressPayload(payload.data(), payload.size(), &compressed)) {
+        encoded = mir2::common::EncodePacketV2(msg_id, compressed.data(), compressed.size(), seq,
+                                               flags | kCompressedFlag);
+    } else {
+        encoded = mir2::common::EncodePacketV2(msg_id, payload.data(), payload.size(), seq, flags);
+    }
     {
         std::lock_guard<std::mutex> lock(send_mutex_);
         send_queue_.push(std::move(encoded));
@@ -301,6 +319,10 @@ void NetworkClient::set_auto_reconnect(bool enable) {
     auto_reconnect_ = enable;
 }
 
+void NetworkClient::set_compression_enabled(bool enable) {
+    compression_enabled_.store(enable, std::memory_order_relaxed);
+}
+
 // -----------------------------------------------------------------------------
 // IO 线程管理
 // -----------------------------------------------------------------------------
@@ -354,6 +376,7 @@ void NetworkClient::do_connect(const asio::ip::tcp::resolver::results_type& endp
                 protocol_version_ = ProtocolVersion::kV2;
                 send_sequence_.store(0, std::memory_order_relaxed);
                 recv_sequence_.store(0, std::memory_order_relaxed);
+                server_accepts_compression_.store(false, std::memory_order_relaxed);
 
                 // Disable Nagle's algorithm for lower latency
                 socket_->set_option(asio::ip::tcp::no_delay(true));
@@ -461,16 +484,18 @@ void NetworkClient::do_read_remaining_header(size_t remaining_size) {
             if (protocol_version_ == ProtocolVersion::kV2) {
                 NetworkPacket packet{};
                 uint16_t sequence = 0;
+                uint8_t flags = 0;
                 const auto status = mir2::common::DecodePacketV2(header_buffer_.data(),
                                                                  PacketHeaderV2::kSize,
                                                                  &packet,
-                                                                 &sequence);
+                                                                 &sequence,
+                                                                 &flags);
                 if (status != mir2::common::DecodeStatus::kOk) {
                     last_error_ = ErrorCode::INVALID_PACKET;
                     handle_disconnect(asio::error::invalid_argument);
                     return;
                 }
-                if (!check_recv_sequence(sequence)) {
+                if (!check_recv_sequence(sequence) || !apply_received_flags(flags, &packet)) {
                     last_error_ = ErrorCode::INVALID_PACKET;
                     handle_disconnect(asio::error::invalid_argument);
                     return;
@@ -510,16 +535,18 @@ void NetworkClient::do_read_body(size_t body_length) {
 
                     NetworkPacket packet{};
                     uint16_t sequence = 0;
+                    uint8_t flags = 0;
                     const auto status = mir2::common::DecodePacketV2(packet_buffer.data(),
                                                                      packet_buffer.size(),
                                                                      &packet,
-                                                                     &sequence);
+                                                                     &sequence,
+                                                                     &flags);
                     if (status != mir2::common::DecodeStatus::kOk) {
                         last_error_ = ErrorCode::INVALID_PACKET;
                         handle_disconnect(asio::error::invalid_argument);
                         return;
                     }
-                    if (!check_recv_sequence(sequence)) {
+                    if (!check_recv_sequence(sequence) || !apply_received_flags(flags, &packet)) {
                         last_error_ = ErrorCode::INVALID_PACKET;
                         handle_disconnect(asio::error::invalid_argument);
                         return;
@@ -540,13 +567,35 @@ void NetworkClient::do_read_body(size_t body_length) {
         });
 }
 
+/**
+ * @brief 处理收到包的标记位：记录服务器压缩能力并解压负载
+ * @return 负载无法解压时返回 false
+ */
+bool NetworkClient::apply_received_flags(uint8_t flags, NetworkPacket* packet) {
+    if ((flags & kAcceptCompressedFlag) != 0) {
+        server_accepts_compression_.store(true, std::memory_order_relaxed);
+    }
+    if ((flags & kCompressedFlag) == 0) {
+        return true;
+    }
+    if (!compression_enabled_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    std::vector<uint8_t> payload;
+    if (!mir2::common::DecompressPayload(packet->payload, &payload, MAX_PACKET_SIZE)) {
+        return false;
+    }
+    packet->payload = std::move(payload);
+    return true;
+}
+
 bool NetworkClient::check_recv_sequence(uint16_t seq) {
     const uint16_t last = recv_sequence_.load(std::memory_order_relaxed);
     const uint16_t forward = static_cast<uint16_t>(seq - last);
     if (forward == 0) {
         return true;
     }
-    if (forward < kSequenceWindow) {
+    if (forward < kForwardSequenceWindow) {
         recv_sequence_.store(seq, std::memory_order_relaxed);
         return true;
     }
@@ -141,6 +141,9 @@ public:
     /// 启用/禁用自动重连
     void set_auto_reconnect(bool enable);
 
+    /// 启用/禁用负载压缩协商（默认启用，需在连接前设置）
+    void set_compression_enabled(bool enable);
+
  private:
     // Asio components
     asio::io_context io_context_;
@@ -158,6 +161,9 @@ public:
     mir2::common::ProtocolVersion protocol_version_{mir2::common::ProtocolVersion::kV2};
     std::atomic<uint16_t> send_sequence_{0};
     std::atomic<uint16_t> recv_sequence_{0};
+    // Compression negotiation (PacketFlags::kAcceptCompressed)
+    std::atomic<bool> compression_enabled_{true};
+    std::atomic<bool> server_accepts_compression_{false};
 
     // Header buffer for V2 (16 bytes)
     static constexpr size_t HEADER_BUFFER_SIZE = 16;
@@ -203,6 +209,7 @@ public:
     void check_timeout();
     void handle_packet(const NetworkPacket& packet);
     bool check_recv_sequence(uint16_t seq);
+    bool apply_received_flags(uint8_t flags, NetworkPacket* packet);
     void handle_disconnect(const asio::error_code& ec);
     void try_reconnect();
     void process_received_data();
@@ -95,8 +95,9 @@ enum class MsgId : uint16_t {
  */
 enum class PacketFlags : uint8_t {
   kNone = 0x00,
-  kEncrypted = 0x01,  // bit0: 加密
-  kCompressed = 0x02  // bit1: 压缩
+  kEncrypted = 0x01,        // bit0: 加密
+  kCompressed = 0x02,       // bit1: 压缩（负载为 [原始长度][LZ4 块]）
+  kAcceptCompressed = 0x04  // bit2: 发送方可接收压缩包（能力协商）
 };
 
 /**
@@ -254,7 +255,9 @@ enum class ServiceType : uint8_t {
 enum class InternalMsgId : uint16_t {
   kServiceHello = 60000,
   kServiceHelloAck = 60001,
-  kRoutedMessage = 60010
+  kRoutedMessage = 60010,  // FlatBuffers RoutedMessage（兼容旧版本）
+  kRoutedFrame = 60011,    // 定长路由信封 + 原始负载（见 routed_envelope.h）
+  kRoutedBatch = 60012     // 多条路由帧首尾相接，按 Tick 或字节上限攒批
 };
 
 }  // namespace mir2::common
@@ -3,6 +3,17 @@
 #include <cstring>
 #include <limits>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define MIR2_CRC16_CLMUL 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MIR2_CRC16_CLMUL_TARGET
+#else
+#define MIR2_CRC16_CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#endif
+#endif
+
 namespace mir2::common {
 
 namespace {
@@ -42,10 +53,26 @@ constexpr uint16_t kCrc16Table[256] = {
     0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
 };
 
-uint16_t UpdateCRC16(uint16_t crc, const uint8_t* data, size_t length) {
-    if (!data || length == 0) {
-        return crc;
+/**
+ * @brief slicing-by-8 查找表：kSlicingTables[k][b] 为字节 b 后接 k 个零字节的 CRC（初值 0）
+ */
+constexpr std::array<std::array<uint16_t, 256>, 8> BuildSlicingTables() {
+    std::array<std::array<uint16_t, 256>, 8> tables{};
+    for (size_t i = 0; i < 256; ++i) {
+        tables[0][i] = kCrc16Table[i];
     }
+    for (size_t k = 1; k < tables.size(); ++k) {
+        for (size_t i = 0; i < 256; ++i) {
+            const uint16_t prev = tables[k - 1][i];
+            tables[k][i] = static_cast<uint16_t>((prev << 8) ^ kCrc16Table[prev >> 8]);
+        }
+    }
+    return tables;
+}
+
+constexpr auto kSlicingTables = BuildSlicingTables();
+
+uint16_t UpdateCRC16Bytewise(uint16_t crc, const uint8_t* data, size_t length) {
     for (size_t i = 0; i < length; ++i) {
         const uint8_t index = static_cast<uint8_t>((crc >> 8) ^ data[i]);
         crc = static_cast<uint16_t>((crc << 8) ^ kCrc16Table[index]);
@@ -53,8 +80,225 @@ uint16_t UpdateCRC16(uint16_t crc, const uint8_t* data, size_t length) {
     return crc;
 }
 
+uint16_t UpdateCRC16Slicing8(uint16_t crc, const uint8_t* data, size_t length) {
+    // CRC 线性：8 字节块的结果 = 状态推进 8 字节 ^ 各字节独立推进到块尾，两者都由查表得到。
+    while (length >= 8) {
+        crc = static_cast<uint16_t>(kSlicingTables[7][data[0] ^ (crc >> 8)] ^
+                                    kSlicingTables[6][data[1] ^ (crc & 0xFF)] ^
+                                    kSlicingTables[5][data[2]] ^ kSlicingTables[4][data[3]] ^
+                                    kSlicingTables[3][data[4]] ^ kSlicingTables[2][data[5]] ^
+                                    kSlicingTables[1][data[6]] ^ kSlicingTables[0][data[7]]);
+        data += 8;
+        length -= 8;
+    }
+    return UpdateCRC16Bytewise(crc, data, length);
+}
+
+#ifdef MIR2_CRC16_CLMUL
+
+// 低于该长度时折叠的固定开销（末尾 16 字节仍需查表）不划算
+constexpr size_t kClmulMinLength = 64;
+
+/**
+ * @brief x^n mod P（P = x^16 + x^12 + x^5 + 1）
+ */
+constexpr uint64_t XPowModP(unsigned n) {
+    uint32_t r = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        r <<= 1;
+        if (r & 0x10000u) {
+            r ^= 0x11021u;
+        }
+    }
+    return r;
+}
+
+// 折叠常量：推进 128 位（相邻块）与 512 位（4 路并行）
+constexpr uint64_t kFold128Lo = XPowModP(128);
+constexpr uint64_t kFold128Hi = XPowModP(192);
+constexpr uint64_t kFold512Lo = XPowModP(512);
+constexpr uint64_t kFold512Hi = XPowModP(576);
+
+bool DetectClmul() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) != 0 && (info[2] & (1 << 9)) != 0;  // PCLMULQDQ, SSSE3
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#endif
+}
+
+bool HasClmul() {
+    static const bool supported = DetectClmul();
+    return supported;
+}
+
+/**
+ * @brief 将 128 位余数 acc 推进 D 位：acc(hi,lo) * x^D ≡ hi * (x^(D+64) mod P) ^ lo * (x^D mod P)
+ *
+ * k 的低 64 位为 x^D mod P，高 64 位为 x^(D+64) mod P；结果不超过 79 位。
+ */
+MIR2_CRC16_CLMUL_TARGET inline __m128i Fold(__m128i acc, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x00), _mm_clmulepi64_si128(acc, k, 0x11));
+}
+
+MIR2_CRC16_CLMUL_TARGET inline __m128i LoadBigEndian(const uint8_t* ptr, __m128i reverse) {
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), reverse);
+}
+
+/**
+ * @brief 无进位乘法折叠
+ *
+ * 以大端 128 位块视作 GF(2) 多项式，折叠到最后一个 16 字节余数（与原数据模 P 同余），
+ * 再与尾部字节一起查表完成，因此无需 Barrett 约简即可与查表实现逐位一致。
+ */
+MIR2_CRC16_CLMUL_TARGET uint16_t UpdateCRC16Clmul(uint16_t crc, const uint8_t* data,
+                                                  size_t length) {
+    if (length < 16) {
+        return UpdateCRC16Slicing8(crc, data, length);
+    }
+
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i k128 =
+        _mm_set_epi64x(static_cast<int64_t>(kFold128Hi), static_cast<int64_t>(kFold128Lo));
+    const __m128i k512 =
+        _mm_set_epi64x(static_cast<int64_t>(kFold512Hi), static_cast<int64_t>(kFold512Lo));
+
+    // 初值异或到首两个字节，之后按初值 0 计算
+    const __m128i init = _mm_set_epi64x(static_cast<int64_t>(static_cast<uint64_t>(crc) << 48), 0);
+    __m128i acc;
+    if (length >= 128) {
+        __m128i acc0 = _mm_xor_si128(LoadBigEndian(data, reverse), init);
+        __m128i acc1 = LoadBigEndian(data + 16, reverse);
+        __m128i acc2 = LoadBigEndian(data + 32, reverse);
+        __m128i acc3 = LoadBigEndian(data + 48, reverse);
+        data += 64;
+        length -= 64;
+        while (length >= 64) {
+            acc0 = _mm_xor_si128(Fold(acc0, k512), LoadBigEndian(data, reverse));
+            acc1 = _mm_xor_si128(Fold(acc1, k512), LoadBigEndian(data + 16, reverse));
+            acc2 = _mm_xor_si128(Fold(acc2, k512), LoadBigEndian(data + 32, reverse));
+            acc3 = _mm_xor_si128(Fold(acc3, k512), LoadBigEndian(data + 48, reverse));
+            data += 64;
+            length -= 64;
+        }
+        acc = _mm_xor_si128(Fold(acc0, k128), acc1);
+        acc = _mm_xor_si128(Fold(acc, k128), acc2);
+        acc = _mm_xor_si128(Fold(acc, k128), acc3);
+    } else {
+        acc = _mm_xor_si128(LoadBigEndian(data, reverse), init);
+        data += 16;
+        length -= 16;
+    }
+    while (length >= 16) {
+        acc = _mm_xor_si128(Fold(acc, k128), LoadBigEndian(data, reverse));
+        data += 16;
+        length -= 16;
+    }
+
+    alignas(16) uint8_t remainder[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(remainder), _mm_shuffle_epi8(acc, reverse));
+    crc = UpdateCRC16Slicing8(0, remainder, sizeof(remainder));
+    return UpdateCRC16Slicing8(crc, data, length);
+}
+
+#endif  // MIR2_CRC16_CLMUL
+
+CRC16Shift ComposeShift(const CRC16Shift& outer, const CRC16Shift& inner) {
+    CRC16Shift result;
+    for (size_t bit = 0; bit < result.columns.size(); ++bit) {
+        result.columns[bit] = outer.Apply(inner.columns[bit]);
+    }
+    return result;
+}
+
 }  // namespace
 
+uint16_t UpdateCRC16(uint16_t crc, const uint8_t* data, size_t length) {
+    if (!data || length == 0) {
+        return crc;
+    }
+#ifdef MIR2_CRC16_CLMUL
+    if (length >= kClmulMinLength && HasClmul()) {
+        return UpdateCRC16Clmul(crc, data, length);
+    }
+#endif
+    return UpdateCRC16Slicing8(crc, data, length);
+}
+
+bool IsCRC16ImplSupported(CRC16Impl impl) {
+    switch (impl) {
+        case CRC16Impl::kBytewise:
+        case CRC16Impl::kSlicing8:
+            return true;
+        case CRC16Impl::kClmul:
+#ifdef MIR2_CRC16_CLMUL
+            return HasClmul();
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+uint16_t UpdateCRC16With(CRC16Impl impl, uint16_t crc, const uint8_t* data, size_t length) {
+    if (!data || length == 0) {
+        return crc;
+    }
+    switch (impl) {
+        case CRC16Impl::kBytewise:
+            return UpdateCRC16Bytewise(crc, data, length);
+        case CRC16Impl::kClmul:
+#ifdef MIR2_CRC16_CLMUL
+            if (HasClmul()) {
+                return UpdateCRC16Clmul(crc, data, length);
+            }
+#endif
+            break;
+        case CRC16Impl::kSlicing8:
+            break;
+    }
+    return UpdateCRC16Slicing8(crc, data, length);
+}
+
+CRC16Shift CRC16Shift::ForZeroBytes(size_t length) {
+    CRC16Shift result;
+    for (size_t bit = 0; bit < result.columns.size(); ++bit) {
+        result.columns[bit] = static_cast<uint16_t>(1u << bit);
+    }
+
+    // 单个零字节的推进矩阵，按平方-乘法求幂（O(log n)）。
+    CRC16Shift base;
+    for (size_t bit = 0; bit < base.columns.size(); ++bit) {
+        const uint16_t state = static_cast<uint16_t>(1u << bit);
+        base.columns[bit] =
+            static_cast<uint16_t>((state << 8) ^ kCrc16Table[static_cast<uint8_t>(state >> 8)]);
+    }
+
+    while (length > 0) {
+        if (length & 1u) {
+            result = ComposeShift(base, result);
+        }
+        length >>= 1;
+        if (length > 0) {
+            base = ComposeShift(base, base);
+        }
+    }
+    return result;
+}
+
+uint16_t CRC16Shift::Apply(uint16_t crc) const {
+    uint16_t result = 0;
+    for (size_t bit = 0; bit < columns.size() && crc != 0; ++bit, crc >>= 1) {
+        if (crc & 1u) {
+            result ^= columns[bit];
+        }
+    }
+    return result;
+}
+
 std::array<uint8_t, PacketHeader::kSize> PacketHeader::ToBytes() const {
     std::array<uint8_t, kSize> buffer{};
     std::memcpy(buffer.data(), &magic, sizeof(magic));
@@ -119,30 +363,62 @@ uint16_t CalcCRC16(const uint8_t* data, size_t length) {
     return UpdateCRC16(0xFFFF, data, length);
 }
 
-std::vector<uint8_t> EncodePacket(uint16_t msg_id, const uint8_t* payload, size_t payload_size) {
+size_t EncodePacketInto(uint16_t msg_id, const uint8_t* payload, size_t payload_size,
+                        uint8_t* out, size_t out_capacity) {
     if (payload_size > kMaxPayloadSize ||
         payload_size > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
-        return {};
+        return 0;
+    }
+    const size_t total_size = PacketHeader::kSize + payload_size;
+    if (!out || out_capacity < total_size) {
+        return 0;
     }
 
-    std::vector<uint8_t> buffer(PacketHeader::kSize + payload_size);
     size_t offset = 0;
     const uint32_t magic = PacketHeader::kMagic;
-    std::memcpy(buffer.data() + offset, &magic, sizeof(magic));
+    std::memcpy(out + offset, &magic, sizeof(magic));
     offset += sizeof(magic);
-    std::memcpy(buffer.data() + offset, &msg_id, sizeof(msg_id));
+    std::memcpy(out + offset, &msg_id, sizeof(msg_id));
     offset += sizeof(msg_id);
     const uint32_t size_field = static_cast<uint32_t>(payload_size);
-    std::memcpy(buffer.data() + offset, &size_field, sizeof(size_field));
+    std::memcpy(out + offset, &size_field, sizeof(size_field));
     offset += sizeof(size_field);
     if (payload && payload_size > 0) {
-        std::memcpy(buffer.data() + offset, payload, payload_size);
+        std::memcpy(out + offset, payload, payload_size);
+    }
+    return total_size;
+}
+
+size_t EncodePacketGatherInto(uint16_t msg_id, std::span<const uint8_t> prefix,
+                              std::span<const uint8_t> payload, uint8_t* out, size_t out_capacity) {
+    // 空负载指针只写包头，两段负载随后直接写入包头之后
+    const size_t written =
+        EncodePacketInto(msg_id, nullptr, prefix.size() + payload.size(), out, out_capacity);
+    if (written == 0) {
+        return 0;
+    }
+    if (!prefix.empty()) {
+        std::memcpy(out + PacketHeader::kSize, prefix.data(), prefix.size());
+    }
+    if (!payload.empty()) {
+        std::memcpy(out + PacketHeader::kSize + prefix.size(), payload.data(), payload.size());
+    }
+    return written;
+}
+
+std::vector<uint8_t> EncodePacket(uint16_t msg_id, const uint8_t* payload, size_t payload_size) {
+    if (payload_size > kMaxPayloadSize) {
+        return {};
+    }
+    std::vector<uint8_t> buffer(PacketHeader::kSize + payload_size);
+    if (EncodePacketInto(msg_id, payload, payload_size, buffer.data(), buffer.size()) == 0) {
+        return {};
     }
     return buffer;
 }
 
-DecodeStatus DecodePacket(const uint8_t* data, size_t length, NetworkPacket* out_packet) {
-    if (!data || !out_packet || length < PacketHeader::kSize) {
+DecodeStatus DecodePacketView(const uint8_t* data, size_t length, NetworkPacketView* out_view) {
+    if (!data || !out_view || length < PacketHeader::kSize) {
         return DecodeStatus::kTruncated;
     }
 
@@ -161,19 +437,50 @@ DecodeStatus DecodePacket(const uint8_t* data, size_t length, NetworkPacket* out
         return DecodeStatus::kTruncated;
     }
 
-    out_packet->msg_id = header.msg_id;
-    out_packet->payload.assign(data + PacketHeader::kSize, data + expected_size);
+    out_view->msg_id = header.msg_id;
+    out_view->payload = std::span<const uint8_t>(data + PacketHeader::kSize, header.payload_size);
     return DecodeStatus::kOk;
 }
 
-std::vector<uint8_t> EncodePacketV2(uint16_t msg_id,
-                                    const uint8_t* payload,
-                                    size_t payload_size,
-                                    uint16_t sequence,
-                                    uint8_t flags) {
+DecodeStatus DecodePacket(const uint8_t* data, size_t length, NetworkPacket* out_packet) {
+    if (!out_packet) {
+        return DecodeStatus::kTruncated;
+    }
+    NetworkPacketView view;
+    const auto status = DecodePacketView(data, length, &view);
+    if (status == DecodeStatus::kOk) {
+        *out_packet = view.ToOwned();
+    }
+    return status;
+}
+
+size_t EncodePacketV2Into(uint16_t msg_id,
+                          const uint8_t* payload,
+                          size_t payload_size,
+                          uint16_t sequence,
+                          uint8_t flags,
+                          uint8_t* out,
+                          size_t out_capacity) {
+    return EncodePacketV2GatherInto(msg_id, {},
+                                    std::span<const uint8_t>(payload, payload ? payload_size : 0),
+                                    sequence, flags, out, out_capacity);
+}
+
+size_t EncodePacketV2GatherInto(uint16_t msg_id,
+                                std::span<const uint8_t> prefix,
+                                std::span<const uint8_t> payload,
+                                uint16_t sequence,
+                                uint8_t flags,
+                                uint8_t* out,
+                                size_t out_capacity) {
+    const size_t payload_size = prefix.size() + payload.size();
     if (payload_size > kMaxPayloadSize ||
         payload_size > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
-        return {};
+        return 0;
+    }
+    const size_t total_size = PacketHeaderV2::kSize + payload_size;
+    if (!out || out_capacity < total_size) {
+        return 0;
     }
 
     PacketHeaderV2 header;
@@ -185,25 +492,43 @@ std::vector<uint8_t> EncodePacketV2(uint16_t msg_id,
     auto header_bytes = header.ToBytes();
     uint16_t crc = UpdateCRC16(0xFFFF, header_bytes.data(),
                                PacketHeaderV2::kSize - sizeof(header.checksum));
-    crc = UpdateCRC16(crc, payload, payload_size);
+    crc = UpdateCRC16(crc, prefix.data(), prefix.size());
+    crc = UpdateCRC16(crc, payload.data(), payload.size());
     header.checksum = crc;
     header_bytes = header.ToBytes();
 
-    std::vector<uint8_t> buffer;
-    buffer.reserve(PacketHeaderV2::kSize + payload_size);
-    buffer.insert(buffer.end(), header_bytes.begin(), header_bytes.end());
-    if (payload && payload_size > 0) {
-        buffer.insert(buffer.end(), payload, payload + payload_size);
+    std::memcpy(out, header_bytes.data(), header_bytes.size());
+    if (!prefix.empty()) {
+        std::memcpy(out + PacketHeaderV2::kSize, prefix.data(), prefix.size());
+    }
+    if (!payload.empty()) {
+        std::memcpy(out + PacketHeaderV2::kSize + prefix.size(), payload.data(), payload.size());
+    }
+    return total_size;
+}
+
+std::vector<uint8_t> EncodePacketV2(uint16_t msg_id,
+                                    const uint8_t* payload,
+                                    size_t payload_size,
+                                    uint16_t sequence,
+                                    uint8_t flags) {
+    if (payload_size > kMaxPayloadSize) {
+        return {};
+    }
+    std::vector<uint8_t> buffer(PacketHeaderV2::kSize + payload_size);
+    if (EncodePacketV2Into(msg_id, payload, payload_size, sequence, flags,
+                           buffer.data(), buffer.size()) == 0) {
+        return {};
     }
     return buffer;
 }
 
-DecodeStatus DecodePacketV2(const uint8_t* data,
-                            size_t length,
-                            NetworkPacket* out_packet,
-                            uint16_t* out_sequence,
-                            uint8_t* out_flags) {
-    if (!data || !out_packet || length < PacketHeaderV2::kSize) {
+DecodeStatus DecodePacketV2View(const uint8_t* data,
+                                size_t length,
+                                NetworkPacketView* out_view,
+                                uint16_t* out_sequence,
+                                uint8_t* out_flags) {
+    if (!data || !out_view || length < PacketHeaderV2::kSize) {
         return DecodeStatus::kTruncated;
     }
 
@@ -231,8 +556,8 @@ DecodeStatus DecodePacketV2(const uint8_t* data,
         return DecodeStatus::kInvalidChecksum;
     }
 
-    out_packet->msg_id = header.msg_id;
-    out_packet->payload.assign(data + PacketHeaderV2::kSize, data + expected_size);
+    out_view->msg_id = header.msg_id;
+    out_view->payload = std::span<const uint8_t>(data + PacketHeaderV2::kSize, header.payload_size);
     if (out_sequence) {
         *out_sequence = header.sequence;
     }
@@ -242,6 +567,22 @@ DecodeStatus DecodePacketV2(const uint8_t* data,
     return DecodeStatus::kOk;
 }
 
+DecodeStatus DecodePacketV2(const uint8_t* data,
+                            size_t length,
+                            NetworkPacket* out_packet,
+                            uint16_t* out_sequence,
+                            uint8_t* out_flags) {
+    if (!out_packet) {
+        return DecodeStatus::kTruncated;
+    }
+    NetworkPacketView view;
+    const auto status = DecodePacketV2View(data, length, &view, out_sequence, out_flags);
+    if (status == DecodeStatus::kOk) {
+        *out_packet = view.ToOwned();
+    }
+    return status;
+}
+
 ProtocolVersion DetectProtocolVersion(const uint8_t* magic_bytes) {
     if (!magic_bytes) {
         return ProtocolVersion::kV1;
@@ -15,6 +15,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace mir2::common {
@@ -67,6 +68,20 @@ struct NetworkPacket {
     std::vector<uint8_t> payload;
 };
 
+/**
+ * @brief 网络包视图（不持有负载，指向接收缓冲区）
+ *
+ * 仅在回调期间有效；需要延后处理时调用 ToOwned() 生成拷贝。
+ */
+struct NetworkPacketView {
+    uint16_t msg_id = 0;
+    std::span<const uint8_t> payload;
+
+    NetworkPacket ToOwned() const {
+        return NetworkPacket{msg_id, std::vector<uint8_t>(payload.begin(), payload.end())};
+    }
+};
+
 /**
  * @brief 单包最大负载（16MB）
  */
@@ -89,6 +104,47 @@ enum class DecodeStatus : uint8_t {
  */
 uint16_t CalcCRC16(const uint8_t* data, size_t length);
 
+/**
+ * @brief 从给定 CRC 状态继续累加 CRC-16-CCITT
+ *
+ * 短数据走 slicing-by-8 查表；长数据在 CPU 支持 PCLMULQDQ 时走无进位乘法折叠（运行时检测）。
+ * 各实现结果逐位一致。
+ */
+uint16_t UpdateCRC16(uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief CRC16 实现（一致性测试与基准测试用）
+ */
+enum class CRC16Impl : uint8_t {
+    kBytewise,  ///< 单表逐字节
+    kSlicing8,  ///< 8 表，每次 8 字节
+    kClmul      ///< PCLMULQDQ 折叠（x86-64）
+};
+
+/**
+ * @brief 当前 CPU/编译目标是否支持指定实现
+ */
+bool IsCRC16ImplSupported(CRC16Impl impl);
+
+/**
+ * @brief 使用指定实现计算 CRC（不支持时退回 slicing-by-8）
+ */
+uint16_t UpdateCRC16With(CRC16Impl impl, uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief CRC16 零字节推进算子
+ *
+ * CRC 是 GF(2) 上的线性变换，因此：
+ * UpdateCRC16(s, payload) == ForZeroBytes(len).Apply(s) ^ UpdateCRC16(0, payload)
+ * 用于广播帧：负载 CRC 只计算一次，不同会话的包头（序号不同）只需 16 次异或即可拼接。
+ */
+struct CRC16Shift {
+    std::array<uint16_t, 16> columns{};
+
+    static CRC16Shift ForZeroBytes(size_t length);
+    uint16_t Apply(uint16_t crc) const;
+};
+
 /**
  * @brief 编码网络包
  *
@@ -96,6 +152,23 @@ uint16_t CalcCRC16(const uint8_t* data, size_t length);
  */
 std::vector<uint8_t> EncodePacket(uint16_t msg_id, const uint8_t* payload, size_t payload_size);
 
+/**
+ * @brief 编码网络包到调用方提供的缓冲区
+ *
+ * @return 写入字节数；payload_size 超过限制或 out_capacity 不足时返回 0。
+ */
+size_t EncodePacketInto(uint16_t msg_id, const uint8_t* payload, size_t payload_size,
+                        uint8_t* out, size_t out_capacity);
+
+/**
+ * @brief 编码网络包到调用方提供的缓冲区，负载由 prefix 与 payload 两段拼接而成
+ *
+ * 用于在负载前附加定长信封而不先拼出中间缓冲。
+ * @return 写入字节数；总负载超过限制或 out_capacity 不足时返回 0。
+ */
+size_t EncodePacketGatherInto(uint16_t msg_id, std::span<const uint8_t> prefix,
+                              std::span<const uint8_t> payload, uint8_t* out, size_t out_capacity);
+
 /**
  * @brief 解码网络包
  *
@@ -103,6 +176,11 @@ std::vector<uint8_t> EncodePacket(uint16_t msg_id, const uint8_t* payload, size_
  */
 DecodeStatus DecodePacket(const uint8_t* data, size_t length, NetworkPacket* out_packet);
 
+/**
+ * @brief 解码网络包（零拷贝，负载指向 data）
+ */
+DecodeStatus DecodePacketView(const uint8_t* data, size_t length, NetworkPacketView* out_view);
+
 /**
  * @brief V2 编码网络包
  *
@@ -114,6 +192,32 @@ std::vector<uint8_t> EncodePacketV2(uint16_t msg_id,
                                     uint16_t sequence,
                                     uint8_t flags = 0);
 
+/**
+ * @brief V2 编码网络包到调用方提供的缓冲区
+ *
+ * @return 写入字节数；payload_size 超过限制或 out_capacity 不足时返回 0。
+ */
+size_t EncodePacketV2Into(uint16_t msg_id,
+                          const uint8_t* payload,
+                          size_t payload_size,
+                          uint16_t sequence,
+                          uint8_t flags,
+                          uint8_t* out,
+                          size_t out_capacity);
+
+/**
+ * @brief V2 编码网络包到调用方提供的缓冲区，负载由 prefix 与 payload 两段拼接而成
+ *
+ * @return 写入字节数；总负载超过限制或 out_capacity 不足时返回 0。
+ */
+size_t EncodePacketV2GatherInto(uint16_t msg_id,
+                                std::span<const uint8_t> prefix,
+                                std::span<const uint8_t> payload,
+                                uint16_t sequence,
+                                uint8_t flags,
+                                uint8_t* out,
+                                size_t out_capacity);
+
 /**
  * @brief V2 解码网络包
  *
@@ -125,6 +229,15 @@ DecodeStatus DecodePacketV2(const uint8_t* data,
                             uint16_t* out_sequence = nullptr,
                             uint8_t* out_flags = nullptr);
 
+/**
+ * @brief V2 解码网络包（零拷贝，负载指向 data）
+ */
+DecodeStatus DecodePacketV2View(const uint8_t* data,
+                                size_t length,
+                                NetworkPacketView* out_view,
+                                uint16_t* out_sequence = nullptr,
+                                uint8_t* out_flags = nullptr);
+
 /**
  * @brief 协议版本检测
  */
@@ -0,0 +1,242 @@
+#include "common/protocol/payload_compression.h"
+
+#include <cstring>
+
+#include "common/protocol/packet_codec.h"
+
+namespace mir2::common {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;   // 块末尾至少 5 字节为字面量
+constexpr size_t kMatchFindLimit = 12; // 最后一个匹配须在末尾 12 字节之前开始
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 12;
+constexpr size_t kOriginalSizeBytes = sizeof(uint32_t);
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value = 0;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+/**
+ * @brief 写长度扩展字节（每字节 255，余数收尾）
+ */
+bool WriteLength(size_t length, uint8_t** op, const uint8_t* oend) {
+    while (length >= 255) {
+        if (*op >= oend) {
+            return false;
+        }
+        *(*op)++ = 255;
+        length -= 255;
+    }
+    if (*op >= oend) {
+        return false;
+    }
+    *(*op)++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+bool EmitSequence(const uint8_t* literals, size_t literal_length, size_t offset,
+                  size_t match_length, uint8_t** op, const uint8_t* oend) {
+    if (*op >= oend) {
+        return false;
+    }
+    uint8_t* token = (*op)++;
+    *token = static_cast<uint8_t>((literal_length >= 15 ? 15 : literal_length) << 4);
+    if (literal_length >= 15 && !WriteLength(literal_length - 15, op, oend)) {
+        return false;
+    }
+    if (static_cast<size_t>(oend - *op) < literal_length) {
+        return false;
+    }
+    std::memcpy(*op, literals, literal_length);
+    *op += literal_length;
+
+    if (match_length == 0) {
+        return true;  // 最后一个序列只有字面量
+    }
+    if (oend - *op < 2) {
+        return false;
+    }
+    *(*op)++ = static_cast<uint8_t>(offset & 0xFF);
+    *(*op)++ = static_cast<uint8_t>(offset >> 8);
+    const size_t extra = match_length - kMinMatch;
+    *token |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+    if (extra >= 15 && !WriteLength(extra - 15, op, oend)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 读取长度扩展字节
+ */
+bool ReadLength(const uint8_t* src, size_t src_size, size_t* ip, size_t* length) {
+    uint8_t byte = 0;
+    do {
+        if (*ip >= src_size) {
+            return false;
+        }
+        byte = src[(*ip)++];
+        *length += byte;
+        if (*length > kMaxPayloadSize) {
+            return false;
+        }
+    } while (byte == 255);
+    return true;
+}
+
+}  // namespace
+
+size_t Lz4CompressBlock(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity) {
+    if (!dst || (!src && src_size > 0)) {
+        return 0;
+    }
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dst_capacity;
+    size_t anchor = 0;
+
+    if (src_size > kMatchFindLimit) {
+        uint32_t table[1u << kHashLog] = {};
+        const size_t match_start_limit = src_size - kMatchFindLimit;
+        const size_t match_end_limit = src_size - kLastLiterals;
+        size_t ip = 0;
+        while (ip <= match_start_limit) {
+            const uint32_t sequence = Read32(src + ip);
+            const uint32_t hash = Hash(sequence);
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip);
+            if (candidate >= ip || ip - candidate > kMaxOffset || Read32(src + candidate) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            size_t match_pos = ip;
+            while (match_pos > anchor && candidate > 0 && src[match_pos - 1] == src[candidate - 1]) {
+                --match_pos;
+                --candidate;
+            }
+            size_t match_length = kMinMatch + (ip - match_pos);
+            while (match_pos + match_length < match_end_limit &&
+                   src[match_pos + match_length] == src[candidate + match_length]) {
+                ++match_length;
+            }
+
+            if (!EmitSequence(src + anchor, match_pos - anchor, match_pos - candidate, match_length,
+                              &op, oend)) {
+                return 0;
+            }
+            ip = match_pos + match_length;
+            anchor = ip;
+            if (ip - 2 <= match_start_limit) {
+                table[Hash(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+            }
+        }
+    }
+
+    if (!EmitSequence(src + anchor, src_size - anchor, 0, 0, &op, oend)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+bool Lz4DecompressBlock(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    if (!src || (!dst && dst_size > 0)) {
+        return false;
+    }
+    size_t ip = 0;
+    size_t op = 0;
+    while (true) {
+        if (ip >= src_size) {
+            return false;
+        }
+        const uint8_t token = src[ip++];
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !ReadLength(src, src_size, &ip, &literal_length)) {
+            return false;
+        }
+        if (literal_length > src_size - ip || literal_length > dst_size - op) {
+            return false;
+        }
+        if (literal_length > 0) {
+            std::memcpy(dst + op, src + ip, literal_length);
+        }
+        ip += literal_length;
+        op += literal_length;
+
+        if (ip == src_size) {
+            return op == dst_size;
+        }
+
+        if (src_size - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(src[ip]) | (static_cast<size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return false;
+        }
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15 && !ReadLength(src, src_size, &ip, &match_length)) {
+            return false;
+        }
+        match_length += kMinMatch;
+        if (match_length > dst_size - op) {
+            return false;
+        }
+
+        const uint8_t* match = dst + op - offset;
+        if (offset >= match_length) {
+            std::memcpy(dst + op, match, match_length);
+        } else {
+            // 重叠拷贝（游程），须逐字节
+            for (size_t i = 0; i < match_length; ++i) {
+                dst[op + i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+}
+
+bool CompressPayload(const uint8_t* payload, size_t payload_size, std::vector<uint8_t>* out) {
+    if (!out || payload_size == 0 || payload_size > kMaxPayloadSize) {
+        return false;
+    }
+    out->resize(kOriginalSizeBytes + Lz4CompressBound(payload_size));
+    const uint32_t original_size = static_cast<uint32_t>(payload_size);
+    std::memcpy(out->data(), &original_size, sizeof(original_size));
+    const size_t compressed_size = Lz4CompressBlock(payload, payload_size,
+                                                    out->data() + kOriginalSizeBytes,
+                                                    out->size() - kOriginalSizeBytes);
+    if (compressed_size == 0 || kOriginalSizeBytes + compressed_size >= payload_size) {
+        return false;
+    }
+    out->resize(kOriginalSizeBytes + compressed_size);
+    return true;
+}
+
+bool DecompressPayload(std::span<const uint8_t> compressed, std::vector<uint8_t>* out,
+                       size_t max_size) {
+    if (!out || compressed.size() <= kOriginalSizeBytes) {
+        return false;
+    }
+    uint32_t original_size = 0;
+    std::memcpy(&original_size, compressed.data(), sizeof(original_size));
+    if (original_size == 0 || original_size > kMaxPayloadSize || original_size > max_size) {
+        return false;
+    }
+    out->resize(original_size);
+    return Lz4DecompressBlock(compressed.data() + kOriginalSizeBytes,
+                              compressed.size() - kOriginalSizeBytes, out->data(), out->size());
+}
+
+}  // namespace mir2::common
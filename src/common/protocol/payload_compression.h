@@ -0,0 +1,63 @@
+/**
+ * @file payload_compression.h
+ * @brief 负载压缩（LZ4 块格式）
+ *
+ * 压缩负载格式：[原始长度 uint32 小端][LZ4 块]，由 V2 包头 PacketFlags::kCompressed 标记。
+ * 块格式与 liblz4 的 LZ4_compress_default/LZ4_decompress_safe 互通，
+ * 本实现不依赖外部库，客户端与服务器共用。
+ */
+
+#ifndef MIR2_COMMON_PROTOCOL_PAYLOAD_COMPRESSION_H
+#define MIR2_COMMON_PROTOCOL_PAYLOAD_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mir2::common {
+
+/**
+ * @brief 默认压缩阈值：小于该长度的负载压缩收益不抵包头与 CPU 开销
+ */
+constexpr size_t kDefaultCompressionThreshold = 256;
+
+/**
+ * @brief LZ4 块压缩的最坏输出长度
+ */
+constexpr size_t Lz4CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief LZ4 块压缩
+ *
+ * @return 写入字节数；dst_capacity 不足时返回 0
+ */
+size_t Lz4CompressBlock(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity);
+
+/**
+ * @brief LZ4 块解压（对畸形输入安全）
+ *
+ * @return 输出恰好为 dst_size 字节时返回 true
+ */
+bool Lz4DecompressBlock(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
+
+/**
+ * @brief 压缩负载
+ *
+ * @return 压缩后更小时写入 out 并返回 true；否则返回 false（调用方应原样发送）
+ */
+bool CompressPayload(const uint8_t* payload, size_t payload_size, std::vector<uint8_t>* out);
+
+/**
+ * @brief 解压负载（原始长度超过 max_size 或数据损坏时返回 false）
+ *
+ * max_size 用于防御解压炸弹：接收方按自身能接受的最大明文长度设置。
+ */
+bool DecompressPayload(std::span<const uint8_t> compressed, std::vector<uint8_t>* out,
+                       size_t max_size = 16 * 1024 * 1024);
+
+}  // namespace mir2::common
+
+#endif  // MIR2_COMMON_PROTOCOL_PAYLOAD_COMPRESSION_H
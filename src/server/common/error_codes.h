@@ -43,6 +43,8 @@ inline const char* ToString(ErrorCode code) {
       return "Path blocked";
     case ErrorCode::kInsufficientMp:
       return "Insufficient MP";
+    case ErrorCode::SERVER_OVERLOADED:
+      return "Server busy";
     case ErrorCode::kKickHeartbeatTimeout:
       return "Heartbeat timeout";
     case ErrorCode::kKickDuplicateLogin:
@@ -6,8 +6,21 @@
 
 namespace mir2::common {
 
+namespace {
+
+/**
+ * @brief 线程内复用的构建器：Clear 保留已分配的缓冲，避免每条消息重新申请
+ */
+flatbuffers::FlatBufferBuilder& ThreadLocalBuilder() {
+  thread_local flatbuffers::FlatBufferBuilder builder(1024);
+  builder.Clear();
+  return builder;
+}
+
+}  // namespace
+
 std::vector<uint8_t> BuildServiceHello(ServiceType service) {
-  flatbuffers::FlatBufferBuilder builder;
+  auto& builder = ThreadLocalBuilder();
   const auto hello = mir2::internal::CreateServiceHello(
       builder, static_cast<mir2::internal::ServiceType>(service));
   builder.Finish(hello);
@@ -16,7 +29,7 @@ std::vector<uint8_t> BuildServiceHello(ServiceType service) {
 }
 
 std::vector<uint8_t> BuildServiceHelloAck(ServiceType service, bool ok) {
-  flatbuffers::FlatBufferBuilder builder;
+  auto& builder = ThreadLocalBuilder();
   const auto ack = mir2::internal::CreateServiceHelloAck(
       builder, static_cast<mir2::internal::ServiceType>(service), ok);
   builder.Finish(ack);
@@ -25,16 +38,16 @@ std::vector<uint8_t> BuildServiceHelloAck(ServiceType service, bool ok) {
 }
 
 std::vector<uint8_t> BuildRoutedMessage(uint64_t client_id, uint16_t msg_id,
-                                        const std::vector<uint8_t>& payload) {
-  flatbuffers::FlatBufferBuilder builder;
-  const auto payload_vec = builder.CreateVector(payload);
+                                        std::span<const uint8_t> payload) {
+  auto& builder = ThreadLocalBuilder();
+  const auto payload_vec = builder.CreateVector(payload.data(), payload.size());
   const auto routed = mir2::internal::CreateRoutedMessage(builder, client_id, msg_id, payload_vec);
   builder.Finish(routed);
   const uint8_t* data = builder.GetBufferPointer();
   return std::vector<uint8_t>(data, data + builder.GetSize());
 }
 
-bool ParseRoutedMessage(const std::vector<uint8_t>& buffer, RoutedMessageData* out_data) {
+bool ParseRoutedMessage(std::span<const uint8_t> buffer, RoutedMessageData* out_data) {
   if (!out_data || buffer.empty()) {
     return false;
   }
@@ -60,7 +73,7 @@ bool ParseRoutedMessage(const std::vector<uint8_t>& buffer, RoutedMessageData* o
   return true;
 }
 
-bool ParseServiceHello(const std::vector<uint8_t>& buffer, ServiceType* out_service) {
+bool ParseServiceHello(std::span<const uint8_t> buffer, ServiceType* out_service) {
   if (!out_service || buffer.empty()) {
     return false;
   }
@@ -79,7 +92,7 @@ bool ParseServiceHello(const std::vector<uint8_t>& buffer, ServiceType* out_serv
   return true;
 }
 
-bool ParseServiceHelloAck(const std::vector<uint8_t>& buffer, ServiceType* out_service, bool* out_ok) {
+bool ParseServiceHelloAck(std::span<const uint8_t> buffer, ServiceType* out_service, bool* out_ok) {
   if (!out_service || !out_ok || buffer.empty()) {
     return false;
   }
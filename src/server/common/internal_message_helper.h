@@ -7,6 +7,7 @@
 #define MIR2_COMMON_INTERNAL_MESSAGE_HELPER_H
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "common/enums.h"
@@ -36,22 +37,22 @@ std::vector<uint8_t> BuildServiceHelloAck(ServiceType service, bool ok);
  * @brief 构建路由消息
  */
 std::vector<uint8_t> BuildRoutedMessage(uint64_t client_id, uint16_t msg_id,
-                                        const std::vector<uint8_t>& payload);
+                                        std::span<const uint8_t> payload);
 
 /**
  * @brief 解析路由消息
  */
-bool ParseRoutedMessage(const std::vector<uint8_t>& buffer, RoutedMessageData* out_data);
+bool ParseRoutedMessage(std::span<const uint8_t> buffer, RoutedMessageData* out_data);
 
 /**
  * @brief 解析服务握手消息
  */
-bool ParseServiceHello(const std::vector<uint8_t>& buffer, ServiceType* out_service);
+bool ParseServiceHello(std::span<const uint8_t> buffer, ServiceType* out_service);
 
 /**
  * @brief 解析服务握手响应
  */
-bool ParseServiceHelloAck(const std::vector<uint8_t>& buffer, ServiceType* out_service, bool* out_ok);
+bool ParseServiceHelloAck(std::span<const uint8_t> buffer, ServiceType* out_service, bool* out_ok);
 
 }  // namespace mir2::common
 
@@ -0,0 +1,81 @@
+/**
+ * @file msg_id_table.h
+ * @brief 按 msg_id 直接索引的两级分发表
+ */
+
+#ifndef MIR2_COMMON_MSG_ID_TABLE_H
+#define MIR2_COMMON_MSG_ID_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mir2::common {
+
+/**
+ * @brief msg_id -> T 的两级直接索引表
+ *
+ * 高 8 位选页、低 8 位选槽，查找是两次数组下标访问，不做哈希。页按需分配：
+ * 客户端消息（1000-9999）与内部消息（60000+）只占用少数几页，而不是 64K 个槽位。
+ * 未分配的页返回 nullptr，已分配页中的空槽为 T{}，由调用方判断是否有效。
+ * 本身不加锁：要么只在启动阶段写入，要么整张表作为不可变快照发布。
+ */
+template <typename T>
+class MsgIdTable {
+ public:
+  static constexpr size_t kPageBits = 8;
+  static constexpr size_t kPageSize = size_t{1} << kPageBits;
+  static constexpr size_t kPageCount = size_t{1} << (16 - kPageBits);
+
+  MsgIdTable() = default;
+  MsgIdTable(MsgIdTable&&) noexcept = default;
+  MsgIdTable& operator=(MsgIdTable&&) noexcept = default;
+
+  /**
+   * @brief 深拷贝（用于写时复制生成新快照）
+   */
+  MsgIdTable(const MsgIdTable& other) {
+    for (size_t i = 0; i < kPageCount; ++i) {
+      if (other.pages_[i]) {
+        pages_[i] = std::make_unique<Page>(*other.pages_[i]);
+      }
+    }
+  }
+
+  MsgIdTable& operator=(const MsgIdTable& other) {
+    if (this != &other) {
+      MsgIdTable copy(other);
+      pages_.swap(copy.pages_);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief 查找槽位；所在页未分配时返回 nullptr
+   */
+  const T* Find(uint16_t msg_id) const {
+    const Page* page = pages_[msg_id >> kPageBits].get();
+    return page ? &(*page)[msg_id & (kPageSize - 1)] : nullptr;
+  }
+
+  /**
+   * @brief 取得可写槽位，必要时分配所在页
+   */
+  T& At(uint16_t msg_id) {
+    auto& page = pages_[msg_id >> kPageBits];
+    if (!page) {
+      page = std::make_unique<Page>();
+    }
+    return (*page)[msg_id & (kPageSize - 1)];
+  }
+
+ private:
+  using Page = std::array<T, kPageSize>;
+
+  std::array<std::unique_ptr<Page>, kPageCount> pages_;
+};
+
+}  // namespace mir2::common
+
+#endif  // MIR2_COMMON_MSG_ID_TABLE_H
@@ -0,0 +1,148 @@
+#include "common/routed_envelope.h"
+
+#include <cstring>
+
+namespace mir2::common {
+
+namespace {
+
+// 组播体头：recipient_count u32 + 保留 u32，使接收者列表在帧内 8 字节对齐
+constexpr size_t kMulticastHeaderSize = 8;
+
+}  // namespace
+
+std::array<uint8_t, RoutedEnvelope::kSize> RoutedEnvelope::ToBytes() const {
+  std::array<uint8_t, kSize> buffer{};
+  std::memcpy(buffer.data(), &client_id, sizeof(client_id));
+  std::memcpy(buffer.data() + 8, &msg_id, sizeof(msg_id));
+  std::memcpy(buffer.data() + 10, &flags, sizeof(flags));
+  std::memcpy(buffer.data() + 12, &payload_size, sizeof(payload_size));
+  return buffer;
+}
+
+bool RoutedEnvelope::FromBytes(const uint8_t* data, size_t len, RoutedEnvelope* out) {
+  if (!data || len < kSize || !out) {
+    return false;
+  }
+  std::memcpy(&out->client_id, data, sizeof(out->client_id));
+  std::memcpy(&out->msg_id, data + 8, sizeof(out->msg_id));
+  std::memcpy(&out->flags, data + 10, sizeof(out->flags));
+  std::memcpy(&out->payload_size, data + 12, sizeof(out->payload_size));
+  return true;
+}
+
+std::vector<uint8_t> BuildRoutedFrame(uint64_t client_id, uint16_t msg_id,
+                                      std::span<const uint8_t> payload) {
+  std::vector<uint8_t> buffer;
+  AppendRoutedFrame(&buffer, client_id, msg_id, payload);
+  return buffer;
+}
+
+void AppendRoutedFrame(std::vector<uint8_t>* out, uint64_t client_id, uint16_t msg_id,
+                       std::span<const uint8_t> payload) {
+  if (!out) {
+    return;
+  }
+  RoutedEnvelope envelope;
+  envelope.client_id = client_id;
+  envelope.msg_id = msg_id;
+  envelope.payload_size = static_cast<uint32_t>(payload.size());
+  const auto header = envelope.ToBytes();
+  out->insert(out->end(), header.begin(), header.end());
+  out->insert(out->end(), payload.begin(), payload.end());
+}
+
+bool PeelRoutedFrame(std::span<const uint8_t> buffer, RoutedFrameView* out_view) {
+  RoutedEnvelope envelope;
+  if (!out_view || !RoutedEnvelope::FromBytes(buffer.data(), buffer.size(), &envelope)) {
+    return false;
+  }
+  if (envelope.payload_size != buffer.size() - RoutedEnvelope::kSize) {
+    return false;
+  }
+  out_view->client_id = envelope.client_id;
+  out_view->msg_id = envelope.msg_id;
+  out_view->flags = envelope.flags;
+  out_view->payload = buffer.subspan(RoutedEnvelope::kSize);
+  return true;
+}
+
+uint64_t RoutedMulticastView::RecipientAt(size_t index) const {
+  uint64_t client_id = 0;
+  std::memcpy(&client_id, recipients.data() + index * sizeof(uint64_t), sizeof(client_id));
+  return client_id;
+}
+
+void AppendRoutedMulticast(std::vector<uint8_t>* out, std::span<const uint64_t> client_ids,
+                           uint16_t msg_id, std::span<const uint8_t> payload) {
+  if (!out) {
+    return;
+  }
+  const uint32_t recipient_count = static_cast<uint32_t>(client_ids.size());
+  const size_t body_size = kMulticastHeaderSize + client_ids.size_bytes() + payload.size();
+
+  RoutedEnvelope envelope;
+  envelope.msg_id = msg_id;
+  envelope.flags = kRoutedFlagMulticast;
+  envelope.payload_size = static_cast<uint32_t>(body_size);
+  const auto header = envelope.ToBytes();
+
+  const size_t offset = out->size();
+  out->resize(offset + RoutedEnvelope::kSize + body_size);
+  uint8_t* cursor = out->data() + offset;
+  std::memcpy(cursor, header.data(), header.size());
+  cursor += header.size();
+  std::memcpy(cursor, &recipient_count, sizeof(recipient_count));
+  std::memset(cursor + sizeof(recipient_count), 0, kMulticastHeaderSize - sizeof(recipient_count));
+  cursor += kMulticastHeaderSize;
+  if (!client_ids.empty()) {
+    std::memcpy(cursor, client_ids.data(), client_ids.size_bytes());
+    cursor += client_ids.size_bytes();
+  }
+  if (!payload.empty()) {
+    std::memcpy(cursor, payload.data(), payload.size());
+  }
+}
+
+bool PeelRoutedMulticast(const RoutedFrameView& frame, RoutedMulticastView* out_view) {
+  if (!out_view || (frame.flags & kRoutedFlagMulticast) == 0 ||
+      frame.payload.size() < kMulticastHeaderSize) {
+    return false;
+  }
+  uint32_t recipient_count = 0;
+  std::memcpy(&recipient_count, frame.payload.data(), sizeof(recipient_count));
+  const size_t recipients_size = static_cast<size_t>(recipient_count) * sizeof(uint64_t);
+  if (recipients_size > frame.payload.size() - kMulticastHeaderSize) {
+    return false;
+  }
+  out_view->msg_id = frame.msg_id;
+  out_view->recipient_count = recipient_count;
+  out_view->recipients = frame.payload.subspan(kMulticastHeaderSize, recipients_size);
+  out_view->payload = frame.payload.subspan(kMulticastHeaderSize + recipients_size);
+  return true;
+}
+
+bool SplitRoutedBatch(std::span<const uint8_t> batch,
+                      std::vector<std::span<const uint8_t>>* out_frames) {
+  if (!out_frames) {
+    return false;
+  }
+  out_frames->clear();
+  size_t offset = 0;
+  while (offset < batch.size()) {
+    RoutedEnvelope envelope;
+    if (!RoutedEnvelope::FromBytes(batch.data() + offset, batch.size() - offset, &envelope)) {
+      return false;
+    }
+    const size_t remaining = batch.size() - offset - RoutedEnvelope::kSize;
+    if (envelope.payload_size > remaining) {
+      return false;
+    }
+    const size_t frame_size = RoutedEnvelope::kSize + envelope.payload_size;
+    out_frames->push_back(batch.subspan(offset, frame_size));
+    offset += frame_size;
+  }
+  return true;
+}
+
+}  // namespace mir2::common
@@ -0,0 +1,112 @@
+/**
+ * @file routed_envelope.h
+ * @brief 定长路由信封（网关与后端之间转发客户端消息）
+ */
+
+#ifndef MIR2_COMMON_ROUTED_ENVELOPE_H
+#define MIR2_COMMON_ROUTED_ENVELOPE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mir2::common {
+
+/**
+ * @brief 路由信封（16字节, Little Endian）
+ *
+ * 布局：
+ * [0..7]   client_id
+ * [8..9]   msg_id
+ * [10..11] flags（kRoutedFlag*）
+ * [12..15] payload_size
+ *
+ * 以 InternalMsgId::kRoutedFrame 发送，信封之后紧跟客户端原始负载。转发方只需
+ * 在负载前写入 16 字节、接收方剥掉 16 字节，不经过 FlatBuffers 序列化与校验。
+ * InternalMsgId::kRoutedBatch 的负载是若干这样的路由帧首尾相接。
+ */
+struct RoutedEnvelope {
+  static constexpr size_t kSize = 16;
+
+  uint64_t client_id = 0;
+  uint16_t msg_id = 0;
+  uint16_t flags = 0;
+  uint32_t payload_size = 0;
+
+  std::array<uint8_t, kSize> ToBytes() const;
+  static bool FromBytes(const uint8_t* data, size_t len, RoutedEnvelope* out);
+};
+
+/**
+ * @brief 组播帧：一份负载发往多个客户端
+ *
+ * 信封 client_id 为 0，负载为
+ * [recipient_count u32][保留 u32][client_id u64 × recipient_count][客户端负载]。
+ */
+constexpr uint16_t kRoutedFlagMulticast = 0x0001;
+
+/**
+ * @brief 路由帧视图（负载指向接收缓冲区，仅在回调期间有效）
+ */
+struct RoutedFrameView {
+  uint64_t client_id = 0;
+  uint16_t msg_id = 0;
+  uint16_t flags = 0;
+  std::span<const uint8_t> payload;
+};
+
+/**
+ * @brief 组播帧视图（接收者列表与负载均指向接收缓冲区）
+ */
+struct RoutedMulticastView {
+  uint16_t msg_id = 0;
+  size_t recipient_count = 0;
+  std::span<const uint8_t> recipients;  // recipient_count 个 Little Endian u64，可能未对齐
+  std::span<const uint8_t> payload;
+
+  uint64_t RecipientAt(size_t index) const;
+};
+
+/**
+ * @brief 构建路由帧负载（信封 + 负载）
+ *
+ * 发送路径优先使用 TcpSession/TcpClient::SendRouted，它直接编码进发送缓冲。
+ */
+std::vector<uint8_t> BuildRoutedFrame(uint64_t client_id, uint16_t msg_id,
+                                      std::span<const uint8_t> payload);
+
+/**
+ * @brief 剥离路由信封（不复制负载）；长度与信封不符时返回 false
+ */
+bool PeelRoutedFrame(std::span<const uint8_t> buffer, RoutedFrameView* out_view);
+
+/**
+ * @brief 在 out 末尾追加一条路由帧（信封 + 负载）
+ */
+void AppendRoutedFrame(std::vector<uint8_t>* out, uint64_t client_id, uint16_t msg_id,
+                       std::span<const uint8_t> payload);
+
+/**
+ * @brief 在 out 末尾追加一条组播帧（信封 + 接收者列表 + 负载）
+ */
+void AppendRoutedMulticast(std::vector<uint8_t>* out, std::span<const uint64_t> client_ids,
+                           uint16_t msg_id, std::span<const uint8_t> payload);
+
+/**
+ * @brief 解析带 kRoutedFlagMulticast 的路由帧；接收者数量与长度不符时返回 false
+ */
+bool PeelRoutedMulticast(const RoutedFrameView& frame, RoutedMulticastView* out_view);
+
+/**
+ * @brief 把 kRoutedBatch 负载切分为若干完整路由帧（视图指向 batch，可直接 PeelRoutedFrame）
+ *
+ * 批次即若干路由帧首尾相接；任一信封越界时返回 false，out_frames 内容不可用。
+ */
+bool SplitRoutedBatch(std::span<const uint8_t> batch,
+                      std::vector<std::span<const uint8_t>>* out_frames);
+
+}  // namespace mir2::common
+
+#endif  // MIR2_COMMON_ROUTED_ENVELOPE_H
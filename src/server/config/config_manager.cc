@@ -28,11 +28,27 @@ bool ConfigManager::Load(const std::string& config_path) {
     server_config_.bind_ip = ReadOrDefault(server, "bind_ip", server_config_.bind_ip);
     server_config_.port = ReadOrDefault(server, "port", server_config_.port);
     server_config_.io_threads = ReadOrDefault(server, "io_threads", server_config_.io_threads);
+    server_config_.io_thread_per_core =
+        ReadOrDefault(server, "io_thread_per_core", server_config_.io_thread_per_core);
     server_config_.max_connections = ReadOrDefault(server, "max_connections", server_config_.max_connections);
     server_config_.tick_interval_ms = ReadOrDefault(server, "tick_interval_ms", server_config_.tick_interval_ms);
     server_config_.heartbeat_timeout_ms =
         ReadOrDefault(server, "heartbeat_timeout_ms", server_config_.heartbeat_timeout_ms);
     server_config_.metrics_port = ReadOrDefault(server, "metrics_port", server_config_.metrics_port);
+    server_config_.send_cork = ReadOrDefault(server, "send_cork", server_config_.send_cork);
+    server_config_.send_cork_bytes =
+        ReadOrDefault(server, "send_cork_bytes", server_config_.send_cork_bytes);
+    server_config_.tcp_nodelay = ReadOrDefault(server, "tcp_nodelay", server_config_.tcp_nodelay);
+    server_config_.compression_threshold =
+        ReadOrDefault(server, "compression_threshold", server_config_.compression_threshold);
+    server_config_.routed_batch_bytes =
+        ReadOrDefault(server, "routed_batch_bytes", server_config_.routed_batch_bytes);
+    server_config_.overload_queue_bytes =
+        ReadOrDefault(server, "overload_queue_bytes", server_config_.overload_queue_bytes);
+    server_config_.overload_backlog_ms =
+        ReadOrDefault(server, "overload_backlog_ms", server_config_.overload_backlog_ms);
+    server_config_.socket_backend =
+        ReadOrDefault(server, "socket_backend", server_config_.socket_backend);
 
     const YAML::Node database = root["database"];
     database_config_.host = ReadOrDefault(database, "host", database_config_.host);
@@ -58,18 +74,35 @@ bool ConfigManager::Load(const std::string& config_path) {
     const YAML::Node world = services["world"];
     service_config_.world.host = ReadOrDefault(world, "host", service_config_.world.host);
     service_config_.world.port = ReadOrDefault(world, "port", service_config_.world.port);
+    service_config_.world.links = ReadOrDefault(world, "links", service_config_.world.links);
 
     const YAML::Node game = services["game"];
     service_config_.game.host = ReadOrDefault(game, "host", service_config_.game.host);
     service_config_.game.port = ReadOrDefault(game, "port", service_config_.game.port);
+    service_config_.game.links = ReadOrDefault(game, "links", service_config_.game.links);
 
     const YAML::Node db = services["db"];
     service_config_.db.host = ReadOrDefault(db, "host", service_config_.db.host);
     service_config_.db.port = ReadOrDefault(db, "port", service_config_.db.port);
+    service_config_.db.links = ReadOrDefault(db, "links", service_config_.db.links);
 
     const YAML::Node ecs = root["ecs"];
     ecs_config_.world_registry_reserve =
         ReadOrDefault(ecs, "world_registry_reserve", ecs_config_.world_registry_reserve);
+    ecs_config_.world_update_threads =
+        ReadOrDefault(ecs, "world_update_threads", ecs_config_.world_update_threads);
+    ecs_config_.system_update_threads =
+        ReadOrDefault(ecs, "system_update_threads", ecs_config_.system_update_threads);
+    ecs_config_.tick_budget_ms =
+        ReadOrDefault(ecs, "tick_budget_ms", ecs_config_.tick_budget_ms);
+    ecs_config_.time_slice_entities =
+        ReadOrDefault(ecs, "time_slice_entities", ecs_config_.time_slice_entities);
+    ecs_config_.auto_save_per_tick =
+        ReadOrDefault(ecs, "auto_save_per_tick", ecs_config_.auto_save_per_tick);
+    ecs_config_.command_queue_capacity =
+        ReadOrDefault(ecs, "command_queue_capacity", ecs_config_.command_queue_capacity);
+    ecs_config_.command_drain_budget =
+        ReadOrDefault(ecs, "command_drain_budget", ecs_config_.command_drain_budget);
 
     const auto config_dir = std::filesystem::path(config_path).parent_path();
     if (!config_dir.empty()) {
@@ -26,10 +26,19 @@ struct ServerConfig {
   std::string bind_ip = "0.0.0.0";
   uint16_t port = common::kDefaultServerPort;
   int io_threads = common::kDefaultIoThreads;
+  bool io_thread_per_core = false;  // 每个IO线程独占 io_context 与 SO_REUSEPORT 监听
   int max_connections = common::kMaxConnections;
   int tick_interval_ms = common::kDefaultTickIntervalMs;
   int heartbeat_timeout_ms = 30000;
   uint16_t metrics_port = 0;
+  bool send_cork = false;          // Tick 内消息攒批，Tick 末尾统一写出
+  int send_cork_bytes = 16 * 1024; // 攒批超过该字节数时提前写出
+  bool tcp_nodelay = true;
+  int compression_threshold = 0;   // V2 负载压缩阈值（字节），0 表示关闭
+  int routed_batch_bytes = 0;      // 内部路由帧攒批上限（字节），0 表示逐条发送；批次在 Tick 末尾写出
+  int overload_queue_bytes = 0;    // 网关后端链路过载阈值（发送队列字节），0 表示关闭过载削减
+  int overload_backlog_ms = 200;   // 网关后端链路过载阈值（发送队列持续积压毫秒）
+  std::string socket_backend = "asio";  // 连接读写后端："asio" 或 "io_uring"（仅 Linux）
 };
 
 /**
@@ -70,6 +79,7 @@ struct LogConfig {
 struct ServiceEndpoint {
   std::string host = "127.0.0.1";
   uint16_t port = 0;
+  int links = 1;  ///< 网关到该服务的并行连接数（按 client_id 一致性哈希分配）
 };
 
 /**
@@ -86,6 +96,13 @@ struct ServiceConfig {
  */
 struct EcsConfig {
   std::size_t world_registry_reserve = 1000;  ///< 单地图预估玩家数（用于预分配）
+  std::size_t world_update_threads = 0;       ///< 并行更新各地图 World 的工作线程数（0 表示串行）
+  std::size_t system_update_threads = 0;       ///< 地图内并行执行互不冲突 System 的工作线程数（0 表示串行）
+  int tick_budget_ms = 40;                    ///< 单 Tick 逻辑预算（毫秒），耗尽后可延后的系统与自动存档让到下一 Tick；0 表示不限
+  std::size_t time_slice_entities = 512;      ///< 可延后系统每 Tick 最多处理的实体数（0 表示全部）
+  std::size_t auto_save_per_tick = 64;        ///< 每 Tick 最多自动存档的角色数（0 表示不限）
+  std::size_t command_queue_capacity = 65536; ///< IO 线程 -> 逻辑线程命令队列容量（满时丢弃新消息）
+  std::size_t command_drain_budget = 8192;    ///< 每个 Tick 最多处理的命令数（0 表示不限）
 };
 
 /**
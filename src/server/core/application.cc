@@ -1,7 +1,13 @@
 #include "core/application.h"
 
+#include <cstring>
 #include <iostream>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace mir2::core {
 
 Application::Application() = default;
@@ -20,24 +26,57 @@ bool Application::Initialize(const config::ServerConfig& server_config) {
     io_thread_count_ = 1;
   }
 
-  io_context_ = std::make_unique<asio::io_context>();
-  work_guard_ = std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(
-      asio::make_work_guard(*io_context_));
+  thread_per_core_ = server_config.io_thread_per_core;
+
+  // 共享模式：一个上下文由 N 个线程共同驱动；
+  // 每核模式：N 个上下文各由一个线程驱动，会话在其生命周期内固定于该线程。
+  const int context_count = thread_per_core_ ? io_thread_count_ : 1;
+  io_contexts_.reserve(static_cast<size_t>(context_count));
+  work_guards_.reserve(static_cast<size_t>(context_count));
+  for (int i = 0; i < context_count; ++i) {
+    // 并发提示：单线程驱动时 asio 调度器可省去线程间唤醒
+    io_contexts_.push_back(
+        std::make_unique<asio::io_context>(thread_per_core_ ? 1 : io_thread_count_));
+    work_guards_.push_back(asio::make_work_guard(*io_contexts_.back()));
+  }
 
   tick_timer_ = std::make_unique<TickTimer>(server_config.tick_interval_ms);
 
   io_threads_.reserve(static_cast<size_t>(io_thread_count_));
   for (int i = 0; i < io_thread_count_; ++i) {
-    io_threads_.emplace_back([this]() {
-      if (io_context_) {
-        io_context_->run();
-      }
-    });
+    if (thread_per_core_) {
+      StartIoThread(*io_contexts_[static_cast<size_t>(i)], i);
+    } else {
+      StartIoThread(*io_contexts_.front(), -1);
+    }
   }
 
   return true;
 }
 
+void Application::StartIoThread(asio::io_context& io_context, int core_index) {
+  io_threads_.emplace_back([&io_context, core_index]() {
+#ifdef __linux__
+    // 每核模式下尽力绑定 CPU，失败（如容器限制）时保持默认调度
+    const unsigned int cpu_count = std::thread::hardware_concurrency();
+    if (core_index >= 0 && cpu_count > 0) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(static_cast<unsigned int>(core_index) % cpu_count, &cpu_set);
+      const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+      if (rc != 0) {
+        std::cerr << "Failed to pin io thread " << core_index << " to cpu "
+                  << (static_cast<unsigned int>(core_index) % cpu_count) << ": "
+                  << std::strerror(rc) << std::endl;
+      }
+    }
+#else
+    (void)core_index;
+#endif
+    io_context.run();
+  });
+}
+
 void Application::Run(const std::function<void(float)>& tick_callback) {
   if (!tick_timer_) {
     return;
@@ -61,17 +100,20 @@ void Application::Stop() {
 }
 
 void Application::Shutdown() {
-  if (!io_context_) {
+  if (io_contexts_.empty()) {
     return;
   }
 
   running_.store(false);
 
-  if (work_guard_) {
-    work_guard_.reset();
+  for (auto& work_guard : work_guards_) {
+    work_guard.reset();
   }
+  work_guards_.clear();
 
-  io_context_->stop();
+  for (auto& io_context : io_contexts_) {
+    io_context->stop();
+  }
 
   for (auto& thread : io_threads_) {
     if (thread.joinable()) {
@@ -80,12 +122,21 @@ void Application::Shutdown() {
   }
 
   io_threads_.clear();
-  io_context_.reset();
+  io_contexts_.clear();
   tick_timer_.reset();
 }
 
 asio::io_context& Application::GetIoContext() {
-  return *io_context_;
+  return *io_contexts_.front();
+}
+
+std::vector<asio::io_context*> Application::GetIoContexts() const {
+  std::vector<asio::io_context*> contexts;
+  contexts.reserve(io_contexts_.size());
+  for (const auto& io_context : io_contexts_) {
+    contexts.push_back(io_context.get());
+  }
+  return contexts;
 }
 
 }  // namespace mir2::core
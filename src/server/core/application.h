@@ -58,21 +58,41 @@ class Application {
 
   /**
    * @brief 获取IO上下文
+   *
+   * 共享模式下为所有IO线程共用的上下文；每核模式下为 0 号核心的上下文。
    */
   asio::io_context& GetIoContext();
 
+  /**
+   * @brief 获取全部IO上下文
+   *
+   * 共享模式下只有一个元素；每核模式下每个IO线程一个，
+   * 跨核工作需显式 post 到目标上下文。
+   */
+  std::vector<asio::io_context*> GetIoContexts() const;
+
+  /**
+   * @brief 是否为每核独立 io_context 模式
+   */
+  bool IsThreadPerCore() const { return thread_per_core_; }
+
   /**
    * @brief 查询运行状态
    */
   bool IsRunning() const { return running_.load(); }
 
  private:
-  std::unique_ptr<asio::io_context> io_context_;
-  std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> work_guard_;
+  using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+  void StartIoThread(asio::io_context& io_context, int core_index);
+
+  std::vector<std::unique_ptr<asio::io_context>> io_contexts_;
+  std::vector<WorkGuard> work_guards_;
   std::vector<std::thread> io_threads_;
   std::unique_ptr<TickTimer> tick_timer_;
   std::atomic<bool> running_{false};
   int io_thread_count_ = 0;
+  bool thread_per_core_ = false;
 };
 
 }  // namespace mir2::core
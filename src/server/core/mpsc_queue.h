@@ -0,0 +1,172 @@
+/**
+ * @file mpsc_queue.h
+ * @brief 有界无锁多生产者单消费者队列
+ */
+
+#ifndef MIR2_CORE_MPSC_QUEUE_H
+#define MIR2_CORE_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace mir2::core {
+
+/**
+ * @brief 有界 MPSC 队列（环形数组 + 每槽序号）
+ *
+ * 生产者以 CAS 领取写位置，消费者独占读位置；每个槽位的序号表明它当前
+ * 可写还是可读，因此入队/出队都不加锁、不分配。槽位在构造时一次性分配，
+ * 容量向上取整到 2 的幂。队列满时 TryPush 返回 false，由调用方决定丢弃或降级。
+ * 同一生产者的元素按入队顺序出队。TryPop / TryConsume 只能在一个线程调用。
+ *
+ * TryPushWith / TryConsume 直接在槽位中的对象上读写，对象本身不随出入队移动或析构，
+ * 其内部缓冲（如 vector 容量）在槽位间循环复用，稳态下不再分配。
+ */
+template <typename T>
+class BoundedMpscQueue {
+ public:
+  explicit BoundedMpscQueue(size_t capacity)
+      : capacity_(RoundUpPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        cells_(std::make_unique<Cell[]>(capacity_)) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+  BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+  /**
+   * @brief 入队（任意线程）；队列满时返回 false，value 保持不变
+   */
+  bool TryPush(T&& value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief 原地入队（任意线程）：fill(T&) 写入槽位中已有的对象；队列满时返回 false
+   *
+   * fill 抛出异常时槽位仍会发布，对象保持 fill 已写入的状态。
+   */
+  template <typename Fill>
+  bool TryPushWith(Fill&& fill) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          SequenceRelease publish{cell.sequence, pos + 1};
+          fill(cell.value);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief 原地出队（仅消费者线程）：consume(T&) 处理槽位中的对象，返回后槽位交还生产者
+   *
+   * 对象不被移出也不析构，需要释放的成员（如 shared_ptr）由 consume 自行清理；
+   * consume 抛出异常时槽位同样交还。队列为空时返回 false。
+   */
+  template <typename Consume>
+  bool TryConsume(Consume&& consume) {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1) {
+      return false;
+    }
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    SequenceRelease release{cell.sequence, pos + capacity_};
+    consume(cell.value);
+    return true;
+  }
+
+  /**
+   * @brief 出队（仅消费者线程）；队列为空时返回 false
+   */
+  bool TryPop(T* out) {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1) {
+      return false;
+    }
+    *out = std::move(cell.value);
+    cell.value = T{};
+    cell.sequence.store(pos + capacity_, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief 近似长度（并发入队时仅供监控）
+   */
+  size_t ApproxSize() const {
+    const size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    T value{};
+  };
+
+  /**
+   * @brief 作用域结束时发布槽位序号（原地读写期间即使抛出异常也不会卡住队列）
+   */
+  struct SequenceRelease {
+    std::atomic<size_t>& sequence;
+    size_t value;
+    ~SequenceRelease() { sequence.store(value, std::memory_order_release); }
+  };
+
+  static size_t RoundUpPowerOfTwo(size_t value) {
+    size_t capacity = 2;
+    while (capacity < value) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  // 生产者与消费者的游标分处不同缓存行，避免伪共享
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+}  // namespace mir2::core
+
+#endif  // MIR2_CORE_MPSC_QUEUE_H
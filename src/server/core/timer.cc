@@ -48,4 +48,18 @@ void TickTimer::EndTick() {
   }
 }
 
+void TickBudget::Begin(std::chrono::microseconds budget) {
+  budget_ = budget;
+  start_ = std::chrono::steady_clock::now();
+}
+
+bool TickBudget::Exhausted() const {
+  return budget_.count() > 0 && Elapsed() >= budget_;
+}
+
+std::chrono::microseconds TickBudget::Elapsed() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_);
+}
+
 }  // namespace mir2::core
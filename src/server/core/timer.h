@@ -61,6 +61,36 @@ class TickTimer {
   uint64_t rate_tick_count_ = 0;
 };
 
+/**
+ * @brief 单个 Tick 的逻辑时间预算
+ *
+ * 逻辑线程在 Tick 开始时 Begin；可延后的工作（时间片系统、自动存档）在预算耗尽后
+ * 让到下一 Tick，对延迟敏感的工作不受影响。预算为 0 表示不限。
+ */
+class TickBudget {
+ public:
+  /**
+   * @brief 开始计时本 Tick
+   */
+  void Begin(std::chrono::microseconds budget);
+
+  /**
+   * @brief 预算是否已耗尽（未设置预算时始终为 false）
+   */
+  bool Exhausted() const;
+
+  /**
+   * @brief 本 Tick 已用时间
+   */
+  std::chrono::microseconds Elapsed() const;
+
+  std::chrono::microseconds Budget() const { return budget_; }
+
+ private:
+  std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+  std::chrono::microseconds budget_{0};
+};
+
 }  // namespace mir2::core
 
 #endif  // MIR2_CORE_TIMER_H
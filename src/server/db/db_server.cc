@@ -1,11 +1,14 @@
 #include "db/db_server.h"
 
+#include <algorithm>
 #include <functional>
 
 #include "common/enums.h"
 #include "common/internal_message_helper.h"
+#include "common/routed_envelope.h"
 #include "config/config_manager.h"
 #include "handlers/login/login_handler.h"
+#include "handlers/routed_responses.h"
 #include "log/logger.h"
 #include "monitor/metrics.h"
 
@@ -72,14 +75,25 @@ bool DbServer::Initialize(const std::string& config_path) {
     }
 
     network_ = std::make_unique<network::NetworkManager>(app_.GetIoContext());
-    if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
-        SYSLOG_ERROR("DBServer network start failed");
-        return false;
-    }
+    network_->SetIoContexts(app_.GetIoContexts());
+    network::SendPolicy send_policy;
+    send_policy.cork = server_config.send_cork;
+    send_policy.cork_bytes = static_cast<size_t>(server_config.send_cork_bytes);
+    send_policy.tcp_nodelay = server_config.tcp_nodelay;
+    send_policy.compression_threshold =
+        static_cast<size_t>(std::max(0, server_config.compression_threshold));
+    send_policy.routed_batch_bytes =
+        static_cast<size_t>(std::max(0, server_config.routed_batch_bytes));
+    network_->SetSendPolicy(send_policy);
+    network_->SetSocketBackend(network::ParseSocketBackend(server_config.socket_backend));
 
     login_service_ = std::make_unique<DbLoginService>(database_manager_, app_.GetIoContext());
     RegisterMessageHandlers();
     RegisterHandlers();
+    if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
+        SYSLOG_ERROR("DBServer network start failed");
+        return false;
+    }
     SYSLOG_INFO("DBServer initialized");
     return true;
 }
@@ -117,7 +131,7 @@ void DbServer::RegisterHandlers() {
 
     network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
                               [this](const std::shared_ptr<network::TcpSession>& session,
-                                     const std::vector<uint8_t>& payload) {
+                                     std::span<const uint8_t> payload) {
                                   if (!session) {
                                       return;
                                   }
@@ -134,8 +148,25 @@ void DbServer::RegisterHandlers() {
 
     network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage),
                               [this](const std::shared_ptr<network::TcpSession>& session,
-                                     const std::vector<uint8_t>& payload) {
-                                  HandleRoutedMessage(session, payload);
+                                     std::span<const uint8_t> payload) {
+                                  HandleRoutedMessage(session, payload, false);
+                              });
+    network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame),
+                              [this](const std::shared_ptr<network::TcpSession>& session,
+                                     std::span<const uint8_t> payload) {
+                                  HandleRoutedMessage(session, payload, true);
+                              });
+    network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedBatch),
+                              [this](const std::shared_ptr<network::TcpSession>& session,
+                                     std::span<const uint8_t> payload) {
+                                  thread_local std::vector<std::span<const uint8_t>> frames;
+                                  if (!common::SplitRoutedBatch(payload, &frames)) {
+                                      SYSLOG_ERROR("Malformed routed batch, size={}", payload.size());
+                                      return;
+                                  }
+                                  for (const auto frame : frames) {
+                                      HandleRoutedMessage(session, frame, true);
+                                  }
                               });
 }
 
@@ -146,12 +177,22 @@ void DbServer::RegisterMessageHandlers() {
 }
 
 void DbServer::HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& session,
-                                   const std::vector<uint8_t>& payload) {
+                                   std::span<const uint8_t> payload, bool framed) {
     if (!session) {
         return;
     }
     common::RoutedMessageData routed;
-    if (!common::ParseRoutedMessage(payload, &routed)) {
+    if (framed) {
+        common::RoutedFrameView view;
+        if (!common::PeelRoutedFrame(payload, &view)) {
+            SYSLOG_ERROR("DBServer failed to peel routed frame");
+            return;
+        }
+        routed.client_id = view.client_id;
+        routed.msg_id = view.msg_id;
+        // 处理器接口持有负载（可能投递到逻辑线程），此处是唯一一次复制
+        routed.payload.assign(view.payload.begin(), view.payload.end());
+    } else if (!common::ParseRoutedMessage(payload, &routed)) {
         SYSLOG_ERROR("DBServer failed to parse routed message");
         return;
     }
@@ -167,15 +208,9 @@ void DbServer::HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& s
 
     bool handled = handler_registry_.Dispatch(
         context, routed.msg_id, routed.payload,
-        [session](const legend2::handlers::ResponseList& responses) {
-            if (!session) {
-                return;
-            }
-            for (const auto& response : responses) {
-                const auto routed_rsp = common::BuildRoutedMessage(
-                    response.client_id, response.msg_id, response.payload);
-                session->Send(static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage), routed_rsp);
-            }
+        [session, framed](const legend2::handlers::ResponseList& responses) {
+            // 按请求方使用的格式回包，兼容仍发送 FlatBuffers RoutedMessage 的网关
+            legend2::handlers::SendRoutedResponses(session, responses, framed);
         });
 
     if (!handled) {
@@ -7,6 +7,7 @@
 #define MIR2_DB_DB_SERVER_H
 
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -39,7 +40,7 @@ class DbServer {
   void RegisterHandlers();
   void RegisterMessageHandlers();
   void HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& session,
-                          const std::vector<uint8_t>& payload);
+                           std::span<const uint8_t> payload, bool framed);
 
   core::Application app_;
   std::unique_ptr<network::NetworkManager> network_;
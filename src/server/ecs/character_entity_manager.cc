@@ -5,6 +5,7 @@
 
 #include "ecs/character_entity_manager.h"
 
+#include "core/timer.h"
 #include "ecs/components/character_components.h"
 #include "ecs/dirty_tracker.h"
 #include "ecs/event_bus.h"
@@ -13,6 +14,7 @@
 #include "ecs/systems/movement_system.h"
 #include "legacy/character_factory.h"
 #include "log/logger.h"
+#include "monitor/metrics.h"
 
 #include <cassert>
 #include <chrono>
@@ -261,7 +263,7 @@ bool CharacterEntityManager::SetPosition(uint32_t character_id,
 
   auto current_map = TryGetMapId(character_id);
   if (current_map && *current_map != map_id) {
-    return MoveToMap(character_id, map_id, x, y);
+    return MoveToMap(character_id, map_id, x, y) != MoveResult::kFailed;
   }
 
   entt::entity entity = GetOrCreate(character_id, map_id);
@@ -280,17 +282,25 @@ bool CharacterEntityManager::SetPosition(uint32_t character_id,
   return true;
 }
 
-bool CharacterEntityManager::MoveToMap(uint32_t character_id, uint32_t new_map_id) {
+CharacterEntityManager::MoveResult CharacterEntityManager::MoveToMap(uint32_t character_id,
+                                                                  uint32_t new_map_id) {
+  if (registry_manager_ && RegistryManager::InParallelPhase()) {
+    // 目标 World 可能正在其他线程更新，迁移推迟到合并阶段
+    registry_manager_->DeferCrossMap([this, character_id, new_map_id]() {
+      MoveToMap(character_id, new_map_id);
+    });
+    return MoveResult::kDeferred;
+  }
   AssertSameThread();
   auto entity = TryGet(character_id);
   if (!entity) {
-    return false;
+    return MoveResult::kFailed;
   }
 
   auto map_id = TryGetMapId(character_id);
   entt::registry* registry = map_id ? ResolveRegistry(*map_id) : nullptr;
   if (!registry) {
-    return false;
+    return MoveResult::kFailed;
   }
 
   const auto* state = registry->try_get<CharacterStateComponent>(*entity);
@@ -299,10 +309,16 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id, uint32_t new_map_i
   return MoveToMap(character_id, new_map_id, x, y);
 }
 
-bool CharacterEntityManager::MoveToMap(uint32_t character_id,
-                                       uint32_t new_map_id,
-                                       int x,
-                                       int y) {
+CharacterEntityManager::MoveResult CharacterEntityManager::MoveToMap(uint32_t character_id,
+                                                                  uint32_t new_map_id,
+                                                                  int x,
+                                                                  int y) {
+  if (registry_manager_ && RegistryManager::InParallelPhase()) {
+    registry_manager_->DeferCrossMap([this, character_id, new_map_id, x, y]() {
+      MoveToMap(character_id, new_map_id, x, y);
+    });
+    return MoveResult::kDeferred;
+  }
   AssertSameThread();
   if (new_map_id == 0) {
     new_map_id = 1;
@@ -310,7 +326,8 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id,
 
   auto current_map = TryGetMapId(character_id);
   if (current_map && *current_map == new_map_id) {
-    return SetPosition(character_id, x, y, new_map_id);
+    return SetPosition(character_id, x, y, new_map_id) ? MoveResult::kMoved
+                                                       : MoveResult::kFailed;
   }
 
   entt::entity entity = entt::null;
@@ -329,7 +346,7 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id,
   if (!target_registry) {
     SYSLOG_ERROR("MoveToMap: missing target registry id={} map_id={}",
                  character_id, new_map_id);
-    return false;
+    return MoveResult::kFailed;
   }
 
   if (source_registry && source_registry == target_registry) {
@@ -337,13 +354,13 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id,
       entity = GetOrCreate(character_id, new_map_id);
     }
     if (entity == entt::null || !source_registry->valid(entity)) {
-      return false;
+      return MoveResult::kFailed;
     }
     MovementSystem::SetPosition(*source_registry, entity, x, y);
     MovementSystem::SetMapId(*source_registry, entity, new_map_id);
     character_to_map_[character_id] = new_map_id;
     Touch(character_id);
-    return true;
+    return MoveResult::kMoved;
   }
 
   mir2::common::CharacterData data;
@@ -355,12 +372,12 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id,
     if (stored_it == stored_characters_.end()) {
       entity = GetOrCreate(character_id, new_map_id);
       if (entity == entt::null) {
-        return false;
+        return MoveResult::kFailed;
       }
       MovementSystem::SetPosition(*target_registry, entity, x, y);
       MovementSystem::SetMapId(*target_registry, entity, new_map_id);
       Touch(character_id);
-      return true;
+      return MoveResult::kMoved;
     }
     data = stored_it->second;
   }
@@ -377,19 +394,19 @@ bool CharacterEntityManager::MoveToMap(uint32_t character_id,
   if (new_entity == entt::null || !target_registry->valid(new_entity)) {
     SYSLOG_ERROR("MoveToMap: failed to load entity id={} map_id={}",
                  character_id, new_map_id);
-    return false;
+    return MoveResult::kFailed;
   }
 
   if (!IndexCharacter(character_id, new_map_id, new_entity)) {
     SYSLOG_ERROR("MoveToMap: index failed id={} map_id={}", character_id, new_map_id);
     target_registry->destroy(new_entity);
-    return false;
+    return MoveResult::kFailed;
   }
 
   stored_characters_[character_id] = data;
   sessions_.try_emplace(character_id);
   Touch(character_id);
-  return true;
+  return MoveResult::kMoved;
 }
 
 void CharacterEntityManager::OnLogin(uint32_t character_id, EventBus* event_bus) {
@@ -445,6 +462,18 @@ void CharacterEntityManager::OnDisconnect(uint32_t character_id, EventBus* event
 void CharacterEntityManager::Update(float delta_time) {
   AssertSameThread();
   std::vector<uint32_t> expired_ids;
+  std::size_t saves = 0;
+  std::size_t deferred_saves = 0;
+  auto try_reserve_save = [&]() {
+    const bool over_limit = auto_save_limit_ > 0 && saves >= auto_save_limit_;
+    const bool over_budget = saves > 0 && tick_budget_ && tick_budget_->Exhausted();
+    if (over_limit || over_budget) {
+      ++deferred_saves;
+      return false;
+    }
+    ++saves;
+    return true;
+  };
   for (auto& [character_id, session] : sessions_) {
     auto entity = TryGet(character_id);
     if (!entity) {
@@ -460,7 +489,7 @@ void CharacterEntityManager::Update(float delta_time) {
 
     if (session.connected) {
       session.time_since_last_save += delta_time;
-      if (session.time_since_last_save >= save_interval_seconds_) {
+      if (session.time_since_last_save >= save_interval_seconds_ && try_reserve_save()) {
         SaveIfDirty(character_id);
         session.time_since_last_save = 0.0f;
       }
@@ -468,7 +497,7 @@ void CharacterEntityManager::Update(float delta_time) {
     }
 
     session.time_since_disconnect += delta_time;
-    if (session.time_since_disconnect < timeout_seconds_) {
+    if (session.time_since_disconnect < timeout_seconds_ || !try_reserve_save()) {
       continue;
     }
 
@@ -486,6 +515,9 @@ void CharacterEntityManager::Update(float delta_time) {
   for (uint32_t character_id : expired_ids) {
     sessions_.erase(character_id);
   }
+  if (deferred_saves > 0) {
+    monitor::Metrics::Instance().AddCounter("ecs.autosave.deferred", deferred_saves);
+  }
 }
 
 std::optional<mir2::common::CharacterData> CharacterEntityManager::Save(uint32_t character_id) {
@@ -10,11 +10,16 @@
 
 #include <entt/entt.hpp>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <thread>
 #include <unordered_map>
 
+namespace mir2::core {
+class TickBudget;
+}  // namespace mir2::core
+
 namespace mir2::ecs {
 
 class EventBus;
@@ -43,6 +48,13 @@ class CharacterEntityManager {
     kClearDirtyFlag,
   };
 
+  /// 跨地图移动结果
+  enum class MoveResult {
+    kFailed,
+    kMoved,     ///< 已完成迁移，随后即可读取新地图状态
+    kDeferred,  ///< 并行更新阶段内调用：迁移推迟到合并阶段，此刻角色仍在原地图
+  };
+
   /// 旧接口：绑定单 Registry（兼容已有测试与单 World 使用）
   explicit CharacterEntityManager(entt::registry& registry);
 
@@ -74,11 +86,13 @@ class CharacterEntityManager {
   const entt::registry* TryGetRegistry(uint32_t character_id) const;
 
   /// 设置角色位置（并更新地图）
+  /// @note 跨地图且处于并行更新阶段时迁移被推迟，返回 true 仅表示已受理；
+  ///       需要区分时直接调用 MoveToMap
   bool SetPosition(uint32_t character_id, int x, int y, uint32_t map_id);
 
   /// 跨地图移动角色（会转移 Registry）
-  bool MoveToMap(uint32_t character_id, uint32_t new_map_id);
-  bool MoveToMap(uint32_t character_id, uint32_t new_map_id, int x, int y);
+  MoveResult MoveToMap(uint32_t character_id, uint32_t new_map_id);
+  MoveResult MoveToMap(uint32_t character_id, uint32_t new_map_id, int x, int y);
 
   /// 登录时标记角色在线
   void OnLogin(uint32_t character_id, EventBus* event_bus = nullptr);
@@ -111,6 +125,16 @@ class CharacterEntityManager {
   void SetTimeoutSeconds(float seconds) { timeout_seconds_ = seconds; }
   void SetErrorPolicy(ErrorPolicy policy) { error_policy_ = policy; }
 
+  /**
+   * @brief 限制 Update 中的存档量：每 Tick 最多 saves_per_tick 次（0 表示不限），
+   *        且 tick_budget 耗尽后不再存档；到期未存的角色留到下一 Tick。
+   *        每 Tick 至少存档一次，持续超载时存档也能推进。
+   */
+  void SetAutoSaveLimit(std::size_t saves_per_tick, const core::TickBudget* tick_budget = nullptr) {
+    auto_save_limit_ = saves_per_tick;
+    tick_budget_ = tick_budget;
+  }
+
  private:
   struct SessionState {
     bool connected = false;
@@ -150,6 +174,8 @@ class CharacterEntityManager {
   float save_interval_seconds_ = 30.0f;
   float timeout_seconds_ = 60.0f;
   ErrorPolicy error_policy_ = ErrorPolicy::kRetainDirtyFlag;
+  std::size_t auto_save_limit_ = 0;
+  const core::TickBudget* tick_budget_ = nullptr;
 };
 
 }  // namespace mir2::ecs
@@ -1,11 +1,33 @@
 #include "ecs/registry_manager.h"
 
+#include <algorithm>
+
 #include "config/config_manager.h"
 #include "game/event/timed_event_scheduler.h"
 #include "log/logger.h"
+#include "monitor/metrics.h"
 
 namespace mir2::ecs {
 
+namespace {
+
+// 正在并行更新的 World 的推迟操作队列；不在并行阶段时为空
+thread_local std::vector<std::function<void()>>* tls_deferred = nullptr;
+
+/**
+ * @brief 在作用域内把当前线程的推迟操作指向某个 World 的队列
+ */
+class DeferredScope {
+ public:
+  explicit DeferredScope(std::vector<std::function<void()>>* queue) { tls_deferred = queue; }
+  ~DeferredScope() { tls_deferred = nullptr; }
+
+  DeferredScope(const DeferredScope&) = delete;
+  DeferredScope& operator=(const DeferredScope&) = delete;
+};
+
+}  // namespace
+
 RegistryManager::RegistryManager()
     : character_manager_(*this) {}
 
@@ -36,13 +58,24 @@ World* RegistryManager::CreateWorld(uint32_t map_id, std::size_t reserve_capacit
 
   auto world = std::make_unique<World>(reserve_capacity);
   World* ptr = world.get();
+  ptr->SetJobPool(worker_pool_ ? nullptr : system_pool_.get());
+  ptr->SetTickBudget(tick_budget_);
+  ptr->SetTimeSlice(time_slice_entities_);
   worlds_.emplace(map_id, std::move(world));
+  ordered_worlds_.emplace(
+      std::lower_bound(ordered_worlds_.begin(), ordered_worlds_.end(), std::make_pair(map_id, ptr)),
+      map_id, ptr);
   SYSLOG_INFO("RegistryManager: World created map_id={} reserve_capacity={}", map_id,
               reserve_capacity);
   return ptr;
 }
 
 void RegistryManager::UpdateAll(float delta_time) {
+  if (worker_pool_) {
+    UpdateParallel(delta_time);
+    legend2::game::event::TimedEventScheduler::Instance().Update(delta_time);
+    return;
+  }
   for (auto& [map_id, world] : worlds_) {
     if (!world) {
       SYSLOG_WARN("RegistryManager: null World for map_id={}", map_id);
@@ -53,6 +86,84 @@ void RegistryManager::UpdateAll(float delta_time) {
   legend2::game::event::TimedEventScheduler::Instance().Update(delta_time);
 }
 
+void RegistryManager::UpdateParallel(float delta_time) {
+  deferred_.resize(ordered_worlds_.size());
+  worker_pool_->Run(ordered_worlds_.size(), [this, delta_time](std::size_t index) {
+    DeferredScope scope(&deferred_[index]);
+    ordered_worlds_[index].second->Update(delta_time);
+  });
+
+  // 合并阶段：所有 World 已停止更新，按 map_id 顺序串行执行跨地图操作
+  std::size_t deferred_count = 0;
+  for (auto& ops : deferred_) {
+    deferred_count += ops.size();
+    for (auto& op : ops) {
+      op();
+    }
+    ops.clear();
+  }
+  if (deferred_count > 0) {
+    monitor::Metrics::Instance().AddCounter("ecs.update.deferred_cross_map", deferred_count);
+  }
+}
+
+void RegistryManager::SetParallelUpdate(std::size_t worker_threads) {
+  worker_pool_.reset();
+  if (worker_threads > 0) {
+    worker_pool_ = std::make_unique<WorkerPool>(worker_threads);
+  }
+  SYSLOG_INFO("RegistryManager: parallel world update {} (worker_threads={})",
+              worker_pool_ ? "enabled" : "disabled", worker_threads);
+  ApplySystemJobPool();
+}
+
+void RegistryManager::SetParallelSystems(std::size_t worker_threads) {
+  system_pool_.reset();
+  if (worker_threads > 0) {
+    system_pool_ = std::make_unique<WorkerPool>(worker_threads);
+  }
+  SYSLOG_INFO("RegistryManager: parallel systems {} (worker_threads={})",
+              system_pool_ ? "enabled" : "disabled", worker_threads);
+  ApplySystemJobPool();
+}
+
+void RegistryManager::SetTickBudget(const core::TickBudget* tick_budget,
+                                    std::size_t time_slice_entities) {
+  tick_budget_ = tick_budget;
+  time_slice_entities_ = time_slice_entities;
+  for (auto& [map_id, world] : worlds_) {
+    if (world) {
+      world->SetTickBudget(tick_budget_);
+      world->SetTimeSlice(time_slice_entities_);
+    }
+  }
+}
+
+void RegistryManager::ApplySystemJobPool() {
+  if (worker_pool_ && system_pool_) {
+    // 各 World 已在不同线程上并发更新，共享任务池不可重入
+    SYSLOG_WARN("RegistryManager: parallel systems ignored while parallel world update is enabled");
+  }
+  WorkerPool* job_pool = worker_pool_ ? nullptr : system_pool_.get();
+  for (auto& [map_id, world] : worlds_) {
+    if (world) {
+      world->SetJobPool(job_pool);
+    }
+  }
+}
+
+void RegistryManager::DeferCrossMap(std::function<void()> fn) {
+  if (tls_deferred) {
+    tls_deferred->push_back(std::move(fn));
+    return;
+  }
+  fn();
+}
+
+bool RegistryManager::InParallelPhase() {
+  return tls_deferred != nullptr;
+}
+
 CharacterEntityManager& RegistryManager::GetCharacterManager() {
   return character_manager_;
 }
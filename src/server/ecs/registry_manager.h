@@ -8,11 +8,15 @@
 
 #include "ecs/character_entity_manager.h"
 #include "ecs/world.h"
+#include "ecs/worker_pool.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mir2::ecs {
 
@@ -21,6 +25,8 @@ namespace mir2::ecs {
  *
  * @warning 非线程安全！所有方法必须在同一线程调用。
  * @note 单例模式，管理所有 World 与跨地图角色管理。
+ * @note 开启并行更新后，UpdateAll 在工作线程上同时执行互不相干的 World::Update；
+ *       World 内的跨地图操作须经 DeferCrossMap 推迟到本 Tick 末尾的串行合并阶段。
  * @see src/server/ecs/THREADING.md 了解线程模型详情
  */
 class RegistryManager {
@@ -37,6 +43,25 @@ class RegistryManager {
   /// 更新所有 World（每帧调用）
   void UpdateAll(float delta_time);
 
+  /// 并行更新：worker_threads > 0 时各 World::Update 分发到工作线程（调用线程也参与），
+  /// 0 为串行更新（默认）。不得在 UpdateAll 期间调用。
+  void SetParallelUpdate(std::size_t worker_threads);
+  bool IsParallelUpdate() const { return worker_pool_ != nullptr; }
+
+  /// 地图内 System 并行：worker_threads > 0 时各 World 按访问集把互不冲突的 System
+  /// 放到共享任务池并行执行。与 SetParallelUpdate 互斥，按地图并行开启时此设置不生效。
+  void SetParallelSystems(std::size_t worker_threads);
+
+  /// Tick 预算与时间片：应用到现有及之后创建的 World（tick_budget 由调用方持有，nullptr 表示不限）
+  void SetTickBudget(const core::TickBudget* tick_budget, std::size_t time_slice_entities);
+
+  /// 跨地图操作（跨 World 迁移、访问其他地图或全局状态）：
+  /// 在并行更新阶段内调用时推迟到合并阶段，按 map_id 升序、各地图内按提交顺序执行；否则立即执行
+  void DeferCrossMap(std::function<void()> fn);
+
+  /// 当前线程是否正在并行更新某个 World
+  static bool InParallelPhase();
+
   /// 遍历所有 World（用于跨 World 操作）
   template<typename Func>
   void ForEachWorld(Func&& func) {
@@ -64,9 +89,21 @@ class RegistryManager {
   RegistryManager(RegistryManager&&) = delete;
   RegistryManager& operator=(RegistryManager&&) = delete;
 
+  void UpdateParallel(float delta_time);
+  void ApplySystemJobPool();
+
   /// map_id -> World
   std::unordered_map<uint32_t, std::unique_ptr<World>> worlds_;
 
+  /// 并行更新用：按 map_id 升序的 World 列表（CreateWorld 时重建）及各自的推迟操作
+  std::vector<std::pair<uint32_t, World*>> ordered_worlds_;
+  std::vector<std::vector<std::function<void()>>> deferred_;
+  std::unique_ptr<WorkerPool> worker_pool_;
+  /// 地图内 System 并行共享的任务池（同一时刻只有一个 World 在更新）
+  std::unique_ptr<WorkerPool> system_pool_;
+  const core::TickBudget* tick_budget_ = nullptr;
+  std::size_t time_slice_entities_ = 0;
+
   /// 跨 World 角色管理器（全局唯一）
   CharacterEntityManager character_manager_;
 };
@@ -155,7 +155,10 @@ bool has_ring_with_shape(const entt::registry& registry, entt::entity entity, in
 
 CombatSystem::CombatSystem()
     : System(SystemPriority::kCombat),
-      combat_group_{} {}
+      combat_group_{} {
+    // owning group 会在成员组件增删时重排 CombatComponent 池，三者都按写入声明
+    Writes<CombatComponent, CharacterAttributesComponent, CharacterStateComponent>();
+}
 
 void CombatSystem::Update(entt::registry& registry, float delta_time) {
     if (!combat_group_) {
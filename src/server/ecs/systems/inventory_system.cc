@@ -34,7 +34,9 @@ std::optional<mir2::common::EquipSlot> resolve_equip_slot(const ItemComponent& i
 }  // namespace
 
 InventorySystem::InventorySystem()
-    : System(SystemPriority::kInventory) {}
+    : System(SystemPriority::kInventory) {
+    Reads<InventoryOwnerComponent, ItemComponent>();
+}
 
 void InventorySystem::Update(entt::registry& /*registry*/, float /*delta_time*/) {
     // TODO: 根据后续需求增加自动整理或过期物品处理逻辑。
@@ -8,13 +8,17 @@
 namespace mir2::ecs {
 
 LevelUpSystem::LevelUpSystem()
-    : System(SystemPriority::kLevelUp) {}
+    : System(SystemPriority::kLevelUp) {
+    Reads<CharacterIdentityComponent>();
+    Writes<CharacterAttributesComponent, DirtyComponent>();
+    MarkDeferrable();
+}
 
 void LevelUpSystem::Update(entt::registry& registry, float /*delta_time*/) {
-    auto view = registry.view<CharacterIdentityComponent, CharacterAttributesComponent>();
-    for (auto entity : view) {
+    // 升级检查可延后：每 Tick 只检查一个时间片，其余角色下一 Tick 继续
+    ForEachInSlice<CharacterAttributesComponent>(registry, [&registry](entt::entity entity) {
         CheckLevelUp(registry, entity);
-    }
+    });
 }
 
 void LevelUpSystem::ApplyLevelUpStats(mir2::common::CharacterClass char_class,
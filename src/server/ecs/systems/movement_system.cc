@@ -5,7 +5,9 @@
 namespace mir2::ecs {
 
 MovementSystem::MovementSystem()
-    : System(SystemPriority::kMovement) {}
+    : System(SystemPriority::kMovement) {
+    Reads<CharacterStateComponent>();
+}
 
 void MovementSystem::Update(entt::registry& /*registry*/, float /*delta_time*/) {
     // TODO: 处理移动插值或移动速度计算
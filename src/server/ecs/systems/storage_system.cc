@@ -55,10 +55,15 @@ void cleanup_storage(entt::registry& registry, StorageComponent& storage) {
 }  // namespace
 
 StorageSystem::StorageSystem()
-    : System(SystemPriority::kInventory) {}
+    : System(SystemPriority::kInventory) {
+    Reads<StorageComponent>();
+    MarkDeferrable();
+}
 
 StorageSystem::StorageSystem(entt::registry& registry, EventBus& event_bus)
     : System(SystemPriority::kInventory) {
+    Reads<StorageComponent>();
+    MarkDeferrable();
     RegisterHandlers(registry, event_bus);
 }
 
@@ -11,6 +11,7 @@
 #include "game/map/teleport_command.h"
 
 #include <entt/entt.hpp>
+#include <functional>
 #include <queue>
 
 namespace mir2::ecs {
@@ -21,10 +22,18 @@ class EventBus;
  * @brief 传送系统
  *
  * 处理实体跨地图传送，集成 SceneManager 和 ECS。
+ * 修改 SceneManager 与其他地图，不声明组件访问集，调度时独占执行。
  */
 class TeleportSystem : public System {
  public:
-  TeleportSystem(game::map::SceneManager& scene_manager, EventBus& event_bus);
+  /// 跨地图操作的执行入口：接收一次传送并决定立即执行或推迟（如 RegistryManager::DeferCrossMap）
+  using CrossMapSink = std::function<void(std::function<void()>)>;
+
+  /**
+   * @param defer_cross_map 传送的执行入口；为空时在 Update 内直接执行
+   */
+  TeleportSystem(game::map::SceneManager& scene_manager, EventBus& event_bus,
+                 CrossMapSink defer_cross_map = {});
 
   /**
    * @brief 请求传送
@@ -39,8 +48,14 @@ class TeleportSystem : public System {
   void Update(entt::registry& registry, float delta_time) override;
 
  private:
+  /**
+   * @brief 执行一条传送（修改 SceneManager 的跨地图索引，并行更新时在合并阶段执行）
+   */
+  void Apply(entt::registry& registry, const game::map::TeleportCommand& cmd);
+
   game::map::SceneManager& scene_manager_;
   EventBus* event_bus_ = nullptr;
+  CrossMapSink defer_cross_map_;
   std::queue<game::map::TeleportCommand> teleport_queue_;
 };
 
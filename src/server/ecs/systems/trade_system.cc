@@ -116,7 +116,9 @@ void append_freed_slots(std::vector<int>& free_slots,
 }  // namespace
 
 TradeSystem::TradeSystem()
-    : System(SystemPriority::kInventory) {}
+    : System(SystemPriority::kInventory) {
+    Reads<TradeComponent>();
+}
 
 void TradeSystem::Update(entt::registry& /*registry*/, float /*delta_time*/) {
     // TODO: 后续可以加入超时/断线自动取消交易逻辑。
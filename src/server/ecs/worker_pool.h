@@ -0,0 +1,61 @@
+/**
+ * @file worker_pool.h
+ * @brief 固定大小的分叉-汇合工作线程池
+ */
+
+#ifndef LEGEND2_SERVER_ECS_WORKER_POOL_H
+#define LEGEND2_SERVER_ECS_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mir2::ecs {
+
+/**
+ * @brief 工作线程池
+ *
+ * Run 把一批下标任务分给工作线程与调用线程共同执行，全部完成后才返回；
+ * 任务按原子计数领取，先做完的线程继续领取下一个。任务抛出的第一个异常
+ * 在 Run 返回前于调用线程重新抛出。Run 不可重入，也不可并发调用。
+ */
+class WorkerPool {
+ public:
+  /// @param thread_count 额外的工作线程数（调用线程之外）
+  explicit WorkerPool(std::size_t thread_count);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// 执行 task(i)，i ∈ [0, task_count)
+  void Run(std::size_t task_count, const std::function<void(std::size_t)>& task);
+
+  std::size_t ThreadCount() const { return threads_.size(); }
+
+ private:
+  void WorkerLoop();
+  void RunTasks();
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  uint64_t generation_ = 0;
+  bool stopping_ = false;
+  std::size_t active_workers_ = 0;
+  const std::function<void(std::size_t)>* task_ = nullptr;
+  std::size_t task_count_ = 0;
+  std::atomic<std::size_t> next_task_{0};
+  std::exception_ptr error_;
+};
+
+}  // namespace mir2::ecs
+
+#endif  // LEGEND2_SERVER_ECS_WORKER_POOL_H
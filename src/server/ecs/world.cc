@@ -4,13 +4,58 @@
 #include "ecs/components/combat_component.h"
 #include "ecs/event_bus.h"
 #include "ecs/systems/npc_ai_system.h"
+#include "core/timer.h"
 #include "ecs/systems/storage_system.h"
+#include "ecs/worker_pool.h"
 #include "log/logger.h"
+#include "monitor/metrics.h"
 
 #include <algorithm>
+#include <cassert>
+#include <typeinfo>
+#include <unordered_map>
 
 namespace mir2::ecs {
 
+namespace {
+
+bool Intersects(const std::vector<entt::id_type>& lhs, const std::vector<entt::id_type>& rhs) {
+    for (entt::id_type id : lhs) {
+        if (std::find(rhs.begin(), rhs.end(), id) != rhs.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifndef NDEBUG
+/// 各组件池的实体数（调试构建用于发现未声明的结构性变化，即组件的添加/移除）
+std::unordered_map<entt::id_type, std::size_t> SnapshotStorageSizes(entt::registry& registry) {
+    std::unordered_map<entt::id_type, std::size_t> sizes;
+    for (auto [id, storage] : registry.storage()) {
+        sizes.emplace(id, storage.size());
+    }
+    return sizes;
+}
+#endif
+
+}  // namespace
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+    if (exclusive || other.exclusive) {
+        return true;
+    }
+    if (publishes_events && other.publishes_events) {
+        return true;
+    }
+    return Intersects(writes, other.writes) || Intersects(writes, other.reads) ||
+           Intersects(reads, other.writes);
+}
+
+bool SystemAccess::IsWritten(entt::id_type component) const {
+    return std::find(writes.begin(), writes.end(), component) != writes.end();
+}
+
 World::World(std::size_t reserve_capacity)
     : event_bus_(std::make_unique<EventBus>(registry_)) {
     npc_ai_system_ = std::make_unique<game::npc::NpcAISystem>(registry_, *event_bus_);
@@ -40,17 +85,131 @@ const game::npc::NpcAISystem* World::GetNpcAISystem() const {
 
 void World::ClearSystems() {
     systems_.clear();
+    stages_.clear();
     systems_dirty_ = false;
 }
 
+const std::vector<std::vector<System*>>& World::GetStages() {
+    if (systems_dirty_) {
+        RebuildSchedule();
+    }
+    return stages_;
+}
+
+void World::RebuildSchedule() {
+    // 稳定排序：同优先级保持注册顺序
+    std::stable_sort(systems_.begin(), systems_.end(),
+                     [](const std::unique_ptr<System>& lhs, const std::unique_ptr<System>& rhs) {
+                         return static_cast<int>(lhs->Priority()) <
+                                static_cast<int>(rhs->Priority());
+                     });
+
+    // 依赖图分层：系统依赖于所有优先级更高（更早）且访问冲突的系统，
+    // 其阶段 = 这些前驱的最大阶段 + 1；同一阶段内的系统两两不冲突
+    stages_.clear();
+    std::vector<std::size_t> stage_of(systems_.size(), 0);
+    for (std::size_t i = 0; i < systems_.size(); ++i) {
+        std::size_t stage = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (systems_[i]->Access().ConflictsWith(systems_[j]->Access())) {
+                stage = std::max(stage, stage_of[j] + 1);
+            }
+        }
+        stage_of[i] = stage;
+        if (stages_.size() <= stage) {
+            stages_.resize(stage + 1);
+        }
+        stages_[stage].push_back(systems_[i].get());
+        if (systems_[i]->IsDeferrable()) {
+            systems_[i]->SetTimeSlice(time_slice_);
+        }
+
+        for (auto assure : systems_[i]->Access().assure_storage) {
+            assure(registry_);
+        }
+    }
+    systems_dirty_ = false;
+}
+
+void World::SetTimeSlice(std::size_t entities_per_tick) {
+    time_slice_ = entities_per_tick;
+    for (const auto& system : systems_) {
+        if (system->IsDeferrable()) {
+            system->SetTimeSlice(time_slice_);
+        }
+    }
+}
+
+bool World::ShouldDefer(System* system, float delta_time) {
+    if (!system->IsDeferrable() || !tick_budget_ || !tick_budget_->Exhausted()) {
+        return false;
+    }
+    // 持续超载时也要保证可延后系统最终得到执行
+    if (system->deferred_ticks_ >= kMaxDeferredTicks) {
+        return false;
+    }
+    ++system->deferred_ticks_;
+    system->pending_delta_ += delta_time;
+    ++deferred_this_tick_;
+    return true;
+}
+
+void World::RunSystem(System* system, float delta_time) {
+    const float total_delta = delta_time + system->pending_delta_;
+    system->pending_delta_ = 0.0f;
+    system->deferred_ticks_ = 0;
+    system->Update(registry_, total_delta);
+}
+
+void World::RunStage(const std::vector<System*>& stage, float delta_time) {
+    runnable_.clear();
+    for (System* system : stage) {
+        if (!ShouldDefer(system, delta_time)) {
+            runnable_.push_back(system);
+        }
+    }
+    if (runnable_.size() < 2) {
+        for (System* system : runnable_) {
+            RunSystem(system, delta_time);
+        }
+        return;
+    }
+
+#ifndef NDEBUG
+    const auto before = SnapshotStorageSizes(registry_);
+#endif
+
+    job_pool_->Run(runnable_.size(), [this, delta_time](std::size_t index) {
+        RunSystem(runnable_[index], delta_time);
+    });
+
+#ifndef NDEBUG
+    // 只检测结构性变化：组件池大小改变时，该组件必须由本阶段某个系统声明为写入。
+    // 原地修改组件值、读取未声明的组件、同一阶段内增删相抵都无法由此发现
+    for (const auto& [id, size] : SnapshotStorageSizes(registry_)) {
+        const auto it = before.find(id);
+        if ((it != before.end() ? it->second : 0) == size) {
+            continue;
+        }
+        const bool declared = std::any_of(runnable_.begin(), runnable_.end(), [id = id](System* system) {
+            return system->Access().IsWritten(id);
+        });
+        if (!declared) {
+            for (const System* system : runnable_) {
+                const System& ref = *system;
+                SYSLOG_ERROR("World: undeclared structural change to component id={} "
+                             "in parallel stage with {}",
+                             id, typeid(ref).name());
+            }
+            assert(false && "World: 并行阶段存在未声明的组件增删");
+        }
+    }
+#endif
+}
+
 void World::Update(float delta_time) {
     if (systems_dirty_) {
-        std::sort(systems_.begin(), systems_.end(),
-                  [](const std::unique_ptr<System>& lhs, const std::unique_ptr<System>& rhs) {
-                      return static_cast<int>(lhs->Priority()) <
-                             static_cast<int>(rhs->Priority());
-                  });
-        systems_dirty_ = false;
+        RebuildSchedule();
     }
 
     if (npc_ai_system_) {
@@ -58,8 +217,20 @@ void World::Update(float delta_time) {
         npc_ai_system_->Update(registry_, delta_time);
     }
 
-    for (const auto& system : systems_) {
-        system->Update(registry_, delta_time);
+    deferred_this_tick_ = 0;
+    if (!job_pool_) {
+        for (const auto& system : systems_) {
+            if (!ShouldDefer(system.get(), delta_time)) {
+                RunSystem(system.get(), delta_time);
+            }
+        }
+    } else {
+        for (const auto& stage : stages_) {
+            RunStage(stage, delta_time);
+        }
+    }
+    if (deferred_this_tick_ > 0) {
+        monitor::Metrics::Instance().AddCounter("ecs.tick.deferred_systems", deferred_this_tick_);
     }
 
     event_bus_->FlushEvents();
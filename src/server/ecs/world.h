@@ -10,8 +10,13 @@
 
 #include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
+namespace mir2::core {
+class TickBudget;
+}  // namespace mir2::core
+
 namespace mir2::game::npc {
 class NpcAISystem;
 }  // namespace mir2::game::npc
@@ -19,6 +24,7 @@ class NpcAISystem;
 namespace mir2::ecs {
 
 class EventBus;
+class WorkerPool;
 
 /**
  * @brief 系统优先级
@@ -30,6 +36,23 @@ enum class SystemPriority {
     kLevelUp = 300,
 };
 
+/**
+ * @brief 系统的组件访问集（World 调度器据此判断两个系统能否并行）
+ *
+ * 未声明任何访问的系统视为独占：与所有系统冲突，按优先级单独执行。
+ */
+struct SystemAccess {
+    std::vector<entt::id_type> reads;
+    std::vector<entt::id_type> writes;
+    /// 预先创建所声明组件的存储池，避免并行阶段惰性创建改动 registry
+    std::vector<void (*)(entt::registry&)> assure_storage;
+    bool publishes_events = false;  ///< 经 EventBus 发布事件（EventBus 非线程安全，发布者之间互斥）
+    bool exclusive = true;
+
+    bool ConflictsWith(const SystemAccess& other) const;
+    bool IsWritten(entt::id_type component) const;
+};
+
 /**
  * @brief ECS系统基类
  */
@@ -39,18 +62,97 @@ class System {
     virtual ~System() = default;
 
     SystemPriority Priority() const { return priority_; }
+    const SystemAccess& Access() const { return access_; }
 
     virtual void Update(entt::registry& registry, float delta_time) = 0;
 
+    /// 可延后系统：Tick 预算耗尽时由 World 推迟到下一 Tick（延迟敏感的系统保持默认 false）
+    bool IsDeferrable() const { return deferrable_; }
+
+    /**
+     * @brief 时间片大小：ForEachInSlice 每次最多处理的实体数（0 表示全部）
+     */
+    void SetTimeSlice(std::size_t entities_per_tick) { time_slice_ = entities_per_tick; }
+
+ protected:
+    /**
+     * @brief 标记为可延后（在派生类构造函数中调用）
+     */
+    void MarkDeferrable() { deferrable_ = true; }
+
+    /**
+     * @brief 按时间片遍历 Lead 组件池中的实体，游标跨 Tick 保留，下次从上次停下处继续
+     *
+     * 池在遍历期间被增删时顺序可能错位，个别实体会提前或推迟一轮处理。
+     */
+    template<typename Lead, typename Func>
+    void ForEachInSlice(entt::registry& registry, Func&& func) {
+        const entt::sparse_set& entities = registry.storage<Lead>();
+        const std::size_t size = entities.size();
+        const std::size_t count = (time_slice_ == 0 || time_slice_ > size) ? size : time_slice_;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (slice_cursor_ >= entities.size()) {
+                slice_cursor_ = 0;
+                if (entities.empty()) {
+                    return;
+                }
+            }
+            func(entities[slice_cursor_++]);
+        }
+    }
+
+    /**
+     * @brief 声明 Update 中只读的组件（在派生类构造函数中调用）
+     *
+     * 只读约束不做运行时检查；调试构建只能发现并行阶段中未声明的组件增删。
+     */
+    template<typename... Components>
+    void Reads() {
+        (Declare<Components>(&access_.reads), ...);
+        access_.exclusive = false;
+    }
+
+    /**
+     * @brief 声明 Update 中修改、添加或移除的组件
+     */
+    template<typename... Components>
+    void Writes() {
+        (Declare<Components>(&access_.writes), ...);
+        access_.exclusive = false;
+    }
+
+    /**
+     * @brief 声明 Update 中会发布事件
+     */
+    void PublishesEvents() { access_.publishes_events = true; }
+
  private:
+    template<typename Component>
+    void Declare(std::vector<entt::id_type>* set) {
+        static_assert(!std::is_same_v<Component, entt::entity>,
+                      "创建/销毁实体的系统不应声明访问集（保持独占执行）");
+        set->push_back(entt::type_hash<Component>::value());
+        access_.assure_storage.push_back(
+            [](entt::registry& registry) { static_cast<void>(registry.storage<Component>()); });
+    }
+
+    friend class World;
+
     SystemPriority priority_;
+    SystemAccess access_;
+    bool deferrable_ = false;
+    std::size_t time_slice_ = 0;
+    std::size_t slice_cursor_ = 0;
+    float pending_delta_ = 0.0f;        ///< 被推迟的 Tick 累计的 delta_time，下次执行时补上
+    std::size_t deferred_ticks_ = 0;    ///< 连续被推迟的 Tick 数
 };
 
 /**
  * @brief ECS世界
  *
  * @warning 非线程安全！Update() 必须在单线程调用。
- * @note 所有 System 按优先级顺序执行，不并行。
+ * @note System 按优先级顺序执行；设置任务池后，访问集互不冲突的 System
+ *       在同一阶段并行执行，冲突的 System 仍按优先级先后执行。
  * @see src/server/ecs/THREADING.md 了解线程模型详情
  */
 class World {
@@ -106,12 +208,47 @@ class World {
     /// 获取已注册系统数量（测试用）
     size_t GetSystemCount() const { return systems_.size(); }
 
+    /**
+     * @brief 设置 System 并行执行的任务池（nullptr 表示串行，World 不持有）
+     */
+    void SetJobPool(WorkerPool* job_pool) { job_pool_ = job_pool; }
+
+    /**
+     * @brief 设置 Tick 预算（nullptr 表示不限，World 不持有）
+     *
+     * 预算耗尽后可延后的 System 推迟到下一 Tick，但连续推迟不超过 kMaxDeferredTicks。
+     */
+    void SetTickBudget(const core::TickBudget* tick_budget) { tick_budget_ = tick_budget; }
+
+    /**
+     * @brief 可延后 System 的时间片大小（每 Tick 实体数，0 表示全部）
+     */
+    void SetTimeSlice(std::size_t entities_per_tick);
+
+    static constexpr std::size_t kMaxDeferredTicks = 20;
+
+    /**
+     * @brief 调度阶段：同一阶段内的 System 访问集互不冲突（测试用）
+     */
+    const std::vector<std::vector<System*>>& GetStages();
+
  private:
+    void RebuildSchedule();
+    void RunStage(const std::vector<System*>& stage, float delta_time);
+    bool ShouldDefer(System* system, float delta_time);
+    void RunSystem(System* system, float delta_time);
+
     entt::registry registry_;
     std::unique_ptr<EventBus> event_bus_;
     std::unique_ptr<game::npc::NpcAISystem> npc_ai_system_;
     std::vector<std::unique_ptr<System>> systems_;
     bool systems_dirty_ = false;
+    std::vector<std::vector<System*>> stages_;
+    std::vector<System*> runnable_;  // 当前阶段未被推迟的 System（复用）
+    WorkerPool* job_pool_ = nullptr;
+    const core::TickBudget* tick_budget_ = nullptr;
+    std::size_t time_slice_ = 0;
+    std::size_t deferred_this_tick_ = 0;
 };
 
 }  // namespace mir2::ecs
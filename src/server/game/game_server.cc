@@ -1,9 +1,11 @@
 #include "game/game_server.h"
 
+#include <algorithm>
 #include <filesystem>
 
 #include "common/enums.h"
 #include "common/internal_message_helper.h"
+#include "common/routed_envelope.h"
 #include "config/config_manager.h"
 #include "config/map_config_loader.h"
 #include "handlers/chat/chat_handler.h"
@@ -12,6 +14,7 @@
 #include "handlers/item/item_handler.h"
 #include "handlers/movement/movement_handler.h"
 #include "handlers/movement/entity_broadcast_service.h"
+#include "handlers/routed_responses.h"
 #include "ecs/components/character_components.h"
 #include "ecs/systems/combat_system.h"
 #include "legacy/character.h"
@@ -23,6 +26,9 @@ namespace mir2::game {
 
 namespace {
 
+/// 超过该容量的命令负载在分发后释放，避免偶发大包让槽位长期占用内存
+constexpr std::size_t kMaxRetainedCommandPayload = 4096;
+
 class EcsCombatService final : public legend2::handlers::CombatService {
 public:
     EcsCombatService(mir2::ecs::CharacterEntityManager& character_manager,
@@ -273,10 +279,25 @@ bool GameServer::Initialize(const std::string& config_path) {
     monitor::Metrics::Instance().Init(server_config.metrics_port);
 
     network_ = std::make_unique<network::NetworkManager>(app_.GetIoContext());
-    if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
-        SYSLOG_ERROR("GameServer network start failed");
-        return false;
-    }
+    network_->SetIoContexts(app_.GetIoContexts());
+    network::SendPolicy send_policy;
+    send_policy.cork = server_config.send_cork;
+    send_policy.cork_bytes = static_cast<size_t>(server_config.send_cork_bytes);
+    send_policy.tcp_nodelay = server_config.tcp_nodelay;
+    send_policy.compression_threshold =
+        static_cast<size_t>(std::max(0, server_config.compression_threshold));
+    send_policy.routed_batch_bytes =
+        static_cast<size_t>(std::max(0, server_config.routed_batch_bytes));
+    network_->SetSendPolicy(send_policy);
+    network_->SetSocketBackend(network::ParseSocketBackend(server_config.socket_backend));
+    // 网关断开后其客户端的下行路由全部失效，立即清出注册表
+    network_->SetSessionClosedHandler([this](const std::shared_ptr<network::TcpSession>& session) {
+        const std::size_t removed = client_registry_.RemoveGateway(session);
+        if (removed > 0) {
+            SYSLOG_INFO("GameServer gateway session {} closed, dropped {} clients",
+                        session->GetSessionId(), removed);
+        }
+    });
 
     const auto& combat_config = config::ConfigManager::Instance().GetCombatConfig();
     combat_service_ = std::make_unique<EcsCombatService>(
@@ -323,7 +344,7 @@ bool GameServer::Initialize(const std::string& config_path) {
 
         auto broadcaster = std::make_unique<ecs::EffectBroadcaster>(world->Registry());
         auto service = std::make_unique<handlers::EffectBroadcastService>(
-            *network_, *aoi_manager, world->Registry());
+            *network_, *aoi_manager, world->Registry(), client_registry_);
         broadcaster->set_broadcast_callback(
             [service_ptr = service.get()](uint64_t caster_id, uint64_t target_id,
                                           uint32_t skill_id, uint8_t effect_type,
@@ -347,7 +368,7 @@ bool GameServer::Initialize(const std::string& config_path) {
         }
 
         auto service = std::make_unique<handlers::EntityBroadcastService>(
-            *network_, world->Registry());
+            *network_, world->Registry(), client_registry_);
         map->SetAOICallback(
             [service_ptr = service.get()](mir2::game::map::AOIEventType event_type,
                                           entt::entity watcher,
@@ -416,7 +437,10 @@ bool GameServer::Initialize(const std::string& config_path) {
 
     // 创建并注册 TeleportSystem（Phase 4: 传送系统）
     if (world1) {
-        teleport_system_ = world1->CreateSystem<ecs::TeleportSystem>(scene_manager_, world1->GetEventBus());
+        // 传送会修改 SceneManager 与其他地图，按地图并行更新时推迟到合并阶段执行
+        teleport_system_ = world1->CreateSystem<ecs::TeleportSystem>(
+            scene_manager_, world1->GetEventBus(),
+            [this](std::function<void()> apply) { registry_manager_.DeferCrossMap(std::move(apply)); });
         SYSLOG_INFO("GameServer: TeleportSystem registered");
     }
     gate_manager_.LoadFromConfig((config_dir / "gates.yaml").string());
@@ -426,8 +450,24 @@ bool GameServer::Initialize(const std::string& config_path) {
         }
     }
 
+    const auto& ecs_config = config::ConfigManager::Instance().GetEcsConfig();
+    registry_manager_.SetParallelUpdate(ecs_config.world_update_threads);
+    registry_manager_.SetParallelSystems(ecs_config.system_update_threads);
+    command_queue_ = std::make_unique<core::BoundedMpscQueue<RoutedCommand>>(
+        std::max<std::size_t>(ecs_config.command_queue_capacity, 1));
+    command_drain_budget_ = ecs_config.command_drain_budget;
+    tick_budget_us_ = std::chrono::milliseconds(std::max(0, ecs_config.tick_budget_ms));
+    tick_interval_us_ = std::chrono::milliseconds(std::max(0, server_config.tick_interval_ms));
+    registry_manager_.SetTickBudget(&tick_budget_, ecs_config.time_slice_entities);
+    character_entity_manager_.SetAutoSaveLimit(ecs_config.auto_save_per_tick, &tick_budget_);
+
     RegisterMessageHandlers();
     RegisterHandlers();
+    // 命令队列与处理表就绪后才开始接受连接，IO 线程只会读到完整的注册结果
+    if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
+        SYSLOG_ERROR("GameServer network start failed");
+        return false;
+    }
     SYSLOG_INFO("GameServer initialized");
     return true;
 }
@@ -452,6 +492,9 @@ void GameServer::Shutdown() {
 }
 
 void GameServer::Tick(float delta_time) {
+    tick_budget_.Begin(tick_budget_us_);
+    // 先处理本 Tick 之前到达的客户端消息，ECS 只在逻辑线程按入队顺序被访问
+    DrainCommands();
     registry_manager_.UpdateAll(delta_time);
     registry_manager_.ForEachWorld([this, delta_time](uint32_t map_id, ecs::World& world) {
         auto* map = scene_manager_.GetMap(static_cast<int32_t>(map_id));
@@ -464,6 +507,24 @@ void GameServer::Tick(float delta_time) {
     if (network_) {
         network_->Tick();
     }
+    RecordTickMetrics();
+}
+
+void GameServer::RecordTickMetrics() {
+    auto& metrics = monitor::Metrics::Instance();
+    const auto elapsed = tick_budget_.Elapsed();
+    metrics.SetGauge("game.tick.elapsed_us", static_cast<int64_t>(elapsed.count()));
+    if (tick_interval_us_.count() > 0) {
+        // 余量为负即本 Tick 超出间隔，后续 Tick 会整体后移
+        const auto headroom = tick_interval_us_ - elapsed;
+        metrics.SetGauge("game.tick.headroom_us", static_cast<int64_t>(headroom.count()));
+        if (headroom.count() < 0) {
+            metrics.IncrementCounter("game.tick.overrun");
+        }
+    }
+    if (tick_budget_.Exhausted()) {
+        metrics.IncrementCounter("game.tick.budget_exhausted");
+    }
 }
 
 void GameServer::RegisterHandlers() {
@@ -473,7 +534,7 @@ void GameServer::RegisterHandlers() {
 
     network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
                               [this](const std::shared_ptr<network::TcpSession>& session,
-                                     const std::vector<uint8_t>& payload) {
+                                     std::span<const uint8_t> payload) {
                                   if (!session) {
                                       return;
                                   }
@@ -490,8 +551,25 @@ void GameServer::RegisterHandlers() {
 
     network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage),
                               [this](const std::shared_ptr<network::TcpSession>& session,
-                                     const std::vector<uint8_t>& payload) {
-                                  HandleRoutedMessage(session, payload);
+                                     std::span<const uint8_t> payload) {
+                                  HandleRoutedMessage(session, payload, false);
+                              });
+    network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame),
+                              [this](const std::shared_ptr<network::TcpSession>& session,
+                                     std::span<const uint8_t> payload) {
+                                  HandleRoutedMessage(session, payload, true);
+                              });
+    network_->RegisterHandler(static_cast<uint16_t>(common::InternalMsgId::kRoutedBatch),
+                              [this](const std::shared_ptr<network::TcpSession>& session,
+                                     std::span<const uint8_t> payload) {
+                                  thread_local std::vector<std::span<const uint8_t>> frames;
+                                  if (!common::SplitRoutedBatch(payload, &frames)) {
+                                      SYSLOG_ERROR("Malformed routed batch, size={}", payload.size());
+                                      return;
+                                  }
+                                  for (const auto frame : frames) {
+                                      HandleRoutedMessage(session, frame, true);
+                                  }
                               });
 }
 
@@ -523,43 +601,92 @@ void GameServer::RegisterMessageHandlers() {
 }
 
 void GameServer::HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& session,
-                                     const std::vector<uint8_t>& payload) {
+                                     std::span<const uint8_t> payload, bool framed) {
     if (!session) {
         return;
     }
     common::RoutedMessageData routed;
-    if (!common::ParseRoutedMessage(payload, &routed)) {
+    std::span<const uint8_t> routed_payload;
+    if (framed) {
+        common::RoutedFrameView view;
+        if (!common::PeelRoutedFrame(payload, &view)) {
+            SYSLOG_ERROR("GameServer failed to peel routed frame");
+            return;
+        }
+        routed.client_id = view.client_id;
+        routed.msg_id = view.msg_id;
+        routed_payload = view.payload;
+    } else if (common::ParseRoutedMessage(payload, &routed)) {
+        routed_payload = routed.payload;
+    } else {
         SYSLOG_ERROR("GameServer failed to parse routed message");
         return;
     }
 
-    client_registry_.Track(routed.client_id);
+    // 记住客户端所属网关及其路由格式，下行广播只发往该网关
+    client_registry_.Track(routed.client_id, session, framed);
 
-    legend2::handlers::HandlerContext context;
-    context.client_id = routed.client_id;
-    context.session = session;
-    context.post = [this](std::function<void()> task) {
-        if (task) {
-            app_.GetIoContext().post(std::move(task));
+    // 负载直接写入队列槽位后交给逻辑线程，IO 线程不再触碰 ECS
+    const bool queued = command_queue_ && command_queue_->TryPushWith([&](RoutedCommand& slot) {
+        slot.client_id = routed.client_id;
+        slot.msg_id = routed.msg_id;
+        slot.framed = framed;
+        slot.session = session;
+        slot.payload.assign(routed_payload.begin(), routed_payload.end());
+    });
+    if (!queued) {
+        monitor::Metrics::Instance().IncrementCounter("game.command_queue.dropped");
+        SYSLOG_WARN("GameServer command queue full, dropped msg_id={} client_id={}",
+                    routed.msg_id, routed.client_id);
+    }
+}
+
+void GameServer::DrainCommands() {
+    if (!command_queue_) {
+        return;
+    }
+    auto& metrics = monitor::Metrics::Instance();
+    metrics.SetGauge("game.command_queue.depth",
+                     static_cast<int64_t>(command_queue_->ApproxSize()));
+
+    // 处理器直接读取槽位中的负载，分发完成后清空（保留容量）再把槽位交还生产者
+    auto dispatch = [this](RoutedCommand& command) {
+        legend2::handlers::HandlerContext context;
+        context.client_id = command.client_id;
+        context.session = command.session;
+
+        bool handled = handler_registry_.Dispatch(
+            context, command.msg_id, command.payload,
+            [this, session = command.session, framed = command.framed](
+                const legend2::handlers::ResponseList& responses) {
+                // 按请求方使用的格式回包，兼容仍发送 FlatBuffers RoutedMessage 的网关；
+                // 组播响应按接收者所属网关分组
+                legend2::handlers::SendRoutedResponses(session, responses, framed,
+                                                       &client_registry_);
+            });
+
+        if (!handled) {
+            SYSLOG_WARN("GameServer no handler for msg_id={}", command.msg_id);
+        }
+        command.session.reset();
+        if (command.payload.capacity() > kMaxRetainedCommandPayload) {
+            std::vector<uint8_t>().swap(command.payload);
+        } else {
+            command.payload.clear();
         }
     };
 
-    bool handled = handler_registry_.Dispatch(
-        context, routed.msg_id, routed.payload,
-        [session](const legend2::handlers::ResponseList& responses) {
-            if (!session) {
-                return;
-            }
-            for (const auto& response : responses) {
-                const auto routed_rsp = common::BuildRoutedMessage(
-                    response.client_id, response.msg_id, response.payload);
-                session->Send(static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage), routed_rsp);
-            }
-        });
+    std::size_t drained = 0;
+    while ((command_drain_budget_ == 0 || drained < command_drain_budget_) &&
+           command_queue_->TryConsume(dispatch)) {
+        ++drained;
+    }
 
-    if (!handled) {
-        SYSLOG_WARN("GameServer no handler for msg_id={}", routed.msg_id);
+    if (drained > 0) {
+        metrics.AddCounter("game.command_queue.drained", drained);
     }
+    metrics.SetGauge("game.command_queue.backlog",
+                     static_cast<int64_t>(command_queue_->ApproxSize()));
 }
 
 }  // namespace mir2::game
@@ -6,12 +6,18 @@
 #ifndef MIR2_GAME_GAME_SERVER_H
 #define MIR2_GAME_GAME_SERVER_H
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "core/application.h"
+#include "core/mpsc_queue.h"
+#include "core/timer.h"
 #include "ecs/registry_manager.h"
 #include "handlers/client_registry.h"
 #include "handlers/effect/effect_broadcast_service.h"
@@ -46,11 +52,27 @@ class GameServer {
   void Shutdown();
 
  private:
+  /**
+   * @brief IO 线程交给逻辑线程的一条客户端消息
+   *
+   * 命令常驻在队列槽位中：IO 线程原地写入，逻辑线程原地分发。payload 的容量随槽位
+   * 循环复用，稳态下入队只有一次拷贝且不分配；session 为来源网关连接，用于回包。
+   */
+  struct RoutedCommand {
+    uint64_t client_id = 0;
+    uint16_t msg_id = 0;
+    bool framed = false;
+    std::shared_ptr<network::TcpSession> session;
+    std::vector<uint8_t> payload;
+  };
+
   void Tick(float delta_time);
+  void DrainCommands();
+  void RecordTickMetrics();
   void RegisterHandlers();
   void RegisterMessageHandlers();
   void HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& session,
-                          const std::vector<uint8_t>& payload);
+                           std::span<const uint8_t> payload, bool framed);
 
   core::Application app_;
   std::unique_ptr<network::NetworkManager> network_;
@@ -67,6 +89,13 @@ class GameServer {
   std::vector<std::unique_ptr<handlers::EntityBroadcastService>> entity_broadcast_services_;
   std::vector<std::unique_ptr<ecs::EffectBroadcaster>> effect_broadcasters_;
   std::thread logic_thread_;
+  /// 网络消息经此队列进入逻辑线程，在 Tick 开头按预算处理
+  std::unique_ptr<core::BoundedMpscQueue<RoutedCommand>> command_queue_;
+  std::size_t command_drain_budget_ = 0;
+  /// 本 Tick 的逻辑预算：耗尽后可延后的系统与自动存档让到下一 Tick
+  core::TickBudget tick_budget_;
+  std::chrono::microseconds tick_budget_us_{0};
+  std::chrono::microseconds tick_interval_us_{0};
 };
 
 }  // namespace mir2::game
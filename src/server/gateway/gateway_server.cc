@@ -4,14 +4,13 @@
 #include <chrono>
 #include <flatbuffers/flatbuffers.h>
 
-#include <asio/post.hpp>
-#include <asio/steady_timer.hpp>
-
 #include "common/enums.h"
 #include "server/common/error_codes.h"
 #include "common/internal_message_helper.h"
+#include "common/routed_envelope.h"
 #include "config/config_manager.h"
 #include "log/logger.h"
+#include "game_generated.h"
 #include "monitor/metrics.h"
 #include "system_generated.h"
 
@@ -20,6 +19,31 @@ namespace mir2::gateway {
 namespace {
 // 硬编码路由规则已迁移到 MessageRouter，保留此命名空间用于未来工具函数
 constexpr float kStaleRouteCleanupIntervalSec = 30.0f;
+constexpr float kLinkMetricsIntervalSec = 1.0f;
+constexpr uint16_t kBusyNoticeLevel = 1;
+
+/**
+ * @brief 识别可替换的实体状态消息并取出实体 ID（新状态会取代客户端尚未读走的旧状态）
+ */
+bool TryGetReplaceableEntity(uint16_t msg_id, std::span<const uint8_t> payload,
+                             uint64_t* entity_id) {
+  flatbuffers::Verifier verifier(payload.data(), payload.size());
+  if (msg_id == static_cast<uint16_t>(common::MsgId::kEntityMove)) {
+    if (!verifier.VerifyBuffer<mir2::proto::EntityMove>(nullptr)) {
+      return false;
+    }
+    *entity_id = flatbuffers::GetRoot<mir2::proto::EntityMove>(payload.data())->entity_id();
+    return true;
+  }
+  if (msg_id == static_cast<uint16_t>(common::MsgId::kEntityUpdate)) {
+    if (!verifier.VerifyBuffer<mir2::proto::EntityUpdate>(nullptr)) {
+      return false;
+    }
+    *entity_id = flatbuffers::GetRoot<mir2::proto::EntityUpdate>(payload.data())->entity_id();
+    return true;
+  }
+  return false;
+}
 }  // namespace
 
 bool GatewayServer::Initialize(const std::string& config_path) {
@@ -41,10 +65,19 @@ bool GatewayServer::Initialize(const std::string& config_path) {
   monitor::Metrics::Instance().Init(server_config.metrics_port);
 
   network_ = std::make_unique<network::NetworkManager>(app_.GetIoContext());
-  if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
-    SYSLOG_ERROR("GatewayServer network start failed");
-    return false;
-  }
+  network_->SetIoContexts(app_.GetIoContexts());
+  network::SendPolicy send_policy;
+  send_policy.cork = server_config.send_cork;
+  send_policy.cork_bytes = static_cast<size_t>(server_config.send_cork_bytes);
+  send_policy.tcp_nodelay = server_config.tcp_nodelay;
+  send_policy.compression_threshold =
+      static_cast<size_t>(std::max(0, server_config.compression_threshold));
+  network_->SetSendPolicy(send_policy);
+  network_->SetSocketBackend(network::ParseSocketBackend(server_config.socket_backend));
+  // 新会话在开始收包前登记连接路由与心跳定时器
+  network_->SetSessionOpenedHandler([this](const std::shared_ptr<network::TcpSession>& session) {
+    RegisterConnection(session->GetSessionId(), session);
+  });
 
   ConnectServices();
 
@@ -59,6 +92,10 @@ bool GatewayServer::Initialize(const std::string& config_path) {
   }
 
   RegisterHandlers();
+  if (!network_->Start(server_config.bind_ip, server_config.port, server_config.max_connections)) {
+    SYSLOG_ERROR("GatewayServer network start failed");
+    return false;
+  }
   SYSLOG_INFO("GatewayServer initialized");
   return true;
 }
@@ -71,14 +108,14 @@ void GatewayServer::Run() {
 }
 
 void GatewayServer::Shutdown() {
-  if (world_client_) {
-    world_client_->Close();
+  if (world_links_) {
+    world_links_->Close();
   }
-  if (game_client_) {
-    game_client_->Close();
+  if (game_links_) {
+    game_links_->Close();
   }
-  if (db_client_) {
-    db_client_->Close();
+  if (db_links_) {
+    db_links_->Close();
   }
   if (network_) {
     network_->Stop();
@@ -92,26 +129,20 @@ void GatewayServer::Shutdown() {
 }
 
 void GatewayServer::Tick(float delta_time) {
-    std::vector<std::shared_ptr<network::TcpSession>> sessions;
     if (network_) {
         network_->Tick();
-        sessions = network_->GetAllSessions();
-        for (const auto& session : sessions) {
-            if (!session) {
-                continue;
-            }
-            const uint64_t connection_id = session->GetSessionId();
-            if (connection_id == 0) {
-                continue;
-            }
-            if (!GetConnectionSession(connection_id)) {
-                RegisterConnection(connection_id, session);
-            }
-        }
     }
 
     const int64_t now_ms = network::TcpSession::NowMs();
-    CheckHeartbeatTimeouts(sessions, now_ms);
+    CheckHeartbeatTimeouts(CollectHeartbeatCandidates(now_ms), now_ms);
+
+    // 本 Tick 转发给后端的路由帧按链路合批写出，写出后按积压刷新链路负载等级
+    for (auto* links : {world_links_.get(), game_links_.get(), db_links_.get()}) {
+        if (links) {
+            links->Flush();
+            links->UpdateLoad(now_ms);
+        }
+    }
 
     stale_route_cleanup_elapsed_sec_ += delta_time;
     if (stale_route_cleanup_elapsed_sec_ >= kStaleRouteCleanupIntervalSec) {
@@ -122,6 +153,23 @@ void GatewayServer::Tick(float delta_time) {
             static_cast<int64_t>(GetConnectionRouteCount()));
         monitor::Metrics::Instance().SetGauge("gateway.route_table.user_count",
                                               static_cast<int64_t>(GetUserRouteCount()));
+        monitor::Metrics::Instance().SetGauge(
+            "gateway.route_table.lock_contended",
+            static_cast<int64_t>(connection_routes_.GetContendedLocks() +
+                                 user_routes_.GetContendedLocks()));
+        monitor::Metrics::Instance().SetGauge(
+            "gateway.route_table.lock_wait_ns",
+            static_cast<int64_t>(connection_routes_.GetLockWaitNs() + user_routes_.GetLockWaitNs()));
+    }
+
+    link_metrics_elapsed_sec_ += delta_time;
+    if (link_metrics_elapsed_sec_ >= kLinkMetricsIntervalSec) {
+        link_metrics_elapsed_sec_ = 0.0f;
+        for (const auto* links : {world_links_.get(), game_links_.get(), db_links_.get()}) {
+            if (links) {
+                links->ReportMetrics();
+            }
+        }
     }
 }
 
@@ -148,10 +196,41 @@ void GatewayServer::CheckHeartbeatTimeouts(
             now_ms - last_heartbeat_ms >= timeout_ms) {
             session->Kick(common::ErrorCode::kKickHeartbeatTimeout, "Heartbeat timeout");
             UnregisterSession(session);
+        } else {
+            // 期间收到过心跳：按最新心跳重新安排
+            ArmHeartbeat(session->GetSessionId(), last_heartbeat_ms + timeout_ms);
         }
     }
 }
 
+void GatewayServer::ArmHeartbeat(uint64_t connection_id, int64_t deadline_ms) {
+    if (connection_id == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    heartbeat_wheel_.Schedule(connection_id, deadline_ms);
+}
+
+std::vector<std::shared_ptr<network::TcpSession>> GatewayServer::CollectHeartbeatCandidates(
+    int64_t now_ms) {
+    std::vector<std::shared_ptr<network::TcpSession>> candidates;
+    heartbeat_expired_.clear();
+    {
+        std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+        if (heartbeat_wheel_.Advance(now_ms, heartbeat_expired_) == 0) {
+            return candidates;
+        }
+    }
+
+    candidates.reserve(heartbeat_expired_.size());
+    for (const uint64_t connection_id : heartbeat_expired_) {
+        if (auto session = GetConnectionSession(connection_id)) {
+            candidates.push_back(std::move(session));
+        }
+    }
+    return candidates;
+}
+
 void GatewayServer::RegisterConnection(uint64_t connection_id,
                                        const std::shared_ptr<network::TcpSession>& session) {
     if (!session) {
@@ -163,9 +242,15 @@ void GatewayServer::RegisterConnection(uint64_t connection_id,
         return;
     }
 
-    {
-        std::unique_lock<std::shared_mutex> lock(route_table_mutex_);
-        connection_route_table_[resolved_id] = session;
+    connection_routes_.Insert(resolved_id, session);
+    if (!connection_slots_.Store(resolved_id, session)) {
+        monitor::Metrics::Instance().IncrementCounter("gateway.session_slots.collision");
+    }
+
+    const int64_t timeout_ms = static_cast<int64_t>(
+        config::ConfigManager::Instance().GetServerConfig().heartbeat_timeout_ms);
+    if (timeout_ms > 0) {
+        ArmHeartbeat(resolved_id, session->GetLastHeartbeatMs() + timeout_ms);
     }
 
     session->SetDisconnectedHandler([this](const std::shared_ptr<network::TcpSession>& disconnected) {
@@ -182,16 +267,12 @@ void GatewayServer::RegisterUser(uint64_t user_id,
         return;
     }
 
-    {
-        std::unique_lock<std::shared_mutex> lock(route_table_mutex_);
-        auto it = user_route_table_.find(user_id);
-        if (it != user_route_table_.end() && it->second && it->second != session) {
-            SYSLOG_WARN("Duplicate login detected, kicking previous session (user_id={})", user_id);
-            it->second->SetUserId(0);
-            it->second->Kick(common::ErrorCode::kKickDuplicateLogin, "Duplicate login");
-        }
-        user_route_table_[user_id] = session;
-        session->SetUserId(user_id);
+    session->SetUserId(user_id);
+    const auto previous = user_routes_.Insert(user_id, session);
+    if (previous && previous != session) {
+        SYSLOG_WARN("Duplicate login detected, kicking previous session (user_id={})", user_id);
+        previous->SetUserId(0);
+        previous->Kick(common::ErrorCode::kKickDuplicateLogin, "Duplicate login");
     }
 
     monitor::Metrics::Instance().IncrementCounter("gateway.user.register");
@@ -205,29 +286,21 @@ void GatewayServer::UnregisterSession(const std::shared_ptr<network::TcpSession>
     const uint64_t connection_id = session->GetSessionId();
     const uint64_t user_id = session->GetUserId();
 
-    {
-        std::unique_lock<std::shared_mutex> lock(route_table_mutex_);
-        if (connection_id != 0) {
-            auto it = connection_route_table_.find(connection_id);
-            if (it != connection_route_table_.end() && it->second == session) {
-                connection_route_table_.erase(it);
-            }
-        }
+    if (connection_id != 0) {
+        connection_routes_.Erase(connection_id, session);
+        connection_slots_.Clear(connection_id, session);
+    }
+    if (user_id != 0) {
+        user_routes_.Erase(user_id, session);
+    } else {
+        user_routes_.EraseIf([&session](uint64_t, const std::shared_ptr<network::TcpSession>& route) {
+            return route == session;
+        });
+    }
 
-        if (user_id != 0) {
-            auto it = user_route_table_.find(user_id);
-            if (it != user_route_table_.end() && it->second == session) {
-                user_route_table_.erase(it);
-            }
-        } else {
-            for (auto it = user_route_table_.begin(); it != user_route_table_.end();) {
-                if (it->second == session) {
-                    it = user_route_table_.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-        }
+    if (connection_id != 0) {
+        std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+        heartbeat_wheel_.Cancel(connection_id);
     }
 
     session->SetUserId(0);
@@ -237,95 +310,62 @@ void GatewayServer::UnregisterSession(const std::shared_ptr<network::TcpSession>
 }
 
 void GatewayServer::CleanupStaleRoutes() {
-    size_t before_connections = 0;
-    size_t before_users = 0;
-    size_t after_connections = 0;
-    size_t after_users = 0;
+    const size_t before_connections = connection_routes_.Size();
+    const size_t before_users = user_routes_.Size();
 
-    {
-        std::unique_lock<std::shared_mutex> lock(route_table_mutex_);
-        before_connections = connection_route_table_.size();
-        before_users = user_route_table_.size();
-
-        for (auto it = connection_route_table_.begin(); it != connection_route_table_.end();) {
-            const auto& session = it->second;
-            if (!session || session->GetState() == network::TcpSession::SessionState::kClosed) {
-                it = connection_route_table_.erase(it);
-            } else {
-                ++it;
-            }
+    // 逐分片清理，转发路径最多等待一个分片
+    connection_routes_.EraseIf([](uint64_t, const std::shared_ptr<network::TcpSession>& session) {
+        return !session || session->GetState() == network::TcpSession::SessionState::kClosed;
+    });
+    user_routes_.EraseIf([](uint64_t, const std::shared_ptr<network::TcpSession>& session) {
+        if (session && session->GetState() != network::TcpSession::SessionState::kClosed) {
+            return false;
         }
-
-        for (auto it = user_route_table_.begin(); it != user_route_table_.end();) {
-            const auto& session = it->second;
-            if (!session || session->GetState() == network::TcpSession::SessionState::kClosed) {
-                if (session) {
-                    session->SetUserId(0);
-                }
-                it = user_route_table_.erase(it);
-            } else {
-                ++it;
-            }
+        if (session) {
+            session->SetUserId(0);
         }
-
-        after_connections = connection_route_table_.size();
-        after_users = user_route_table_.size();
-    }
+        return true;
+    });
 
     SYSLOG_INFO("Cleanup stale routes: connection {}->{} user {}->{}",
-                before_connections, after_connections, before_users, after_users);
+                before_connections, connection_routes_.Size(), before_users, user_routes_.Size());
 }
 
 std::shared_ptr<network::TcpSession> GatewayServer::GetConnectionSession(uint64_t connection_id) const {
-    std::shared_lock<std::shared_mutex> lock(route_table_mutex_);
-    auto it = connection_route_table_.find(connection_id);
-    if (it != connection_route_table_.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return connection_routes_.Find(connection_id);
 }
 
 std::shared_ptr<network::TcpSession> GatewayServer::GetUserSession(uint64_t user_id) const {
-    std::shared_lock<std::shared_mutex> lock(route_table_mutex_);
-    auto it = user_route_table_.find(user_id);
-    if (it != user_route_table_.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return user_routes_.Find(user_id);
 }
 
 size_t GatewayServer::GetConnectionRouteCount() const {
-    std::shared_lock<std::shared_mutex> lock(route_table_mutex_);
-    return connection_route_table_.size();
+    return connection_routes_.Size();
 }
 
 size_t GatewayServer::GetUserRouteCount() const {
-    std::shared_lock<std::shared_mutex> lock(route_table_mutex_);
-    return user_route_table_.size();
+    return user_routes_.Size();
 }
 
 void GatewayServer::RegisterDefaultRoutes() {
-  // DB 服务消息（不需要认证）
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kLoginReq),
-                                common::ServiceType::kDb, false);
-
-  // Logout 由网关显式处理并通知 World/Game 服务。
-
-  // World 服务消息（需要认证）
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kCreateRoleReq),
-                                common::ServiceType::kWorld, true);
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kSelectRoleReq),
-                                common::ServiceType::kWorld, true);
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kRoleListReq),
-                                common::ServiceType::kWorld, true);
-
-  // Game 服务消息（需要认证）
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kMoveReq),
-                                common::ServiceType::kGame, true);
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kAttackReq),
-                                common::ServiceType::kGame, true);
-  message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kSkillReq),
-                                common::ServiceType::kGame, true);
+  message_router_.RegisterRoutes({
+      // DB 服务消息（不需要认证）
+      {static_cast<uint16_t>(common::MsgId::kLoginReq), common::ServiceType::kDb, false,
+       MessagePriority::kCritical},
+
+      // Logout 由网关显式处理并通知 World/Game 服务。
+
+      // World 服务消息（需要认证）
+      {static_cast<uint16_t>(common::MsgId::kCreateRoleReq), common::ServiceType::kWorld, true},
+      {static_cast<uint16_t>(common::MsgId::kSelectRoleReq), common::ServiceType::kWorld, true},
+      {static_cast<uint16_t>(common::MsgId::kRoleListReq), common::ServiceType::kWorld, true},
+
+      // Game 服务消息（需要认证）
+      {static_cast<uint16_t>(common::MsgId::kMoveReq), common::ServiceType::kGame, true,
+       MessagePriority::kLow},
+      {static_cast<uint16_t>(common::MsgId::kAttackReq), common::ServiceType::kGame, true},
+      {static_cast<uint16_t>(common::MsgId::kSkillReq), common::ServiceType::kGame, true},
+  });
 
   SYSLOG_INFO("Registered {} default message routes", message_router_.GetRouteCount());
 }
@@ -337,7 +377,7 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kHeartbeat),
                             [this](const std::shared_ptr<network::TcpSession>& session,
-                                   const std::vector<uint8_t>& payload) {
+                                   std::span<const uint8_t> payload) {
                               if (!session) {
                                 return;
                               }
@@ -369,38 +409,42 @@ void GatewayServer::RegisterHandlers() {
 
   auto forward_handler = [this](const std::shared_ptr<network::TcpSession>& session,
                                 uint16_t msg_id,
-                                const std::vector<uint8_t>& payload) {
+                                std::span<const uint8_t> payload) {
     if (!session) {
       return;
     }
 
-    // 使用动态路由表查找目标服务
-    const auto target = message_router_.GetRouteTarget(msg_id);
-    if (!target) {
+    // 使用动态路由表查找目标服务（目标、认证、优先级取自同一份快照）
+    const auto route = message_router_.Lookup(msg_id);
+    if (!route) {
       SYSLOG_WARN("No route found for msg_id={}, dropping message", msg_id);
       return;
     }
 
-    if (!IsServiceConnected(*target)) {
+    if (!IsServiceConnected(route->target_service)) {
       SYSLOG_ERROR("Service not connected, msg_id={} target={}",
-                   msg_id, static_cast<int>(*target));
+                   msg_id, static_cast<int>(route->target_service));
       return;
     }
 
     // 检查认证要求
-    if (message_router_.RequiresAuth(msg_id) &&
+    if (route->require_auth &&
         session->GetAuthState() != network::TcpSession::AuthState::kAuthed) {
       SYSLOG_WARN("Unauthorized message msg_id={} from session={}, dropping", msg_id, session->GetSessionId());
       return;
     }
 
+    if (!AdmitForward(*route, session)) {
+      return;
+    }
+
     const uint64_t client_id = session->GetSessionId();
-    ForwardToService(*target, client_id, msg_id, payload);
+    ForwardToService(route->target_service, client_id, msg_id, payload);
   };
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kLoginReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session,
                                               static_cast<uint16_t>(common::MsgId::kLoginReq),
                                               payload);
@@ -408,7 +452,7 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kLogout),
                             [this](const std::shared_ptr<network::TcpSession>& session,
-                                   const std::vector<uint8_t>& payload) {
+                                   std::span<const uint8_t> payload) {
                               if (!session) {
                                 return;
                               }
@@ -428,7 +472,7 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kCreateRoleReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session,
                                               static_cast<uint16_t>(common::MsgId::kCreateRoleReq),
                                               payload);
@@ -436,7 +480,7 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kSelectRoleReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session,
                                               static_cast<uint16_t>(common::MsgId::kSelectRoleReq),
                                               payload);
@@ -444,7 +488,7 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kRoleListReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session,
                                               static_cast<uint16_t>(common::MsgId::kRoleListReq),
                                               payload);
@@ -452,14 +496,14 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kMoveReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session, static_cast<uint16_t>(common::MsgId::kMoveReq),
                                               payload);
                             });
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kAttackReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session,
                                               static_cast<uint16_t>(common::MsgId::kAttackReq),
                                               payload);
@@ -467,178 +511,86 @@ void GatewayServer::RegisterHandlers() {
 
   network_->RegisterHandler(static_cast<uint16_t>(common::MsgId::kSkillReq),
                             [forward_handler](const std::shared_ptr<network::TcpSession>& session,
-                                              const std::vector<uint8_t>& payload) {
+                                              std::span<const uint8_t> payload) {
                               forward_handler(session, static_cast<uint16_t>(common::MsgId::kSkillReq),
                                               payload);
                             });
 }
 
 bool GatewayServer::ConnectServices() {
-  StartAsyncConnect(common::ServiceType::kWorld);
-  StartAsyncConnect(common::ServiceType::kGame);
-  StartAsyncConnect(common::ServiceType::kDb);
+  const auto& services = config::ConfigManager::Instance().GetServiceConfig();
+  const auto& server_config = config::ConfigManager::Instance().GetServerConfig();
+  const size_t routed_batch_bytes =
+      static_cast<size_t>(std::max(0, server_config.routed_batch_bytes));
+  const size_t overload_queue_bytes =
+      static_cast<size_t>(std::max(0, server_config.overload_queue_bytes));
+  const int64_t overload_backlog_ms = std::max(0, server_config.overload_backlog_ms);
+  auto start_links = [this, routed_batch_bytes, overload_queue_bytes, overload_backlog_ms](
+                         common::ServiceType service, const config::ServiceEndpoint& endpoint) {
+    auto links = std::make_unique<ServiceLinkPool>(app_.GetIoContext(), service);
+    links->SetRoutedBatchBytes(routed_batch_bytes);
+    links->SetOverloadLimits(overload_queue_bytes, overload_backlog_ms);
+    links->SetPacketHandler([this, service](const network::PacketView& packet) {
+      OnServicePacket(service, packet);
+    });
+    links->Start(endpoint.host, endpoint.port, static_cast<size_t>(std::max(1, endpoint.links)));
+    return links;
+  };
+  world_links_ = start_links(common::ServiceType::kWorld, services.world);
+  game_links_ = start_links(common::ServiceType::kGame, services.game);
+  db_links_ = start_links(common::ServiceType::kDb, services.db);
   return true;
 }
 
-void GatewayServer::StartAsyncConnect(common::ServiceType service) {
-  asio::post(app_.GetIoContext(), [this, service]() {
-    bool success = false;
-    switch (service) {
-      case common::ServiceType::kWorld:
-        success = ConnectToWorldService();
-        break;
-      case common::ServiceType::kGame:
-        success = ConnectToGameService();
-        break;
-      case common::ServiceType::kDb:
-        success = ConnectToDbService();
-        break;
-      default:
-        break;
-    }
-
-    if (!success) {
-      SYSLOG_ERROR("Initial connect failed, scheduling reconnect (service={})",
-                   static_cast<int>(service));
-      ScheduleReconnect(service, 0);
-    }
-  });
-}
-
 bool GatewayServer::IsServiceConnected(common::ServiceType service) const {
-  const auto* client = GetServiceClient(service);
-  return client && client->IsConnected();
+  const auto* links = GetServiceLinks(service);
+  return links && links->IsConnected();
 }
 
-bool GatewayServer::ConnectToWorldService() {
-  const auto& services = config::ConfigManager::Instance().GetServiceConfig();
-
-  if (!world_client_) {
-    world_client_ = std::make_unique<network::TcpClient>(app_.GetIoContext());
+bool GatewayServer::AdmitForward(const MessageRoute& route,
+                                 const std::shared_ptr<network::TcpSession>& session) {
+  const MessagePriority priority = route.priority;
+  if (priority == MessagePriority::kCritical) {
+    return true;
   }
-  world_client_->SetPacketHandler([this](const network::Packet& packet) {
-    OnServicePacket(common::ServiceType::kWorld, packet);
-  });
-  world_client_->SetDisconnectHandler([this]() {
-    SYSLOG_ERROR("World service disconnected, scheduling reconnect");
-    ScheduleReconnect(common::ServiceType::kWorld, 0);
-  });
-  if (!world_client_->Connect(services.world.host, services.world.port)) {
-    SYSLOG_ERROR("Failed to connect World service");
-    monitor::Metrics::Instance().IncrementCounter("gateway.service.disconnected.world");
-    return false;
+  const auto* links = GetServiceLinks(route.target_service);
+  if (!links) {
+    return true;
   }
-  monitor::Metrics::Instance().IncrementCounter("gateway.service.connected.world");
-  world_client_->Send(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
-                      common::BuildServiceHello(common::ServiceType::kGateway));
-  return true;
-}
-
-bool GatewayServer::ConnectToGameService() {
-  const auto& services = config::ConfigManager::Instance().GetServiceConfig();
 
-  if (!game_client_) {
-    game_client_ = std::make_unique<network::TcpClient>(app_.GetIoContext());
+  const LinkLoad load = links->GetLoad(session->GetSessionId());
+  const bool shed = load == LinkLoad::kOverloaded ||
+                    (load == LinkLoad::kBusy && priority == MessagePriority::kLow);
+  if (!shed) {
+    return true;
   }
-  game_client_->SetPacketHandler([this](const network::Packet& packet) {
-    OnServicePacket(common::ServiceType::kGame, packet);
-  });
-  game_client_->SetDisconnectHandler([this]() {
-    SYSLOG_ERROR("Game service disconnected, scheduling reconnect");
-    ScheduleReconnect(common::ServiceType::kGame, 0);
-  });
-  if (!game_client_->Connect(services.game.host, services.game.port)) {
-    SYSLOG_ERROR("Failed to connect Game service");
-    monitor::Metrics::Instance().IncrementCounter("gateway.service.disconnected.game");
-    return false;
-  }
-  monitor::Metrics::Instance().IncrementCounter("gateway.service.connected.game");
-  game_client_->Send(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
-                     common::BuildServiceHello(common::ServiceType::kGateway));
-  return true;
-}
 
-bool GatewayServer::ConnectToDbService() {
-  const auto& services = config::ConfigManager::Instance().GetServiceConfig();
-
-  if (!db_client_) {
-    db_client_ = std::make_unique<network::TcpClient>(app_.GetIoContext());
-  }
-  db_client_->SetPacketHandler([this](const network::Packet& packet) {
-    OnServicePacket(common::ServiceType::kDb, packet);
-  });
-  db_client_->SetDisconnectHandler([this]() {
-    SYSLOG_ERROR("DB service disconnected, scheduling reconnect");
-    ScheduleReconnect(common::ServiceType::kDb, 0);
-  });
-  if (!db_client_->Connect(services.db.host, services.db.port)) {
-    SYSLOG_ERROR("Failed to connect DB service");
-    monitor::Metrics::Instance().IncrementCounter("gateway.service.disconnected.db");
-    return false;
-  }
-  monitor::Metrics::Instance().IncrementCounter("gateway.service.connected.db");
-  db_client_->Send(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
-                   common::BuildServiceHello(common::ServiceType::kGateway));
-  return true;
+  // 后端积压时不再排队，立即告知客户端重试；客户端发包速率受会话限速约束，回复不会放大
+  monitor::Metrics::Instance().IncrementCounter(priority == MessagePriority::kLow
+                                                    ? "gateway.overload.shed.low"
+                                                    : "gateway.overload.shed.normal");
+  SendServerBusy(session, route.msg_id);
+  return false;
 }
 
-void GatewayServer::ScheduleReconnect(common::ServiceType service, int retry_count) {
-  {
-    std::unique_lock<std::shared_mutex> lock(reconnect_mutex_);
-    if (reconnecting_[service]) {
-      return;
-    }
-    reconnecting_[service] = true;
-  }
-
-  const int capped_retry = std::min(retry_count, 5);
-  const int delay_ms = std::min(1000 * (1 << capped_retry), 30000);
-  SYSLOG_INFO("Scheduling reconnect to service {} in {}ms (retry={})",
-              static_cast<int>(service), delay_ms, retry_count);
-
-  auto timer = std::make_shared<asio::steady_timer>(
-      app_.GetIoContext(), std::chrono::milliseconds(delay_ms));
-  timer->async_wait([this, service, retry_count, timer](const asio::error_code& ec) {
-    if (ec) {
-      std::unique_lock<std::shared_mutex> lock(reconnect_mutex_);
-      reconnecting_[service] = false;
-      return;
-    }
-
-    bool success = false;
-    switch (service) {
-      case common::ServiceType::kWorld:
-        success = ConnectToWorldService();
-        break;
-      case common::ServiceType::kGame:
-        success = ConnectToGameService();
-        break;
-      case common::ServiceType::kDb:
-        success = ConnectToDbService();
-        break;
-      default:
-        break;
-    }
-
-    if (success) {
-      SYSLOG_INFO("Reconnected to service {}", static_cast<int>(service));
-      std::unique_lock<std::shared_mutex> lock(reconnect_mutex_);
-      reconnecting_[service] = false;
-      return;
-    }
-
-    {
-      std::unique_lock<std::shared_mutex> lock(reconnect_mutex_);
-      reconnecting_[service] = false;
-    }
-    ScheduleReconnect(service, retry_count + 1);
-  });
+void GatewayServer::SendServerBusy(const std::shared_ptr<network::TcpSession>& session,
+                                   uint16_t msg_id) {
+  const common::ErrorCode code = common::ErrorCode::SERVER_OVERLOADED;
+  flatbuffers::FlatBufferBuilder builder;
+  const auto message_offset = builder.CreateString(common::ToString(code));
+  const uint32_t server_time = static_cast<uint32_t>(network::TcpSession::NowMs());
+  const auto notice = mir2::proto::CreateServerNotice(
+      builder, kBusyNoticeLevel, message_offset, server_time,
+      static_cast<mir2::proto::ErrorCode>(static_cast<uint16_t>(code)), msg_id);
+  builder.Finish(notice);
+  session->Send(static_cast<uint16_t>(common::MsgId::kServerNotice),
+                std::span<const uint8_t>(builder.GetBufferPointer(), builder.GetSize()));
 }
 
 void GatewayServer::ForwardToService(common::ServiceType service, uint64_t client_id, uint16_t msg_id,
-                                    const std::vector<uint8_t>& payload) {
-  auto* client = GetServiceClient(service);
-  if (!client || !client->IsConnected()) {
+                                    std::span<const uint8_t> payload) {
+  auto* links = GetServiceLinks(service);
+  if (!links || !links->IsConnected()) {
     SYSLOG_ERROR("Service not connected, service={} msg_id={}",
                  static_cast<int>(service), msg_id);
     return;
@@ -660,8 +612,8 @@ void GatewayServer::ForwardToService(common::ServiceType service, uint64_t clien
       break;
   }
 
-  const auto routed = common::BuildRoutedMessage(client_id, msg_id, payload);
-  client->Send(static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage), routed);
+  // 同一客户端固定走一条链路，保持其消息顺序；信封与负载直接编码进链路发送缓冲
+  links->SendRouted(client_id, msg_id, payload);
 }
 
 void GatewayServer::NotifyClientDisconnected(uint64_t client_id) {
@@ -677,7 +629,7 @@ void GatewayServer::NotifyClientDisconnected(uint64_t client_id) {
                    empty_payload);
 }
 
-void GatewayServer::OnServicePacket(common::ServiceType service, const network::Packet& packet) {
+void GatewayServer::OnServicePacket(common::ServiceType service, const network::PacketView& packet) {
   if (!network_) {
     return;
   }
@@ -692,32 +644,110 @@ void GatewayServer::OnServicePacket(common::ServiceType service, const network::
     return;
   }
 
-  if (packet.msg_id != static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage)) {
+  if (packet.msg_id == static_cast<uint16_t>(common::InternalMsgId::kRoutedBatch)) {
+    // 批次内各帧的负载视图同样指向链路接收缓冲
+    thread_local std::vector<std::span<const uint8_t>> frames;
+    if (!common::SplitRoutedBatch(packet.payload, &frames)) {
+      SYSLOG_ERROR("Malformed routed batch from service={}", static_cast<int>(service));
+      return;
+    }
+    common::RoutedFrameView routed;
+    for (const auto frame : frames) {
+      if (common::PeelRoutedFrame(frame, &routed)) {
+        DeliverToClient(routed);
+      }
+    }
     return;
   }
 
-  common::RoutedMessageData routed;
-  if (!common::ParseRoutedMessage(packet.payload, &routed)) {
-    SYSLOG_ERROR("Failed to parse routed message from service");
+  common::RoutedFrameView routed;
+  common::RoutedMessageData legacy;
+  if (packet.msg_id == static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame)) {
+    // 定长信封：负载视图直接指向链路接收缓冲，编码进客户端发送缓冲前不复制
+    if (!common::PeelRoutedFrame(packet.payload, &routed)) {
+      SYSLOG_ERROR("Malformed routed frame from service={}", static_cast<int>(service));
+      return;
+    }
+  } else if (packet.msg_id == static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage)) {
+    if (!common::ParseRoutedMessage(packet.payload, &legacy)) {
+      SYSLOG_ERROR("Failed to parse routed message from service");
+      return;
+    }
+    routed.client_id = legacy.client_id;
+    routed.msg_id = legacy.msg_id;
+    routed.payload = legacy.payload;
+  } else {
     return;
   }
+  DeliverToClient(routed);
+}
 
-  auto session = network_->GetSession(routed.client_id);
+void GatewayServer::DeliverToClient(const common::RoutedFrameView& routed) {
+  if (routed.flags & common::kRoutedFlagMulticast) {
+    DeliverMulticast(routed);
+    return;
+  }
+  auto session = FindDeliverySession(routed.client_id);
   if (!session) {
     SYSLOG_ERROR("Client session not found, client_id={}", routed.client_id);
     return;
   }
+  uint64_t entity_id = 0;
+  if (TryGetReplaceableEntity(routed.msg_id, routed.payload, &entity_id)) {
+    session->SendLatest(routed.msg_id, entity_id, routed.payload);
+    return;
+  }
   session->Send(routed.msg_id, routed.payload);
 }
 
-network::TcpClient* GatewayServer::GetServiceClient(common::ServiceType service) const {
+void GatewayServer::DeliverMulticast(const common::RoutedFrameView& routed) {
+  common::RoutedMulticastView multicast;
+  if (!common::PeelRoutedMulticast(routed, &multicast)) {
+    SYSLOG_ERROR("Malformed routed multicast, msg_id={}", routed.msg_id);
+    return;
+  }
+  // 负载只编码一次，各会话共享同一帧主体
+  const auto frame = network::SharedFrame::Create(multicast.msg_id, multicast.payload.data(),
+                                                  multicast.payload.size());
+  if (!frame || !frame->IsValid()) {
+    return;
+  }
+  uint64_t entity_id = 0;
+  const bool replaceable = TryGetReplaceableEntity(multicast.msg_id, multicast.payload, &entity_id);
+  size_t delivered = 0;
+  for (size_t i = 0; i < multicast.recipient_count; ++i) {
+    auto session = FindDeliverySession(multicast.RecipientAt(i));
+    if (!session) {
+      continue;
+    }
+    if (replaceable) {
+      session->SendFrameLatest(frame, entity_id);
+    } else {
+      session->SendFrame(frame);
+    }
+    ++delivered;
+  }
+  auto& metrics = monitor::Metrics::Instance();
+  metrics.IncrementCounter("gateway.multicast.messages");
+  metrics.AddCounter("gateway.multicast.recipients", delivered);
+}
+
+std::shared_ptr<network::TcpSession> GatewayServer::FindDeliverySession(uint64_t client_id) const {
+  if (auto session = connection_slots_.Find(client_id)) {
+    return session;
+  }
+  // 槽位冲突时会话只登记在路由表中
+  return connection_routes_.Find(client_id);
+}
+
+ServiceLinkPool* GatewayServer::GetServiceLinks(common::ServiceType service) const {
   switch (service) {
     case common::ServiceType::kWorld:
-      return world_client_.get();
+      return world_links_.get();
     case common::ServiceType::kGame:
-      return game_client_.get();
+      return game_links_.get();
     case common::ServiceType::kDb:
-      return db_client_.get();
+      return db_links_.get();
     default:
       return nullptr;
   }
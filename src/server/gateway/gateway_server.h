@@ -8,17 +8,19 @@
 
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <span>
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <vector>
 
 #include "common/enums.h"
+#include "common/routed_envelope.h"
 #include "core/application.h"
 #include "gateway/message_router.h"
-#include "network/tcp_client.h"
+#include "gateway/route_table.h"
+#include "gateway/service_link_pool.h"
 #include "network/network_manager.h"
+#include "network/timing_wheel.h"
 
 namespace mir2::gateway {
 
@@ -54,34 +56,44 @@ class GatewayServer {
   void RegisterHandlers();
   void RegisterDefaultRoutes();
   bool ConnectServices();
-  void StartAsyncConnect(common::ServiceType service);
   bool IsServiceConnected(common::ServiceType service) const;
-  bool ConnectToWorldService();
-  bool ConnectToGameService();
-  bool ConnectToDbService();
-  void ScheduleReconnect(common::ServiceType service, int retry_count);
+  /**
+   * @brief 按目标链路负载与消息优先级决定是否转发；被削减时回复服务器繁忙
+   */
+  bool AdmitForward(const MessageRoute& route, const std::shared_ptr<network::TcpSession>& session);
+  void SendServerBusy(const std::shared_ptr<network::TcpSession>& session, uint16_t msg_id);
   void ForwardToService(common::ServiceType service, uint64_t client_id, uint16_t msg_id,
-                        const std::vector<uint8_t>& payload);
+                        std::span<const uint8_t> payload);
   void NotifyClientDisconnected(uint64_t client_id);
-  void OnServicePacket(common::ServiceType service, const network::Packet& packet);
-  network::TcpClient* GetServiceClient(common::ServiceType service) const;
+  void ArmHeartbeat(uint64_t connection_id, int64_t deadline_ms);
+  std::vector<std::shared_ptr<network::TcpSession>> CollectHeartbeatCandidates(int64_t now_ms);
+  void OnServicePacket(common::ServiceType service, const network::PacketView& packet);
+  void DeliverToClient(const common::RoutedFrameView& routed);
+  void DeliverMulticast(const common::RoutedFrameView& routed);
+  std::shared_ptr<network::TcpSession> FindDeliverySession(uint64_t client_id) const;
+  ServiceLinkPool* GetServiceLinks(common::ServiceType service) const;
 
   core::Application app_;
   std::unique_ptr<network::NetworkManager> network_;
-  std::unique_ptr<network::TcpClient> world_client_;
-  std::unique_ptr<network::TcpClient> game_client_;
-  std::unique_ptr<network::TcpClient> db_client_;
+  std::unique_ptr<ServiceLinkPool> world_links_;
+  std::unique_ptr<ServiceLinkPool> game_links_;
+  std::unique_ptr<ServiceLinkPool> db_links_;
   std::thread logic_thread_;
 
-  mutable std::shared_mutex route_table_mutex_;
-  std::unordered_map<uint64_t, std::shared_ptr<network::TcpSession>> connection_route_table_;
-  std::unordered_map<uint64_t, std::shared_ptr<network::TcpSession>> user_route_table_;
+  RouteTable connection_routes_;
+  // 回包投递按连接 id 直接取会话，不经过会话表/路由表的分片锁
+  SessionSlots connection_slots_;
+  RouteTable user_routes_;
 
   MessageRouter message_router_;
-  std::shared_mutex reconnect_mutex_;
-  // Track reconnect attempts per service to avoid duplicate timers.
-  std::unordered_map<common::ServiceType, bool> reconnecting_;
   float stale_route_cleanup_elapsed_sec_ = 0.0f;
+  float link_metrics_elapsed_sec_ = 0.0f;
+
+  // 心跳超时时间轮：连接登记时安排，到期的连接交给 CheckHeartbeatTimeouts 复核
+  std::mutex heartbeat_mutex_;
+  network::TimingWheel heartbeat_wheel_{network::TimingWheel::kDefaultTickMs,
+                                        network::TcpSession::NowMs()};
+  std::vector<uint64_t> heartbeat_expired_;
 };
 
 }  // namespace mir2::gateway
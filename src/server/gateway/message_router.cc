@@ -1,35 +1,75 @@
 #include "gateway/message_router.h"
 
 #include <fstream>
+#include <utility>
 
 #include "log/logger.h"
 #include "yaml-cpp/yaml.h"
 
 namespace mir2::gateway {
 
-void MessageRouter::RegisterRoute(uint16_t msg_id, common::ServiceType service, bool require_auth) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  routes_[msg_id] = MessageRoute{msg_id, service, require_auth};
-  SYSLOG_DEBUG("Registered route: msg_id={} -> service={} require_auth={}",
-               msg_id, static_cast<int>(service), require_auth);
+MessageRouter::MessageRouter() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  Publish(std::make_unique<RouteSnapshot>());
+}
+
+void MessageRouter::Publish(std::unique_ptr<const RouteSnapshot> snapshot) {
+  current_.store(snapshot.get(), std::memory_order_release);
+  snapshots_.push_back(std::move(snapshot));
+}
+
+void MessageRouter::RegisterRoute(uint16_t msg_id, common::ServiceType service, bool require_auth,
+                                  MessagePriority priority) {
+  RegisterRoutes({MessageRoute{msg_id, service, require_auth, priority}});
+}
+
+void MessageRouter::RegisterRoutes(const std::vector<MessageRoute>& routes) {
+  if (routes.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    auto snapshot = std::make_unique<RouteSnapshot>(Current());
+    for (const auto& route : routes) {
+      auto& slot = snapshot->routes.At(route.msg_id);
+      if (!slot) {
+        ++snapshot->count;
+      }
+      slot = route;
+    }
+    Publish(std::move(snapshot));
+  }
+  for (const auto& route : routes) {
+    SYSLOG_DEBUG("Registered route: msg_id={} -> service={} require_auth={} priority={}",
+                 route.msg_id, static_cast<int>(route.target_service), route.require_auth,
+                 static_cast<int>(route.priority));
+  }
+}
+
+std::optional<MessageRoute> MessageRouter::Lookup(uint16_t msg_id) const {
+  const auto* route = Current().routes.Find(msg_id);
+  if (route && *route) {
+    return *route;
+  }
+  return std::nullopt;
 }
 
 std::optional<common::ServiceType> MessageRouter::GetRouteTarget(uint16_t msg_id) const {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto it = routes_.find(msg_id);
-  if (it != routes_.end()) {
-    return it->second.target_service;
+  const auto route = Lookup(msg_id);
+  if (route) {
+    return route->target_service;
   }
   return std::nullopt;
 }
 
 bool MessageRouter::RequiresAuth(uint16_t msg_id) const {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto it = routes_.find(msg_id);
-  if (it != routes_.end()) {
-    return it->second.require_auth;
-  }
-  return false;
+  const auto route = Lookup(msg_id);
+  return route && route->require_auth;
+}
+
+MessagePriority MessageRouter::GetPriority(uint16_t msg_id) const {
+  const auto route = Lookup(msg_id);
+  return route ? route->priority : MessagePriority::kNormal;
 }
 
 bool MessageRouter::LoadRoutesFromConfig(const std::string& config_path) {
@@ -41,8 +81,8 @@ bool MessageRouter::LoadRoutesFromConfig(const std::string& config_path) {
     }
 
     const YAML::Node& routes_node = config["message_routes"];
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    routes_.clear();
+    // 在新快照上完整解析后一次性替换，解析失败时转发路径仍使用旧路由表
+    auto snapshot = std::make_unique<RouteSnapshot>();
 
     for (const auto& route : routes_node) {
       if (!route["msg_id"] || !route["service"]) {
@@ -53,6 +93,8 @@ bool MessageRouter::LoadRoutesFromConfig(const std::string& config_path) {
       const uint16_t msg_id = route["msg_id"].as<uint16_t>();
       const std::string service_str = route["service"].as<std::string>();
       const bool require_auth = route["require_auth"] ? route["require_auth"].as<bool>() : false;
+      const std::string priority_str =
+          route["priority"] ? route["priority"].as<std::string>() : std::string("normal");
 
       common::ServiceType service = common::ServiceType::kGateway;
       if (service_str == "world") {
@@ -66,12 +108,30 @@ bool MessageRouter::LoadRoutesFromConfig(const std::string& config_path) {
         continue;
       }
 
-      routes_[msg_id] = MessageRoute{msg_id, service, require_auth};
-      SYSLOG_INFO("Loaded route: msg_id={} -> service={} require_auth={}",
-                  msg_id, service_str, require_auth);
+      MessagePriority priority = MessagePriority::kNormal;
+      if (priority_str == "low") {
+        priority = MessagePriority::kLow;
+      } else if (priority_str == "critical") {
+        priority = MessagePriority::kCritical;
+      } else if (priority_str != "normal") {
+        SYSLOG_WARN("Unknown priority in route config: {}, using normal", priority_str);
+      }
+
+      auto& slot = snapshot->routes.At(msg_id);
+      if (!slot) {
+        ++snapshot->count;
+      }
+      slot = MessageRoute{msg_id, service, require_auth, priority};
+      SYSLOG_INFO("Loaded route: msg_id={} -> service={} require_auth={} priority={}",
+                  msg_id, service_str, require_auth, priority_str);
     }
 
-    SYSLOG_INFO("Loaded {} message routes from {}", routes_.size(), config_path);
+    const size_t count = snapshot->count;
+    {
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      Publish(std::move(snapshot));
+    }
+    SYSLOG_INFO("Loaded {} message routes from {}", count, config_path);
     return true;
   } catch (const std::exception& e) {
     SYSLOG_ERROR("Failed to load message routes from {}: {}", config_path, e.what());
@@ -80,13 +140,12 @@ bool MessageRouter::LoadRoutesFromConfig(const std::string& config_path) {
 }
 
 void MessageRouter::Clear() {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  routes_.clear();
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  Publish(std::make_unique<RouteSnapshot>());
 }
 
 size_t MessageRouter::GetRouteCount() const {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  return routes_.size();
+  return Current().count;
 }
 
 }  // namespace mir2::gateway
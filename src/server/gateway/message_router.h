@@ -6,16 +6,27 @@
 #ifndef MIR2_GATEWAY_MESSAGE_ROUTER_H
 #define MIR2_GATEWAY_MESSAGE_ROUTER_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "common/enums.h"
+#include "server/common/msg_id_table.h"
 
 namespace mir2::gateway {
 
+/**
+ * @brief 消息转发优先级（后端过载时按优先级削减）
+ */
+enum class MessagePriority : uint8_t {
+  kLow = 0,       // 可丢弃的高频消息（移动、聊天），后端繁忙即削减
+  kNormal = 1,    // 普通请求，后端过载时削减
+  kCritical = 2,  // 登录、登出等，始终放行
+};
+
 /**
  * @brief 消息路由规则
  */
@@ -23,20 +34,29 @@ struct MessageRoute {
   uint16_t msg_id;
   common::ServiceType target_service;
   bool require_auth;  // 是否需要认证后才能转发
+  MessagePriority priority = MessagePriority::kNormal;
 
   MessageRoute() = default;
-  MessageRoute(uint16_t id, common::ServiceType service, bool auth = false)
-      : msg_id(id), target_service(service), require_auth(auth) {}
+  MessageRoute(uint16_t id, common::ServiceType service, bool auth = false,
+               MessagePriority prio = MessagePriority::kNormal)
+      : msg_id(id), target_service(service), require_auth(auth), priority(prio) {}
 };
 
 /**
  * @brief 消息路由器
  *
  * 负责管理消息 ID 到后端服务的映射关系，支持动态配置与热更新。
+ *
+ * 路由表以不可变快照发布：写操作（注册、清空、重载配置）复制当前快照、修改后原子替换，
+ * 转发路径的查找只是一次原子加载加一次按 msg_id 的下标访问，不加锁。
+ *
+ * 读者只在单次查找内持有快照指针并按值返回结果，指针不会逃出本类。发布过的快照保留到
+ * 路由器析构，因此无论读者停顿多久都不会读到已释放的快照；发布只发生在启动注册与配置
+ * 重载时，保留的内存随重载次数线性增长（每份快照仅含已用到的页）。批量注册只发布一次快照。
  */
 class MessageRouter {
  public:
-  MessageRouter() = default;
+  MessageRouter();
   ~MessageRouter() = default;
 
   MessageRouter(const MessageRouter&) = delete;
@@ -47,8 +67,22 @@ class MessageRouter {
    * @param msg_id 消息ID
    * @param service 目标服务类型
    * @param require_auth 是否需要认证
+   * @param priority 过载时的转发优先级
+   */
+  void RegisterRoute(uint16_t msg_id, common::ServiceType service, bool require_auth = false,
+                     MessagePriority priority = MessagePriority::kNormal);
+
+  /**
+   * @brief 批量注册路由规则（合并为一次快照发布）
+   */
+  void RegisterRoutes(const std::vector<MessageRoute>& routes);
+
+  /**
+   * @brief 从同一份快照读取完整路由规则
+   * @param msg_id 消息ID
+   * @return 路由规则，如果未找到返回 std::nullopt
    */
-  void RegisterRoute(uint16_t msg_id, common::ServiceType service, bool require_auth = false);
+  std::optional<MessageRoute> Lookup(uint16_t msg_id) const;
 
   /**
    * @brief 获取消息的目标服务
@@ -64,6 +98,13 @@ class MessageRouter {
    */
   bool RequiresAuth(uint16_t msg_id) const;
 
+  /**
+   * @brief 获取消息的转发优先级
+   * @param msg_id 消息ID
+   * @return 转发优先级，未注册的消息为 kNormal
+   */
+  MessagePriority GetPriority(uint16_t msg_id) const;
+
   /**
    * @brief 从配置加载路由表
    * @param config_path 配置文件路径
@@ -82,8 +123,21 @@ class MessageRouter {
   size_t GetRouteCount() const;
 
  private:
-  mutable std::shared_mutex mutex_;
-  std::unordered_map<uint16_t, MessageRoute> routes_;
+  struct RouteSnapshot {
+    common::MsgIdTable<std::optional<MessageRoute>> routes;
+    size_t count = 0;
+  };
+
+  const RouteSnapshot& Current() const { return *current_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief 发布新快照，旧快照保留到析构（调用方持有 write_mutex_）
+   */
+  void Publish(std::unique_ptr<const RouteSnapshot> snapshot);
+
+  std::mutex write_mutex_;
+  std::atomic<const RouteSnapshot*> current_{nullptr};
+  std::vector<std::unique_ptr<const RouteSnapshot>> snapshots_;  // 全部已发布快照
 };
 
 }  // namespace mir2::gateway
@@ -0,0 +1,112 @@
+#include "gateway/route_table.h"
+
+#include <chrono>
+#include <mutex>
+
+#include "network/tcp_session.h"
+
+namespace mir2::gateway {
+
+namespace {
+
+int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void RouteTable::RecordWait(int64_t start_ns) const {
+  contended_locks_.fetch_add(1, std::memory_order_relaxed);
+  lock_wait_ns_.fetch_add(static_cast<uint64_t>(SteadyNowNs() - start_ns),
+                          std::memory_order_relaxed);
+}
+
+std::shared_lock<std::shared_mutex> RouteTable::LockShared(const Shard& shard) const {
+  std::shared_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    // 只在发生等待时取时间，无竞争路径不调用时钟
+    const int64_t start_ns = SteadyNowNs();
+    lock.lock();
+    RecordWait(start_ns);
+  }
+  return lock;
+}
+
+std::unique_lock<std::shared_mutex> RouteTable::LockExclusive(const Shard& shard) const {
+  std::unique_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    const int64_t start_ns = SteadyNowNs();
+    lock.lock();
+    RecordWait(start_ns);
+  }
+  return lock;
+}
+
+std::shared_ptr<network::TcpSession> RouteTable::Insert(
+    uint64_t key, const std::shared_ptr<network::TcpSession>& session) {
+  auto& shard = ShardFor(key);
+  auto lock = LockExclusive(shard);
+  auto [it, inserted] = shard.routes.try_emplace(key, session);
+  if (inserted) {
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return std::exchange(it->second, session);
+}
+
+bool RouteTable::Erase(uint64_t key, const std::shared_ptr<network::TcpSession>& session) {
+  auto& shard = ShardFor(key);
+  auto lock = LockExclusive(shard);
+  const auto it = shard.routes.find(key);
+  if (it == shard.routes.end() || it->second != session) {
+    return false;
+  }
+  shard.routes.erase(it);
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+std::shared_ptr<network::TcpSession> RouteTable::Find(uint64_t key) const {
+  const auto& shard = ShardFor(key);
+  auto lock = LockShared(shard);
+  const auto it = shard.routes.find(key);
+  return it != shard.routes.end() ? it->second : nullptr;
+}
+
+SessionSlots::SessionSlots() : slots_(std::make_unique<Slot[]>(kSlotCount)) {}
+
+bool SessionSlots::Store(uint64_t connection_id,
+                         const std::shared_ptr<network::TcpSession>& session) {
+  Slot& slot = SlotFor(connection_id);
+  auto current = slot.load(std::memory_order_acquire);
+  for (;;) {
+    // 旧会话已关闭（断线回调尚未清槽）时允许覆盖
+    if (current && current != session &&
+        current->GetState() != network::TcpSession::SessionState::kClosed) {
+      return false;
+    }
+    if (slot.compare_exchange_weak(current, session, std::memory_order_acq_rel,
+                                   std::memory_order_acquire)) {
+      return true;
+    }
+  }
+}
+
+void SessionSlots::Clear(uint64_t connection_id,
+                         const std::shared_ptr<network::TcpSession>& session) {
+  auto expected = session;
+  SlotFor(connection_id).compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire);
+}
+
+std::shared_ptr<network::TcpSession> SessionSlots::Find(uint64_t connection_id) const {
+  auto session = SlotFor(connection_id).load(std::memory_order_acquire);
+  if (session && session->GetSessionId() == connection_id) {
+    return session;
+  }
+  return nullptr;
+}
+
+}  // namespace mir2::gateway
@@ -0,0 +1,136 @@
+/**
+ * @file route_table.h
+ * @brief 网关分片路由表
+ */
+
+#ifndef MIR2_GATEWAY_ROUTE_TABLE_H
+#define MIR2_GATEWAY_ROUTE_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace mir2::network {
+class TcpSession;
+}  // namespace mir2::network
+
+namespace mir2::gateway {
+
+/**
+ * @brief 路由表（键 -> 会话）
+ *
+ * 按键分为 kShardCount 个分片，每个分片独占一条缓存行并有各自的读写锁：查找只取
+ * 一个分片的读锁，清理逐分片进行，任一时刻最多阻塞一个分片。获取锁时若发生等待，
+ * 等待次数与耗时计入 GetContendedLocks / GetLockWaitNs。
+ */
+class RouteTable {
+ public:
+  static constexpr size_t kShardCount = 32;
+
+  /**
+   * @brief 插入或替换路由，返回被替换的旧会话（没有时为空）
+   */
+  std::shared_ptr<network::TcpSession> Insert(uint64_t key,
+                                              const std::shared_ptr<network::TcpSession>& session);
+
+  /**
+   * @brief 仅当 key 仍指向 session 时移除，返回是否移除
+   */
+  bool Erase(uint64_t key, const std::shared_ptr<network::TcpSession>& session);
+
+  std::shared_ptr<network::TcpSession> Find(uint64_t key) const;
+
+  /**
+   * @brief 逐分片移除满足 pred(key, session) 的路由，返回移除数量
+   *
+   * pred 在分片写锁内执行，不得再访问本路由表。
+   */
+  template <typename Pred>
+  size_t EraseIf(Pred&& pred) {
+    size_t erased = 0;
+    for (auto& shard : shards_) {
+      auto lock = LockExclusive(shard);
+      for (auto it = shard.routes.begin(); it != shard.routes.end();) {
+        if (pred(it->first, it->second)) {
+          it = shard.routes.erase(it);
+          ++erased;
+        } else {
+          ++it;
+        }
+      }
+    }
+    size_.fetch_sub(erased, std::memory_order_relaxed);
+    return erased;
+  }
+
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 分片锁发生等待的累计次数与累计等待时间（纳秒）
+   */
+  uint64_t GetContendedLocks() const { return contended_locks_.load(std::memory_order_relaxed); }
+  uint64_t GetLockWaitNs() const { return lock_wait_ns_.load(std::memory_order_relaxed); }
+
+ private:
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<network::TcpSession>> routes;
+  };
+
+  Shard& ShardFor(uint64_t key) { return shards_[key % kShardCount]; }
+  const Shard& ShardFor(uint64_t key) const { return shards_[key % kShardCount]; }
+  std::shared_lock<std::shared_mutex> LockShared(const Shard& shard) const;
+  std::unique_lock<std::shared_mutex> LockExclusive(const Shard& shard) const;
+  void RecordWait(int64_t start_ns) const;
+
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<size_t> size_{0};
+  mutable std::atomic<uint64_t> contended_locks_{0};
+  mutable std::atomic<uint64_t> lock_wait_ns_{0};
+};
+
+/**
+ * @brief 连接槽表（connection_id -> 会话的直达缓存）
+ *
+ * 连接 id 单调递增，按 id 取模落到固定槽位；查找只做一次原子读取并核对会话 id，
+ * 不取任何分片锁，供后端回包投递等热路径使用。槽位被另一个仍存活的会话占用时
+ * （长连接与 kSlotCount 个之后的新连接相撞）Store 返回 false，调用方回退到 RouteTable。
+ */
+class SessionSlots {
+ public:
+  static constexpr size_t kSlotCount = size_t{1} << 16;
+
+  SessionSlots();
+
+  /**
+   * @brief 登记会话；槽位被其他存活会话占用时返回 false
+   */
+  bool Store(uint64_t connection_id, const std::shared_ptr<network::TcpSession>& session);
+
+  /**
+   * @brief 仅当槽位仍指向 session 时清空
+   */
+  void Clear(uint64_t connection_id, const std::shared_ptr<network::TcpSession>& session);
+
+  /**
+   * @brief 查找会话；槽位为空或属于其他连接时返回空
+   */
+  std::shared_ptr<network::TcpSession> Find(uint64_t connection_id) const;
+
+ private:
+  using Slot = std::atomic<std::shared_ptr<network::TcpSession>>;
+
+  Slot& SlotFor(uint64_t connection_id) const { return slots_[connection_id & (kSlotCount - 1)]; }
+
+  std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace mir2::gateway
+
+#endif  // MIR2_GATEWAY_ROUTE_TABLE_H
@@ -0,0 +1,325 @@
+#include "gateway/service_link_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <asio/post.hpp>
+#include <asio/steady_timer.hpp>
+
+#include "common/internal_message_helper.h"
+#include "log/logger.h"
+#include "monitor/metrics.h"
+
+namespace mir2::gateway {
+
+namespace {
+
+uint64_t Mix64(uint64_t value) {
+  // splitmix64 终混：连续的 client_id 在环上均匀分布
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+const char* ServiceName(common::ServiceType service) {
+  switch (service) {
+    case common::ServiceType::kWorld:
+      return "world";
+    case common::ServiceType::kGame:
+      return "game";
+    case common::ServiceType::kDb:
+      return "db";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+ServiceLinkPool::ServiceLinkPool(asio::io_context& io_context, common::ServiceType service)
+    : io_context_(io_context),
+      name_(ServiceName(service)),
+      failover_metric_("gateway.link." + name_ + ".failover"),
+      connected_metric_("gateway.link." + name_ + ".connected"),
+      service_connected_metric_("gateway.service.connected." + name_),
+      service_disconnected_metric_("gateway.service.disconnected." + name_) {}
+
+ServiceLinkPool::~ServiceLinkPool() {
+  Close();
+}
+
+void ServiceLinkPool::Start(const std::string& host, uint16_t port, size_t link_count) {
+  host_ = host;
+  port_ = port;
+  const size_t first = links_.size();
+  for (size_t i = 0; i < std::max<size_t>(link_count, 1); ++i) {
+    auto client = std::make_unique<network::TcpClient>(io_context_);
+    client->SetRoutedBatchBytes(routed_batch_bytes_);
+    links_.push_back(MakeLink(std::move(client)));
+  }
+  RebuildRing();
+
+  for (size_t index = first; index < links_.size(); ++index) {
+    asio::post(io_context_, [this, index]() {
+      if (!closed_.load()) {
+        ConnectLink(index, 0);
+      }
+    });
+  }
+}
+
+void ServiceLinkPool::AdoptLink(std::unique_ptr<network::TcpClient> client) {
+  if (!client) {
+    return;
+  }
+  client->SetRoutedBatchBytes(routed_batch_bytes_);
+  links_.push_back(MakeLink(std::move(client)));
+  RebuildRing();
+}
+
+std::unique_ptr<ServiceLinkPool::Link> ServiceLinkPool::MakeLink(
+    std::unique_ptr<network::TcpClient> client) const {
+  auto link = std::make_unique<Link>();
+  link->client = std::move(client);
+  const std::string prefix = "gateway.link." + name_ + "." + std::to_string(links_.size());
+  link->metrics.load = prefix + ".load";
+  link->metrics.overload = prefix + ".overload";
+  link->metrics.queue_bytes = prefix + ".queue_bytes";
+  link->metrics.backlog_ms = prefix + ".backlog_ms";
+  link->metrics.disconnected = prefix + ".disconnected";
+  return link;
+}
+
+void ServiceLinkPool::Close() {
+  closed_.store(true);
+  for (const auto& link : links_) {
+    if (link->client) {
+      link->client->Close();
+    }
+  }
+}
+
+bool ServiceLinkPool::IsConnected() const {
+  return std::any_of(links_.begin(), links_.end(), [](const std::unique_ptr<Link>& link) {
+    return link->client && link->client->IsConnected();
+  });
+}
+
+network::TcpClient* ServiceLinkPool::GetLink(size_t index) const {
+  return index < links_.size() ? links_[index]->client.get() : nullptr;
+}
+
+size_t ServiceLinkPool::SelectLink(uint64_t client_id) const {
+  if (ring_.empty()) {
+    return 0;
+  }
+  const uint64_t hash = Mix64(client_id);
+  const auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(hash, uint32_t{0}));
+  return it == ring_.end() ? ring_.front().second : it->second;
+}
+
+bool ServiceLinkPool::Send(uint64_t client_id, uint16_t msg_id, const std::vector<uint8_t>& payload) {
+  auto* client = PickLink(client_id);
+  if (!client) {
+    return false;
+  }
+  client->Send(msg_id, payload);
+  return true;
+}
+
+bool ServiceLinkPool::SendRouted(uint64_t client_id, uint16_t msg_id,
+                                 std::span<const uint8_t> payload) {
+  auto* client = PickLink(client_id);
+  if (!client) {
+    return false;
+  }
+  client->SendRouted(client_id, msg_id, payload);
+  return true;
+}
+
+void ServiceLinkPool::Flush() {
+  if (routed_batch_bytes_ == 0) {
+    return;
+  }
+  for (const auto& link : links_) {
+    if (link->client) {
+      link->client->Flush();
+    }
+  }
+}
+
+void ServiceLinkPool::UpdateLoad(int64_t now_ms) {
+  if (overload_queue_bytes_ == 0) {
+    return;
+  }
+  for (size_t index = 0; index < links_.size(); ++index) {
+    auto& link = *links_[index];
+    const size_t queued = link.client ? link.client->GetQueuedBytes() : 0;
+    if (queued == 0) {
+      link.backlog_since_ms = 0;
+    } else if (link.backlog_since_ms == 0) {
+      link.backlog_since_ms = now_ms;
+    }
+    const int64_t backlog_ms = link.backlog_since_ms == 0 ? 0 : now_ms - link.backlog_since_ms;
+    link.backlog_ms = backlog_ms;
+
+    LinkLoad load = LinkLoad::kNormal;
+    if (queued >= overload_queue_bytes_ * 2 ||
+        (overload_backlog_ms_ > 0 && backlog_ms >= overload_backlog_ms_ * 2)) {
+      load = LinkLoad::kOverloaded;
+    } else if (queued >= overload_queue_bytes_ ||
+               (overload_backlog_ms_ > 0 && backlog_ms >= overload_backlog_ms_)) {
+      load = LinkLoad::kBusy;
+    }
+
+    const LinkLoad previous = link.load.exchange(load, std::memory_order_relaxed);
+    if (previous != load) {
+      SYSLOG_WARN("Service {} link {} load {} -> {} (queued={} backlog_ms={})", name_, index,
+                  static_cast<int>(previous), static_cast<int>(load), queued, backlog_ms);
+      monitor::Metrics::Instance().SetGauge(link.metrics.load, static_cast<int64_t>(load));
+      if (previous == LinkLoad::kNormal) {
+        link.overloads.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+LinkLoad ServiceLinkPool::GetLoad(uint64_t client_id) const {
+  bool failed_over = false;
+  const Link* link = ResolveLink(client_id, &failed_over);
+  return link ? link->load.load(std::memory_order_relaxed) : LinkLoad::kNormal;
+}
+
+void ServiceLinkPool::ReportMetrics() const {
+  int64_t connected = 0;
+  uint64_t failovers = 0;
+  for (const auto& link : links_) {
+    failovers += link->failovers.exchange(0, std::memory_order_relaxed);
+    if (const uint64_t overloads = link->overloads.exchange(0, std::memory_order_relaxed)) {
+      monitor::Metrics::Instance().AddCounter(link->metrics.overload, overloads);
+    }
+    const auto* client = link->client.get();
+    if (!client) {
+      continue;
+    }
+    if (client->IsConnected()) {
+      ++connected;
+    }
+    monitor::Metrics::Instance().SetGauge(link->metrics.queue_bytes,
+                                          static_cast<int64_t>(client->GetQueuedBytes()));
+    if (overload_queue_bytes_ > 0) {
+      monitor::Metrics::Instance().SetGauge(link->metrics.backlog_ms, link->backlog_ms);
+    }
+  }
+  if (failovers > 0) {
+    monitor::Metrics::Instance().AddCounter(failover_metric_, failovers);
+  }
+  monitor::Metrics::Instance().SetGauge(connected_metric_, connected);
+}
+
+void ServiceLinkPool::ConnectLink(size_t index, int retry_count) {
+  auto* client = links_[index]->client.get();
+  client->SetPacketHandler([this](const network::PacketView& packet) {
+    if (packet_handler_) {
+      packet_handler_(packet);
+    }
+  });
+  client->SetDisconnectHandler([this, index]() {
+    if (closed_.load()) {
+      return;
+    }
+    SYSLOG_ERROR("Service {} link {} disconnected, scheduling reconnect", name_, index);
+    monitor::Metrics::Instance().IncrementCounter(links_[index]->metrics.disconnected);
+    ScheduleReconnect(index, 0);
+  });
+
+  if (!client->Connect(host_, port_)) {
+    SYSLOG_ERROR("Failed to connect service {} link {} ({}:{})", name_, index, host_, port_);
+    monitor::Metrics::Instance().IncrementCounter(service_disconnected_metric_);
+    ScheduleReconnect(index, retry_count);
+    return;
+  }
+  monitor::Metrics::Instance().IncrementCounter(service_connected_metric_);
+  client->Send(static_cast<uint16_t>(common::InternalMsgId::kServiceHello),
+               common::BuildServiceHello(common::ServiceType::kGateway));
+  if (retry_count > 0) {
+    SYSLOG_INFO("Reconnected to service {} link {}", name_, index);
+  }
+}
+
+void ServiceLinkPool::ScheduleReconnect(size_t index, int retry_count) {
+  {
+    std::lock_guard<std::mutex> lock(reconnect_mutex_);
+    if (links_[index]->reconnecting) {
+      return;
+    }
+    links_[index]->reconnecting = true;
+  }
+
+  const int capped_retry = std::min(retry_count, 5);
+  const int delay_ms = std::min(1000 * (1 << capped_retry), 30000);
+  SYSLOG_INFO("Scheduling reconnect to service {} link {} in {}ms (retry={})", name_, index,
+              delay_ms, retry_count);
+
+  auto timer = std::make_shared<asio::steady_timer>(io_context_,
+                                                    std::chrono::milliseconds(delay_ms));
+  timer->async_wait([this, index, retry_count, timer](const asio::error_code& ec) {
+    {
+      std::lock_guard<std::mutex> lock(reconnect_mutex_);
+      links_[index]->reconnecting = false;
+    }
+    if (ec || closed_.load()) {
+      return;
+    }
+    ConnectLink(index, retry_count + 1);
+  });
+}
+
+void ServiceLinkPool::RebuildRing() {
+  ring_.clear();
+  ring_.reserve(links_.size() * kVirtualNodesPerLink);
+  for (uint32_t index = 0; index < links_.size(); ++index) {
+    for (uint32_t node = 0; node < kVirtualNodesPerLink; ++node) {
+      ring_.emplace_back(Mix64((static_cast<uint64_t>(index) << 32) | node), index);
+    }
+  }
+  std::sort(ring_.begin(), ring_.end());
+}
+
+ServiceLinkPool::Link* ServiceLinkPool::ResolveLink(uint64_t client_id, bool* failed_over) const {
+  *failed_over = false;
+  if (ring_.empty()) {
+    return nullptr;
+  }
+  const uint64_t hash = Mix64(client_id);
+  const size_t start = static_cast<size_t>(
+      std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(hash, uint32_t{0})) -
+      ring_.begin());
+  const uint32_t owner = ring_[start % ring_.size()].second;
+  // 沿环顺延：归属链路断开时只有它的客户端迁移到下一条链路
+  for (size_t step = 0; step < ring_.size(); ++step) {
+    const uint32_t index = ring_[(start + step) % ring_.size()].second;
+    Link* link = links_[index].get();
+    if (link->client && link->client->IsConnected()) {
+      *failed_over = index != owner;
+      return link;
+    }
+  }
+  return nullptr;
+}
+
+network::TcpClient* ServiceLinkPool::PickLink(uint64_t client_id) {
+  bool failed_over = false;
+  Link* link = ResolveLink(client_id, &failed_over);
+  if (!link) {
+    return nullptr;
+  }
+  if (failed_over) {
+    // 转发热路径只做原子累加，由 ReportMetrics 按周期汇总上报
+    link->failovers.fetch_add(1, std::memory_order_relaxed);
+  }
+  return link->client.get();
+}
+
+}  // namespace mir2::gateway
@@ -0,0 +1,200 @@
+/**
+ * @file service_link_pool.h
+ * @brief 网关到后端服务的并行链路池
+ */
+
+#ifndef MIR2_GATEWAY_SERVICE_LINK_POOL_H
+#define MIR2_GATEWAY_SERVICE_LINK_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <asio/io_context.hpp>
+
+#include "common/enums.h"
+#include "network/tcp_client.h"
+
+namespace mir2::gateway {
+
+/**
+ * @brief 链路负载等级
+ */
+enum class LinkLoad : uint8_t {
+  kNormal = 0,
+  kBusy = 1,        // 积压超过阈值：削减低优先级消息
+  kOverloaded = 2,  // 积压超过两倍阈值：只放行关键消息
+};
+
+/**
+ * @brief 后端服务链路池
+ *
+ * 对同一后端服务维持 N 条并行 TCP 链路，按 client_id 的一致性哈希选路：
+ * 同一客户端的消息始终走同一条链路（保持顺序），一条链路上的慢响应只阻塞
+ * 哈希到它的客户端。链路断开时其客户端顺延到哈希环上的下一条已连接链路，
+ * 其余客户端的归属不变；每条链路独立退避重连。
+ *
+ * 链路集合在 Start / AdoptLink 之后固定，Send 可在任意线程调用。
+ *
+ * 过载判定：UpdateLoad（网关 Tick 调用）按每条链路的发送队列字节数与积压持续时间
+ * （队列自非空起经过的时间，近似后端处理延迟）计算负载等级；转发路径经 GetLoad
+ * 读取，只是一次原子加载。
+ */
+class ServiceLinkPool {
+ public:
+  using PacketHandler = network::TcpClient::PacketHandler;
+
+  ServiceLinkPool(asio::io_context& io_context, common::ServiceType service);
+  ~ServiceLinkPool();
+
+  ServiceLinkPool(const ServiceLinkPool&) = delete;
+  ServiceLinkPool& operator=(const ServiceLinkPool&) = delete;
+
+  /**
+   * @brief 设置回包处理（所有链路共用，须在 Start 之前设置）
+   */
+  void SetPacketHandler(PacketHandler handler) { packet_handler_ = std::move(handler); }
+
+  /**
+   * @brief 路由帧攒批上限（字节，0 表示逐条发送；须在 Start / AdoptLink 之前设置）
+   */
+  void SetRoutedBatchBytes(size_t limit_bytes) { routed_batch_bytes_ = limit_bytes; }
+
+  /**
+   * @brief 过载阈值：队列字节数或积压毫秒数达到阈值为 kBusy，达到两倍为 kOverloaded
+   *
+   * queue_bytes 为 0 表示关闭过载判定。
+   */
+  void SetOverloadLimits(size_t queue_bytes, int64_t backlog_ms) {
+    overload_queue_bytes_ = queue_bytes;
+    overload_backlog_ms_ = backlog_ms;
+  }
+
+  /**
+   * @brief 按各链路当前积压刷新负载等级（只在网关逻辑线程调用）
+   */
+  void UpdateLoad(int64_t now_ms);
+
+  /**
+   * @brief client_id 实际发送所用链路的负载等级
+   *
+   * 与 Send 走同一套选路（归属链路断开时顺延到的链路），全部断开时为 kNormal。
+   */
+  LinkLoad GetLoad(uint64_t client_id) const;
+
+  /**
+   * @brief 建立 link_count 条链路（在 io_context 上异步连接，失败的链路各自重连）
+   */
+  void Start(const std::string& host, uint16_t port, size_t link_count);
+
+  /**
+   * @brief 接管一条已建立的客户端连接（不参与重连）
+   */
+  void AdoptLink(std::unique_ptr<network::TcpClient> client);
+
+  /**
+   * @brief 关闭所有链路并停止重连
+   */
+  void Close();
+
+  /**
+   * @brief 是否至少有一条链路已连接
+   */
+  bool IsConnected() const;
+
+  size_t GetLinkCount() const { return links_.size(); }
+  network::TcpClient* GetLink(size_t index) const;
+
+  /**
+   * @brief client_id 在哈希环上的归属链路（不考虑连接状态）
+   */
+  size_t SelectLink(uint64_t client_id) const;
+
+  /**
+   * @brief 经 client_id 归属的链路发送；归属链路断开时顺延，全部断开返回 false
+   */
+  bool Send(uint64_t client_id, uint16_t msg_id, const std::vector<uint8_t>& payload);
+
+  /**
+   * @brief 以定长路由信封转发 client_id 的客户端消息，选路规则同 Send
+   */
+  bool SendRouted(uint64_t client_id, uint16_t msg_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief 写出各链路积攒的路由批次（网关 Tick 末尾调用）
+   */
+  void Flush();
+
+  /**
+   * @brief 上报每条链路的发送队列深度、积压时长与连接状态
+   *
+   * 顺延与过载次数平时只累加在各链路的原子计数上，在这里一次性计入指标。
+   */
+  void ReportMetrics() const;
+
+ private:
+  static constexpr size_t kVirtualNodesPerLink = 64;
+
+  /**
+   * @brief 每条链路的指标名（建链时生成一次，上报路径不再拼接字符串）
+   */
+  struct LinkMetricNames {
+    std::string load;
+    std::string overload;
+    std::string queue_bytes;
+    std::string backlog_ms;
+    std::string disconnected;
+  };
+
+  struct Link {
+    std::unique_ptr<network::TcpClient> client;
+    bool reconnecting = false;
+    std::atomic<LinkLoad> load{LinkLoad::kNormal};
+    int64_t backlog_since_ms = 0;  // 发送队列变为非空的时刻，0 表示队列为空
+    int64_t backlog_ms = 0;        // 最近一次 UpdateLoad 时的积压时长（均只在网关逻辑线程访问）
+    std::atomic<uint64_t> failovers{0};  // 自上次 ReportMetrics 以来顺延到本链路的消息数
+    std::atomic<uint64_t> overloads{0};  // 自上次 ReportMetrics 以来离开 kNormal 的次数
+    LinkMetricNames metrics;
+  };
+
+  void ConnectLink(size_t index, int retry_count);
+  void ScheduleReconnect(size_t index, int retry_count);
+  void RebuildRing();
+  std::unique_ptr<Link> MakeLink(std::unique_ptr<network::TcpClient> client) const;
+
+  /**
+   * @brief 沿哈希环找到 client_id 当前可用的链路；failed_over 表示是否偏离了归属链路
+   */
+  Link* ResolveLink(uint64_t client_id, bool* failed_over) const;
+  network::TcpClient* PickLink(uint64_t client_id);
+
+  asio::io_context& io_context_;
+  std::string name_;
+  std::string failover_metric_;
+  std::string connected_metric_;
+  std::string service_connected_metric_;
+  std::string service_disconnected_metric_;
+  std::string host_;
+  uint16_t port_ = 0;
+  size_t routed_batch_bytes_ = 0;
+  size_t overload_queue_bytes_ = 0;
+  int64_t overload_backlog_ms_ = 0;
+  PacketHandler packet_handler_;
+  std::vector<std::unique_ptr<Link>> links_;
+  // (哈希值, 链路下标)，按哈希值升序
+  std::vector<std::pair<uint64_t, uint32_t>> ring_;
+  std::atomic<bool> closed_{false};
+  // 保护各链路的 reconnecting 标志
+  std::mutex reconnect_mutex_;
+};
+
+}  // namespace mir2::gateway
+
+#endif  // MIR2_GATEWAY_SERVICE_LINK_POOL_H
@@ -19,11 +19,15 @@ namespace legend2::handlers {
 
 /**
  * @brief 单条响应消息
+ *
+ * recipients 非空时为组播：同一负载发往 recipients 中的每个客户端（client_id 不使用），
+ * 经网关转发时只携带一份负载。
  */
 struct HandlerResponse {
     uint64_t client_id = 0;
     uint16_t msg_id = 0;
     std::vector<uint8_t> payload;
+    std::vector<uint64_t> recipients;
 };
 
 using ResponseList = std::vector<HandlerResponse>;
@@ -132,10 +132,11 @@ void ChatHandler::HandleChat(const HandlerContext& context,
         targets = client_registry_.GetAll();
     }
 
-    const auto chat_payload = BuildChatMessage(
-        channel, context.client_id, from_name, target_id, content, NowSeconds());
-    for (const auto client_id : targets) {
-        responses.push_back({client_id, message_type, chat_payload});
+    if (!targets.empty()) {
+        responses.push_back({0, message_type,
+                             BuildChatMessage(channel, context.client_id, from_name, target_id,
+                                              content, NowSeconds()),
+                             std::move(targets)});
     }
 
     if (callback) {
@@ -1,28 +1,107 @@
 #include "handlers/client_registry.h"
 
+#include <mutex>
+
+#include "network/tcp_session.h"
+
 namespace legend2::handlers {
 
 void ClientRegistry::Track(uint64_t client_id) {
     if (client_id == 0) {
         return;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    clients_.insert(client_id);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    clients_.try_emplace(client_id);
+}
+
+void ClientRegistry::Track(uint64_t client_id,
+                           const std::shared_ptr<mir2::network::TcpSession>& gateway,
+                           bool framed) {
+    if (client_id == 0) {
+        return;
+    }
+    {
+        // 绝大多数路由消息来自同一网关，读锁命中即可返回
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const auto it = clients_.find(client_id);
+        if (it != clients_.end() && it->second.framed == framed &&
+            !it->second.gateway.owner_before(gateway) &&
+            !gateway.owner_before(it->second.gateway)) {
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    clients_[client_id] = Entry{gateway, framed};
 }
 
 void ClientRegistry::Remove(uint64_t client_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     clients_.erase(client_id);
 }
 
+std::size_t ClientRegistry::RemoveGateway(
+    const std::shared_ptr<mir2::network::TcpSession>& gateway) {
+    if (!gateway) {
+        return 0;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return std::erase_if(clients_, [&gateway](const auto& entry) {
+        const GatewayRef& owner = entry.second.gateway;
+        const bool same = !owner.owner_before(gateway) && !gateway.owner_before(owner);
+        return same || IsStale(owner);
+    });
+}
+
 std::vector<uint64_t> ClientRegistry::GetAll() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return std::vector<uint64_t>(clients_.begin(), clients_.end());
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<uint64_t> ids;
+    ids.reserve(clients_.size());
+    for (const auto& [client_id, gateway] : clients_) {
+        ids.push_back(client_id);
+    }
+    return ids;
 }
 
 bool ClientRegistry::Contains(uint64_t client_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return clients_.find(client_id) != clients_.end();
 }
 
+std::shared_ptr<mir2::network::TcpSession> ClientRegistry::GetGateway(uint64_t client_id,
+                                                                  bool* framed) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const auto it = clients_.find(client_id);
+        if (it == clients_.end()) {
+            return nullptr;
+        }
+        auto gateway = it->second.gateway.lock();
+        if (gateway) {
+            if (gateway->GetState() != mir2::network::TcpSession::SessionState::kActive) {
+                return nullptr;
+            }
+            if (framed) {
+                *framed = it->second.framed;
+            }
+            return gateway;
+        }
+        if (!IsStale(it->second.gateway)) {
+            return nullptr;
+        }
+    }
+    // 网关会话已释放：升级为写锁后复核再移除，期间可能已被重新登记到新网关
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const auto it = clients_.find(client_id);
+    if (it != clients_.end() && IsStale(it->second.gateway)) {
+        clients_.erase(it);
+    }
+    return nullptr;
+}
+
+bool ClientRegistry::IsStale(const GatewayRef& gateway) {
+    const GatewayRef never_set;
+    const bool was_set = gateway.owner_before(never_set) || never_set.owner_before(gateway);
+    return was_set && gateway.expired();
+}
+
 }  // namespace legend2::handlers
@@ -6,26 +6,65 @@
 #ifndef LEGEND2_SERVER_HANDLERS_CLIENT_REGISTRY_H
 #define LEGEND2_SERVER_HANDLERS_CLIENT_REGISTRY_H
 
+#include <cstddef>
 #include <cstdint>
-#include <mutex>
-#include <unordered_set>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
+namespace mir2::network {
+class TcpSession;
+}  // namespace mir2::network
+
 namespace legend2::handlers {
 
 /**
- * @brief 记录已知客户端
+ * @brief 记录已知客户端及其所属网关会话
+ *
+ * 后端从网关转发的路由消息中学习 client_id -> 网关会话，下行消息只发往该网关。
+ * 网关会话以弱引用保存：网关断开时由 RemoveGateway 清除其全部客户端，
+ * 漏掉的条目在 GetGateway 发现会话已释放时移除。
  */
 class ClientRegistry {
 public:
     void Track(uint64_t client_id);
+    /**
+     * @brief 记录 client_id 所属网关及该网关使用的路由格式（framed 为定长路由帧，否则为旧版 RoutedMessage）
+     */
+    void Track(uint64_t client_id, const std::shared_ptr<mir2::network::TcpSession>& gateway,
+               bool framed = true);
     void Remove(uint64_t client_id);
+
+    /**
+     * @brief 网关会话断开：移除经该网关登记的客户端（以及会话已释放的条目）
+     * @return 移除的客户端数
+     */
+    std::size_t RemoveGateway(const std::shared_ptr<mir2::network::TcpSession>& gateway);
     std::vector<uint64_t> GetAll() const;
     bool Contains(uint64_t client_id) const;
 
+    /**
+     * @brief client_id 所属的网关会话；未知或会话已关闭时返回空，会话已释放时顺带移除该条目
+     * @param framed 非空时写入该网关是否使用定长路由帧
+     */
+    std::shared_ptr<mir2::network::TcpSession> GetGateway(uint64_t client_id,
+                                                          bool* framed = nullptr) const;
+
 private:
-    mutable std::mutex mutex_;
-    std::unordered_set<uint64_t> clients_;
+    using GatewayRef = std::weak_ptr<mir2::network::TcpSession>;
+
+    struct Entry {
+        GatewayRef gateway;
+        bool framed = true;
+    };
+
+    /// 登记过网关且该网关会话已释放（仅 Track(client_id) 登记的条目不算）
+    static bool IsStale(const GatewayRef& gateway);
+
+    mutable std::shared_mutex mutex_;
+    // GetGateway 为 const 查询，但需要顺带清理已释放网关的条目
+    mutable std::unordered_map<uint64_t, Entry> clients_;
 };
 
 }  // namespace legend2::handlers
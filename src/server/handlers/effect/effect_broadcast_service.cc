@@ -4,9 +4,11 @@
 
 #include "combat_generated.h"
 #include "common/enums.h"
-#include "common/internal_message_helper.h"
 #include "ecs/components/character_components.h"
 #include "game/map/aoi_manager.h"
+#include "handlers/client_registry.h"
+#include "handlers/routed_responses.h"
+#include "monitor/metrics.h"
 #include "network/network_manager.h"
 
 #include <entt/entt.hpp>
@@ -15,10 +17,12 @@ namespace legend2::handlers {
 
 EffectBroadcastService::EffectBroadcastService(mir2::network::NetworkManager& network,
                                                mir2::game::map::AOIManager& aoi_manager,
-                                               entt::registry& registry)
+                                               entt::registry& registry,
+                                               const ClientRegistry& clients)
     : network_(network),
       aoi_manager_(aoi_manager),
-      registry_(registry) {}
+      registry_(registry),
+      clients_(clients) {}
 
 void EffectBroadcastService::BroadcastSkillEffect(uint64_t caster_id, uint64_t target_id,
                                                   uint32_t skill_id, uint8_t effect_type,
@@ -43,8 +47,8 @@ void EffectBroadcastService::BroadcastSkillEffect(uint64_t caster_id, uint64_t t
     const std::vector<uint8_t> payload(data, data + builder.GetSize());
 
     const uint16_t msg_id = static_cast<uint16_t>(mir2::common::MsgId::kSkillEffect);
-    const uint16_t routed_msg_id = static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedMessage);
-    const auto sessions = network_.GetAllSessions();
+    // 经网关转发的观察者攒成一条组播，每个网关只收到一份负载
+    std::vector<uint64_t> routed_viewers;
 
     for (uint64_t entity_id : viewers) {
         const entt::entity entity = static_cast<entt::entity>(entity_id);
@@ -62,16 +66,25 @@ void EffectBroadcastService::BroadcastSkillEffect(uint64_t caster_id, uint64_t t
             continue;
         }
 
-        if (sessions.empty()) {
+        routed_viewers.push_back(client_id);
+    }
+    if (routed_viewers.empty()) {
+        return;
+    }
+
+    std::vector<uint64_t> unknown;
+    MulticastByGateway(clients_, routed_viewers, msg_id, payload, &unknown);
+    if (unknown.empty()) {
+        return;
+    }
+    // 所属网关未知时退回全部广播；网关格式未知，使用新旧网关都能解析的旧版 RoutedMessage
+    mir2::monitor::Metrics::Instance().AddCounter("game.broadcast.gateway_unknown", unknown.size());
+    for (const auto& session : network_.GetAllSessions()) {
+        if (!session) {
             continue;
         }
-
-        const auto routed_payload = mir2::common::BuildRoutedMessage(client_id, msg_id, payload);
-        for (const auto& session : sessions) {
-            if (!session) {
-                continue;
-            }
-            network_.Send(session->GetSessionId(), routed_msg_id, routed_payload);
+        for (const uint64_t client_id : unknown) {
+            SendRoutedTo(*session, client_id, msg_id, payload, false);
         }
     }
 }
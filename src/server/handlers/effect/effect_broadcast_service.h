@@ -21,6 +21,8 @@ class AOIManager;
 
 namespace legend2::handlers {
 
+class ClientRegistry;
+
 /**
  * @brief Service for broadcasting skill effects.
  */
@@ -28,7 +30,8 @@ class EffectBroadcastService {
 public:
     EffectBroadcastService(mir2::network::NetworkManager& network,
                            mir2::game::map::AOIManager& aoi_manager,
-                           entt::registry& registry);
+                           entt::registry& registry,
+                           const ClientRegistry& clients);
 
     void BroadcastSkillEffect(uint64_t caster_id, uint64_t target_id, uint32_t skill_id,
                               uint8_t effect_type, const std::string& effect_id,
@@ -39,6 +42,7 @@ private:
     mir2::network::NetworkManager& network_;
     mir2::game::map::AOIManager& aoi_manager_;
     entt::registry& registry_;
+    const ClientRegistry& clients_;
 };
 
 }  // namespace legend2::handlers
@@ -8,15 +8,17 @@
 
 #include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 #include "handlers/base_handler.h"
+#include "server/common/msg_id_table.h"
 
 namespace legend2::handlers {
 
 /**
  * @brief Handler注册与分发
+ *
+ * 按 msg_id 直接索引；注册须在服务开始监听之前完成，此后表只读，分发无需加锁。
  */
 class HandlerRegistry {
 public:
@@ -28,7 +30,7 @@ public:
                   ResponseCallback callback) const;
 
 private:
-    std::unordered_map<uint16_t, std::shared_ptr<IMessageHandler>> handlers_;
+    mir2::common::MsgIdTable<std::shared_ptr<IMessageHandler>> handlers_;
 };
 
 }  // namespace legend2::handlers
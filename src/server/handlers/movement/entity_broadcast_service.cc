@@ -11,12 +11,14 @@
 #include <flatbuffers/flatbuffers.h>
 
 #include "common/enums.h"
-#include "common/internal_message_helper.h"
 #include "ecs/components/character_components.h"
 #include "ecs/components/monster_component.h"
 #include "ecs/components/npc_component.h"
 #include "game/npc/npc_manager.h"
 #include "game_generated.h"
+#include "handlers/client_registry.h"
+#include "handlers/routed_responses.h"
+#include "monitor/metrics.h"
 #include "network/network_manager.h"
 
 namespace legend2::handlers {
@@ -40,9 +42,11 @@ uint16_t ClampLevel(int level) {
 }  // namespace
 
 EntityBroadcastService::EntityBroadcastService(mir2::network::NetworkManager& network,
-                                               entt::registry& registry)
+                                               entt::registry& registry,
+                                               const ClientRegistry& clients)
     : network_(network),
-      registry_(registry) {}
+      registry_(registry),
+      clients_(clients) {}
 
 void EntityBroadcastService::HandleAOIEvent(mir2::game::map::AOIEventType event_type,
                                             entt::entity watcher,
@@ -205,20 +209,27 @@ void EntityBroadcastService::SendToClient(uint64_t client_id,
     return;
   }
 
+  // 只发往客户端所属的网关，并沿用该网关请求所用的路由格式（兼容未升级的网关）
+  bool framed = true;
+  if (const auto gateway = clients_.GetGateway(client_id, &framed)) {
+    SendRoutedTo(*gateway, client_id, msg_id, payload, framed);
+    return;
+  }
+  mir2::monitor::Metrics::Instance().IncrementCounter("game.broadcast.gateway_unknown");
+
+  // 尚未从任何网关收到该客户端的消息时退回全部广播；网关格式未知，
+  // 使用新旧网关都能解析的旧版 RoutedMessage
+
   const auto sessions = network_.GetAllSessions();
   if (sessions.empty()) {
     return;
   }
 
-  const auto routed_payload = mir2::common::BuildRoutedMessage(client_id, msg_id, payload);
-  const uint16_t routed_msg_id =
-      static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedMessage);
-
   for (const auto& session : sessions) {
     if (!session) {
       continue;
     }
-    network_.Send(session->GetSessionId(), routed_msg_id, routed_payload);
+    SendRoutedTo(*session, client_id, msg_id, payload, false);
   }
 }
 
@@ -25,13 +25,16 @@ enum class EntityType : uint8_t;
 
 namespace legend2::handlers {
 
+class ClientRegistry;
+
 /**
  * @brief Broadcast AOI enter/leave events to clients.
  */
 class EntityBroadcastService {
  public:
   EntityBroadcastService(mir2::network::NetworkManager& network,
-                         entt::registry& registry);
+                         entt::registry& registry,
+                         const ClientRegistry& clients);
 
   void HandleAOIEvent(mir2::game::map::AOIEventType event_type,
                       entt::entity watcher,
@@ -56,6 +59,7 @@ class EntityBroadcastService {
 
   mir2::network::NetworkManager& network_;
   entt::registry& registry_;
+  const ClientRegistry& clients_;
 };
 
 }  // namespace legend2::handlers
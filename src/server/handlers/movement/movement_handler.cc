@@ -255,11 +255,12 @@ void MovementHandler::HandleMove(const HandlerContext& context,
                          BuildMoveRsp(result, x, y)});
 
     if (result == mir2::common::ErrorCode::kOk && should_broadcast) {
-        const auto broadcast_payload = BuildEntityMove(context.client_id, x, y, 0);
-        for (const auto client_id : client_registry_.GetAll()) {
-            responses.push_back({client_id,
+        auto recipients = client_registry_.GetAll();
+        if (!recipients.empty()) {
+            responses.push_back({0,
                                  static_cast<uint16_t>(mir2::common::MsgId::kEntityMove),
-                                 broadcast_payload});
+                                 BuildEntityMove(context.client_id, x, y, 0),
+                                 std::move(recipients)});
         }
     }
 
@@ -0,0 +1,117 @@
+#include "handlers/routed_responses.h"
+
+#include <utility>
+#include <vector>
+
+#include "common/enums.h"
+#include "common/internal_message_helper.h"
+#include "handlers/client_registry.h"
+
+namespace legend2::handlers {
+
+namespace {
+
+void SendLegacy(mir2::network::TcpSession& session, uint64_t client_id, uint16_t msg_id,
+                std::span<const uint8_t> payload) {
+    const auto routed = mir2::common::BuildRoutedMessage(client_id, msg_id, payload);
+    session.Send(static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedMessage), routed);
+}
+
+void SendMulticast(const std::shared_ptr<mir2::network::TcpSession>& session,
+                   const HandlerResponse& response,
+                   const ClientRegistry* clients) {
+    if (!clients) {
+        session->SendRoutedMulticast(response.recipients, response.msg_id, response.payload);
+        return;
+    }
+    // 所属网关未知的接收者交给发来请求的网关
+    std::vector<uint64_t> unknown;
+    MulticastByGateway(*clients, response.recipients, response.msg_id, response.payload, &unknown);
+    if (!unknown.empty()) {
+        session->SendRoutedMulticast(unknown, response.msg_id, response.payload);
+    }
+}
+
+}  // namespace
+
+void SendRoutedTo(mir2::network::TcpSession& gateway,
+                  uint64_t client_id,
+                  uint16_t msg_id,
+                  std::span<const uint8_t> payload,
+                  bool framed) {
+    if (framed) {
+        gateway.SendRouted(client_id, msg_id, payload);
+        return;
+    }
+    SendLegacy(gateway, client_id, msg_id, payload);
+}
+
+void MulticastByGateway(const ClientRegistry& clients,
+                        std::span<const uint64_t> client_ids,
+                        uint16_t msg_id,
+                        std::span<const uint8_t> payload,
+                        std::vector<uint64_t>* out_unknown) {
+    struct Group {
+        std::shared_ptr<mir2::network::TcpSession> gateway;
+        bool framed = true;
+        std::vector<uint64_t> recipients;
+    };
+    // 网关数量很少，线性查找分组即可
+    std::vector<Group> groups;
+    for (const uint64_t client_id : client_ids) {
+        bool framed = true;
+        auto gateway = clients.GetGateway(client_id, &framed);
+        if (!gateway) {
+            if (out_unknown) {
+                out_unknown->push_back(client_id);
+            }
+            continue;
+        }
+        auto it = groups.begin();
+        while (it != groups.end() && it->gateway != gateway) {
+            ++it;
+        }
+        if (it == groups.end()) {
+            groups.push_back(Group{std::move(gateway), framed, {}});
+            it = groups.end() - 1;
+        }
+        it->recipients.push_back(client_id);
+    }
+    for (const auto& group : groups) {
+        if (group.framed) {
+            group.gateway->SendRoutedMulticast(group.recipients, msg_id, payload);
+            continue;
+        }
+        for (const uint64_t client_id : group.recipients) {
+            SendLegacy(*group.gateway, client_id, msg_id, payload);
+        }
+    }
+}
+
+void SendRoutedResponses(const std::shared_ptr<mir2::network::TcpSession>& session,
+                         const ResponseList& responses,
+                         bool framed,
+                         const ClientRegistry* clients) {
+    if (!session) {
+        return;
+    }
+    for (const auto& response : responses) {
+        if (!framed) {
+            if (response.recipients.empty()) {
+                SendLegacy(*session, response.client_id, response.msg_id, response.payload);
+                continue;
+            }
+            for (const uint64_t client_id : response.recipients) {
+                SendLegacy(*session, client_id, response.msg_id, response.payload);
+            }
+            continue;
+        }
+        if (response.recipients.empty()) {
+            session->SendRouted(response.client_id, response.msg_id, response.payload);
+            continue;
+        }
+        SendMulticast(session, response, clients);
+    }
+}
+
+}  // namespace legend2::handlers
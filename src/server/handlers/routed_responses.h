@@ -0,0 +1,55 @@
+/**
+ * @file routed_responses.h
+ * @brief 经网关回送处理器响应
+ */
+
+#ifndef LEGEND2_SERVER_HANDLERS_ROUTED_RESPONSES_H
+#define LEGEND2_SERVER_HANDLERS_ROUTED_RESPONSES_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "handlers/base_handler.h"
+
+namespace legend2::handlers {
+
+class ClientRegistry;
+
+/**
+ * @brief 经网关会话回送响应
+ *
+ * framed 为 true 时使用定长路由帧，组播响应只发一份负载；为 false 时按旧版
+ * FlatBuffers RoutedMessage 逐个接收者展开，兼容未升级的网关。
+ * 提供 clients 时组播接收者按所属网关分组发送，所属网关未知的接收者经 session 发送。
+ */
+void SendRoutedResponses(const std::shared_ptr<mir2::network::TcpSession>& session,
+                         const ResponseList& responses,
+                         bool framed,
+                         const ClientRegistry* clients = nullptr);
+
+/**
+ * @brief 经网关向单个客户端发送：framed 为 true 时发定长路由帧，否则发旧版 RoutedMessage
+ */
+void SendRoutedTo(mir2::network::TcpSession& gateway,
+                  uint64_t client_id,
+                  uint16_t msg_id,
+                  std::span<const uint8_t> payload,
+                  bool framed);
+
+/**
+ * @brief 按接收者所属网关分组发送组播帧，每个网关一份负载
+ *
+ * 使用旧版格式的网关按接收者逐个发送 RoutedMessage。
+ * 所属网关未知的接收者不发送，追加到 out_unknown（可为空）。
+ */
+void MulticastByGateway(const ClientRegistry& clients,
+                        std::span<const uint64_t> client_ids,
+                        uint16_t msg_id,
+                        std::span<const uint8_t> payload,
+                        std::vector<uint64_t>* out_unknown);
+
+}  // namespace legend2::handlers
+
+#endif  // LEGEND2_SERVER_HANDLERS_ROUTED_RESPONSES_H
@@ -156,6 +156,10 @@ void Metrics::IncrementError(const std::string& reason) {
 }
 
 void Metrics::IncrementCounter(const std::string& name) {
+  AddCounter(name, 1);
+}
+
+void Metrics::AddCounter(const std::string& name, uint64_t value) {
   if (!registry_) {
     return;
   }
@@ -176,7 +180,7 @@ void Metrics::IncrementCounter(const std::string& name) {
   }
 
   if (counter) {
-    counter->Increment();
+    counter->Increment(static_cast<double>(value));
   }
 }
 
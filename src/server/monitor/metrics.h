@@ -48,6 +48,7 @@ class Metrics : public core::Singleton<Metrics> {
   void ObserveDispatchLatency(int64_t microseconds);
   void IncrementError(const std::string& reason);
   void IncrementCounter(const std::string& name);
+  void AddCounter(const std::string& name, uint64_t value);
   void SetGauge(const std::string& name, int64_t value);
 
   static constexpr const char* kConnections = "mir2_connections";
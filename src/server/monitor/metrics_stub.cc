@@ -15,6 +15,7 @@ void Metrics::IncrementMessagesReceived() {}
 void Metrics::ObserveDispatchLatency(int64_t) {}
 void Metrics::IncrementError(const std::string&) {}
 void Metrics::IncrementCounter(const std::string&) {}
+void Metrics::AddCounter(const std::string&, uint64_t) {}
 void Metrics::SetGauge(const std::string&, int64_t) {}
 
 }  // namespace mir2::monitor
@@ -0,0 +1,236 @@
+#include "network/buffer_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "monitor/metrics.h"
+
+namespace mir2::network {
+
+namespace {
+
+constexpr size_t kClassCount = BufferPool::kSizeClasses.size();
+// 每级线程缓存上限按字节折算，至少保留若干块以覆盖突发
+constexpr size_t kThreadCacheBytesPerClass = 256 * 1024;
+constexpr size_t kMinThreadCacheBlocks = 8;
+// 仓库容量为线程缓存上限的倍数
+constexpr size_t kDepotCacheMultiplier = 8;
+
+constexpr size_t ThreadCacheLimit(size_t size_class) {
+  return std::max(kMinThreadCacheBlocks,
+                  kThreadCacheBytesPerClass / BufferPool::kSizeClasses[size_class]);
+}
+
+constexpr size_t TransferBatch(size_t size_class) {
+  return ThreadCacheLimit(size_class) / 2;
+}
+
+struct PoolCounters {
+  std::atomic<uint64_t> heap_allocs{0};
+  std::atomic<uint64_t> heap_frees{0};
+  std::atomic<uint64_t> oversize_allocs{0};
+  std::atomic<uint64_t> depot_refills{0};
+  std::atomic<uint64_t> depot_flushes{0};
+};
+
+PoolCounters& Counters() {
+  static PoolCounters counters;
+  return counters;
+}
+
+/**
+ * @brief 全局仓库：各线程缓存之间批量搬运空闲块
+ */
+class Depot {
+ public:
+  ~Depot() {
+    for (auto& blocks : free_lists_) {
+      for (uint8_t* block : blocks) {
+        ::operator delete(block);
+      }
+    }
+  }
+
+  /**
+   * @brief 取出至多 count 块追加到 out
+   */
+  void Take(size_t size_class, size_t count, std::vector<uint8_t*>* out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& blocks = free_lists_[size_class];
+    const size_t take = std::min(count, blocks.size());
+    out->insert(out->end(), blocks.end() - static_cast<std::ptrdiff_t>(take), blocks.end());
+    blocks.resize(blocks.size() - take);
+  }
+
+  /**
+   * @brief 放入 in 末尾的 count 块；仓库满时多余块释放回堆
+   * @return 释放回堆的块数
+   */
+  size_t Put(size_t size_class, size_t count, std::vector<uint8_t*>* in) {
+    size_t freed = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& blocks = free_lists_[size_class];
+      const size_t limit = ThreadCacheLimit(size_class) * kDepotCacheMultiplier;
+      for (size_t i = 0; i < count; ++i) {
+        uint8_t* block = in->back();
+        in->pop_back();
+        if (blocks.size() < limit) {
+          blocks.push_back(block);
+        } else {
+          ::operator delete(block);
+          ++freed;
+        }
+      }
+    }
+    Counters().heap_frees.fetch_add(freed, std::memory_order_relaxed);
+    return freed;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kClassCount> free_lists_;
+};
+
+Depot& GlobalDepot() {
+  static Depot depot;
+  return depot;
+}
+
+// 线程缓存析构后（线程退出、静态析构阶段）仍可能有缓冲被释放，此时直接走堆
+thread_local bool t_cache_destroyed = false;
+
+/**
+ * @brief 线程缓存：无锁的各级空闲链表
+ */
+class ThreadCache {
+ public:
+  ThreadCache() : depot_(GlobalDepot()) {
+    for (size_t i = 0; i < kClassCount; ++i) {
+      free_lists_[i].reserve(ThreadCacheLimit(i));
+    }
+  }
+
+  ~ThreadCache() {
+    // 线程退出时把缓存交还仓库，供其他线程继续复用
+    for (size_t i = 0; i < kClassCount; ++i) {
+      depot_.Put(i, free_lists_[i].size(), &free_lists_[i]);
+    }
+    t_cache_destroyed = true;
+  }
+
+  uint8_t* Pop(size_t size_class) {
+    auto& blocks = free_lists_[size_class];
+    if (blocks.empty()) {
+      depot_.Take(size_class, TransferBatch(size_class), &blocks);
+      if (blocks.empty()) {
+        return nullptr;
+      }
+      Counters().depot_refills.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint8_t* block = blocks.back();
+    blocks.pop_back();
+    return block;
+  }
+
+  void Push(size_t size_class, uint8_t* block) {
+    auto& blocks = free_lists_[size_class];
+    if (blocks.size() >= ThreadCacheLimit(size_class)) {
+      if (depot_.Put(size_class, TransferBatch(size_class), &blocks) > 0) {
+        monitor::Metrics::Instance().IncrementCounter("network.buffer_pool.depot_overflow");
+      }
+      Counters().depot_flushes.fetch_add(1, std::memory_order_relaxed);
+    }
+    blocks.push_back(block);
+  }
+
+ private:
+  Depot& depot_;
+  std::array<std::vector<uint8_t*>, kClassCount> free_lists_;
+};
+
+ThreadCache& LocalCache() {
+  thread_local ThreadCache cache;
+  return cache;
+}
+
+}  // namespace
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_class_(other.size_class_) {}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+  if (this != &other) {
+    Reset();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_class_ = other.size_class_;
+  }
+  return *this;
+}
+
+void PooledBuffer::Reset() {
+  if (data_) {
+    BufferPool::Release(data_, size_class_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+uint8_t BufferPool::SizeClassFor(size_t size) {
+  for (size_t i = 0; i < kClassCount; ++i) {
+    if (size <= kSizeClasses[i]) {
+      return static_cast<uint8_t>(i);
+    }
+  }
+  return kUnpooled;
+}
+
+PooledBuffer BufferPool::Acquire(size_t size) {
+  const uint8_t size_class = SizeClassFor(size);
+  if (size_class == kUnpooled) {
+    Counters().oversize_allocs.fetch_add(1, std::memory_order_relaxed);
+    monitor::Metrics::Instance().IncrementCounter("network.buffer_pool.oversize_alloc");
+    auto* data = static_cast<uint8_t*>(::operator new(size));
+    return PooledBuffer(data, size, size, kUnpooled);
+  }
+
+  const size_t capacity = kSizeClasses[size_class];
+  uint8_t* data = t_cache_destroyed ? nullptr : LocalCache().Pop(size_class);
+  if (!data) {
+    Counters().heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    monitor::Metrics::Instance().IncrementCounter("network.buffer_pool.heap_alloc");
+    data = static_cast<uint8_t*>(::operator new(capacity));
+  }
+  return PooledBuffer(data, size, capacity, size_class);
+}
+
+void BufferPool::Release(uint8_t* data, uint8_t size_class) {
+  if (size_class == kUnpooled || t_cache_destroyed) {
+    ::operator delete(data);
+    return;
+  }
+  LocalCache().Push(size_class, data);
+}
+
+BufferPool::Stats BufferPool::GetStats() {
+  const auto& counters = Counters();
+  Stats stats;
+  stats.heap_allocs = counters.heap_allocs.load(std::memory_order_relaxed);
+  stats.heap_frees = counters.heap_frees.load(std::memory_order_relaxed);
+  stats.oversize_allocs = counters.oversize_allocs.load(std::memory_order_relaxed);
+  stats.depot_refills = counters.depot_refills.load(std::memory_order_relaxed);
+  stats.depot_flushes = counters.depot_flushes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace mir2::network
@@ -0,0 +1,100 @@
+/**
+ * @file buffer_pool.h
+ * @brief 发送帧缓冲池（按尺寸分级的线程缓存 slab）
+ */
+
+#ifndef MIR2_NETWORK_BUFFER_POOL_H
+#define MIR2_NETWORK_BUFFER_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mir2::network {
+
+/**
+ * @brief 池化字节缓冲（独占所有权，只可移动）
+ *
+ * 析构时归还到当前线程的缓存，因此可在逻辑线程申请、在 IO 线程写完后释放。
+ */
+class PooledBuffer {
+ public:
+  PooledBuffer() = default;
+  ~PooledBuffer() { Reset(); }
+
+  PooledBuffer(PooledBuffer&& other) noexcept;
+  PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+  PooledBuffer(const PooledBuffer&) = delete;
+  PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+  uint8_t* Data() { return data_; }
+  const uint8_t* Data() const { return data_; }
+  size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  size_t Capacity() const { return capacity_; }
+
+  /**
+   * @brief 调整有效长度（不超过容量）
+   */
+  void Resize(size_t size) { size_ = size < capacity_ ? size : capacity_; }
+
+  /**
+   * @brief 立即归还存储
+   */
+  void Reset();
+
+ private:
+  friend class BufferPool;
+
+  PooledBuffer(uint8_t* data, size_t size, size_t capacity, uint8_t size_class)
+      : data_(data), size_(size), capacity_(capacity), size_class_(size_class) {}
+
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  uint8_t size_class_ = 0;
+};
+
+/**
+ * @brief 发送帧缓冲池
+ *
+ * 尺寸分级覆盖常见游戏消息（移动/伤害同步几十字节，背包/场景快照数 KB），
+ * 超过最大级别的帧直接走堆。每个线程持有各级空闲链表，本地用尽时从全局
+ * 仓库批量补货，本地过满时批量退回仓库，仓库满才真正释放；跨线程
+ * （逻辑线程申请、IO 线程释放）的稳态下只有批量搬运时才加锁，不产生 malloc。
+ */
+class BufferPool {
+ public:
+  static constexpr std::array<size_t, 8> kSizeClasses = {
+      64, 128, 256, 512, 1024, 4096, 16 * 1024, 64 * 1024 + 64};
+  static constexpr uint8_t kUnpooled = 0xFF;
+
+  struct Stats {
+    uint64_t heap_allocs = 0;     // 池内无可用块，向堆申请
+    uint64_t heap_frees = 0;      // 仓库已满，释放回堆
+    uint64_t oversize_allocs = 0; // 超过最大级别，不入池
+    uint64_t depot_refills = 0;   // 线程缓存从仓库批量补货
+    uint64_t depot_flushes = 0;   // 线程缓存向仓库批量退货
+  };
+
+  /**
+   * @brief 申请至少 size 字节的缓冲，Size() 即为 size
+   */
+  static PooledBuffer Acquire(size_t size);
+
+  static Stats GetStats();
+
+  /**
+   * @brief 返回 size 所属的尺寸级别，超出时返回 kUnpooled
+   */
+  static uint8_t SizeClassFor(size_t size);
+
+ private:
+  friend class PooledBuffer;
+
+  static void Release(uint8_t* data, uint8_t size_class);
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_BUFFER_POOL_H
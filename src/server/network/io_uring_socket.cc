@@ -0,0 +1,845 @@
+#include "network/io_uring_socket.h"
+
+#ifdef MIR2_NETWORK_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include <asio/error.hpp>
+#include <asio/execution_context.hpp>
+#include <asio/post.hpp>
+#include <asio/posix/stream_descriptor.hpp>
+#include <asio/query.hpp>
+
+#include "log/logger.h"
+#include "monitor/metrics.h"
+
+#endif  // MIR2_NETWORK_HAS_IO_URING
+
+namespace mir2::network {
+
+#if defined(MIR2_NETWORK_HAS_IO_URING) && defined(IORING_RECV_MULTISHOT)
+
+namespace {
+
+constexpr unsigned kSqEntries = 4096;
+constexpr unsigned kCqEntries = 16384;
+constexpr uint16_t kBufferGroup = 0;
+// 提供缓冲环：每个 io_context 共享，接收数据被 async_read_some 取走后立即归还
+constexpr unsigned kBufferCount = 2048;
+constexpr size_t kBufferSize = 4096;
+constexpr size_t kMaxIovecs = 1024;  // UIO_MAXIOV
+
+int SysSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int SysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int SysRegister(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+/**
+ * @brief 在途操作；user_data 指向它，keepalive 保证完成前连接状态不被释放
+ */
+struct Op {
+  enum class Kind { kRecv, kRecvDirect, kWrite };
+
+  Kind kind;
+  IoUringSocketAdapter::State* owner = nullptr;
+  std::shared_ptr<IoUringSocketAdapter::State> keepalive;
+};
+
+void CompleteOp(Op* op, int32_t res, uint32_t flags);
+
+/**
+ * @brief 每个 io_context 一个 ring（asio 服务，随 io_context 销毁）
+ */
+class IoUringRing : public asio::execution_context::service {
+ public:
+  static asio::execution_context::id id;
+
+  explicit IoUringRing(asio::execution_context& context)
+      : asio::execution_context::service(context) {}
+
+  ~IoUringRing() override { Teardown(); }
+
+  static IoUringRing& For(const IoExecutor& executor) {
+    return asio::use_service<IoUringRing>(asio::query(executor, asio::execution::context));
+  }
+
+  /**
+   * @brief 首次使用时建立 ring 并挂接 eventfd（失败结果同样缓存）
+   */
+  bool EnsureStarted(const IoExecutor& executor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!start_attempted_) {
+      start_attempted_ = true;
+      started_ = Setup(executor);
+      if (!started_) {
+        Teardown();
+      }
+    }
+    return started_;
+  }
+
+  /**
+   * @brief 填写一个 SQE；同一轮事件循环内的提交合并为一次 io_uring_enter
+   */
+  template <typename Fill>
+  bool Prepare(Fill&& fill) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    io_uring_sqe* sqe = NextSqeLocked();
+    if (!sqe) {
+      return false;
+    }
+    std::memset(sqe, 0, sizeof(*sqe));
+    fill(sqe);
+    ++sqe_tail_;
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    if (!submit_scheduled_) {
+      submit_scheduled_ = true;
+      asio::post(*executor_, [this]() { Flush(); });
+    }
+    return true;
+  }
+
+  /**
+   * @brief 立即提交（关闭 fd 前的取消请求必须先于 close 到达内核）
+   */
+  void SubmitNow() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnterLocked();
+  }
+
+  const uint8_t* BufferData(uint16_t bid) const {
+    return buffers_.get() + static_cast<size_t>(bid) * kBufferSize;
+  }
+
+  /**
+   * @brief 有回调等待完成时才挂 eventfd 等待，空闲连接不会让 io_context::run 常驻
+   */
+  void AddWaiter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (++waiters_ == 1 && !wait_armed_ && event_desc_) {
+      WaitForCompletionsLocked();
+    }
+  }
+
+  void RemoveWaiter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--waiters_ == 0 && wait_armed_ && event_desc_) {
+      // 未收割的完成留在 CQ，eventfd 计数保持可读，下次挂等待时立即收割
+      event_desc_->cancel();
+    }
+  }
+
+  void RecycleBuffer(uint16_t bid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AddBufferLocked(bid);
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+  }
+
+ private:
+  void shutdown() override {
+    // 此时 reactor 已停止，销毁描述符只会释放其状态
+    std::lock_guard<std::mutex> lock(mutex_);
+    event_desc_.reset();
+  }
+
+  bool Setup(const IoExecutor& executor) {
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = kCqEntries;
+    ring_fd_ = SysSetup(kSqEntries, &params);
+    if (ring_fd_ < 0) {
+      SYSLOG_WARN("io_uring_setup failed: {}", std::strerror(errno));
+      return false;
+    }
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+      SYSLOG_WARN("io_uring kernel lacks IORING_FEAT_SINGLE_MMAP");
+      return false;
+    }
+
+    ring_size_ = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                  params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    ring_ptr_ = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ring_fd_, IORING_OFF_SQ_RING);
+    if (ring_ptr_ == MAP_FAILED) {
+      ring_ptr_ = nullptr;
+      return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<uint8_t*>(ring_ptr_);
+    sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    auto* sq_array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    for (unsigned i = 0; i < sq_entries_; ++i) {
+      sq_array[i] = i;
+    }
+    sqe_tail_ = *sq_tail_;
+    cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+    // 提供缓冲环：内核直接把数据收进这些缓冲，多发接收无需每次提交
+    buf_ring_size_ = kBufferCount * sizeof(io_uring_buf);
+    void* buf_ring = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE,
+                          MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (buf_ring == MAP_FAILED) {
+      return false;
+    }
+    buf_ring_ = static_cast<io_uring_buf_ring*>(buf_ring);
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    reg.ring_entries = kBufferCount;
+    reg.bgid = kBufferGroup;
+    if (SysRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+      SYSLOG_WARN("io_uring provided buffer ring unavailable: {}", std::strerror(errno));
+      return false;
+    }
+    buffers_ = std::make_unique<uint8_t[]>(kBufferCount * kBufferSize);
+    buf_tail_ = 0;
+    for (unsigned bid = 0; bid < kBufferCount; ++bid) {
+      AddBufferLocked(static_cast<uint16_t>(bid));
+    }
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0 || SysRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) < 0) {
+      return false;
+    }
+    executor_.emplace(executor);
+    event_desc_ = std::make_unique<asio::posix::stream_descriptor>(executor, event_fd_);
+    return true;
+  }
+
+  void Teardown() {
+    // eventfd 移交 stream_descriptor 后由其析构关闭，否则自行关闭
+    event_desc_.reset();
+    if (event_fd_ >= 0 && !executor_) {
+      ::close(event_fd_);
+    }
+    event_fd_ = -1;
+    if (buf_ring_) {
+      munmap(buf_ring_, buf_ring_size_);
+      buf_ring_ = nullptr;
+    }
+    if (sqes_) {
+      munmap(sqes_, sqes_size_);
+      sqes_ = nullptr;
+    }
+    if (ring_ptr_) {
+      munmap(ring_ptr_, ring_size_);
+      ring_ptr_ = nullptr;
+    }
+    if (ring_fd_ >= 0) {
+      ::close(ring_fd_);
+      ring_fd_ = -1;
+    }
+  }
+
+  void AddBufferLocked(uint16_t bid) {
+    // 逐字段写入：bufs[0] 的 resv 与环 tail 共用内存
+    io_uring_buf& buf = buf_ring_->bufs[buf_tail_ & (kBufferCount - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(buffers_.get() + static_cast<size_t>(bid) * kBufferSize);
+    buf.len = static_cast<uint32_t>(kBufferSize);
+    buf.bid = bid;
+    ++buf_tail_;
+  }
+
+  io_uring_sqe* NextSqeLocked() {
+    if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      EnterLocked();
+      if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+        monitor::Metrics::Instance().IncrementError("io_uring_sq_full");
+        return nullptr;
+      }
+    }
+    return &sqes_[sqe_tail_ & sq_mask_];
+  }
+
+  void EnterLocked() {
+    const unsigned pending = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (pending == 0) {
+      return;
+    }
+    int ret = 0;
+    do {
+      ret = SysEnter(ring_fd_, pending, 0, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+      SYSLOG_ERROR("io_uring_enter failed: {}", std::strerror(errno));
+      monitor::Metrics::Instance().IncrementError("io_uring_enter");
+      return;
+    }
+    monitor::Metrics::Instance().IncrementCounter("network.io_uring.enter");
+    monitor::Metrics::Instance().AddCounter("network.io_uring.sqes", static_cast<uint64_t>(ret));
+  }
+
+  void Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    submit_scheduled_ = false;
+    EnterLocked();
+  }
+
+  void WaitForCompletionsLocked() {
+    wait_armed_ = true;
+    event_desc_->async_wait(asio::posix::stream_descriptor::wait_read,
+                            [this](const asio::error_code& ec) { OnEventFd(ec); });
+  }
+
+  void OnEventFd(const asio::error_code& ec) {
+    if (!ec) {
+      uint64_t value = 0;
+      [[maybe_unused]] const auto n = ::read(event_fd_, &value, sizeof(value));
+      Reap();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    wait_armed_ = false;
+    if (waiters_ > 0 && event_desc_) {
+      WaitForCompletionsLocked();
+    }
+  }
+
+  /**
+   * @brief 收割 CQ：先整体拷出再分发，回调中产生的新提交不会与收割互相阻塞
+   */
+  void Reap() {
+    // 同一时刻只有一个 async_wait 在途，收割端天然串行
+    for (;;) {
+      unsigned head = *cq_head_;
+      const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      if (head == tail) {
+        break;
+      }
+      completions_.clear();
+      for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        completions_.push_back({cqe.user_data, cqe.res, cqe.flags});
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      for (const auto& completion : completions_) {
+        if (completion.user_data != 0) {
+          CompleteOp(reinterpret_cast<Op*>(completion.user_data), completion.res,
+                     completion.flags);
+        }
+      }
+    }
+    // 回调里续发的读写直接随本轮提交，省去一次投递
+    Flush();
+  }
+
+  struct Completion {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+  };
+
+  std::mutex mutex_;
+  bool start_attempted_ = false;
+  bool started_ = false;
+  bool submit_scheduled_ = false;
+  bool wait_armed_ = false;
+  size_t waiters_ = 0;
+  std::optional<IoExecutor> executor_;
+
+  int ring_fd_ = -1;
+  void* ring_ptr_ = nullptr;
+  size_t ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned sqe_tail_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+  std::vector<Completion> completions_;
+
+  io_uring_buf_ring* buf_ring_ = nullptr;
+  size_t buf_ring_size_ = 0;
+  uint16_t buf_tail_ = 0;
+  std::unique_ptr<uint8_t[]> buffers_;
+
+  int event_fd_ = -1;
+  std::unique_ptr<asio::posix::stream_descriptor> event_desc_;
+};
+
+asio::execution_context::id IoUringRing::id;
+
+bool ProbeKernel() {
+  // 多发接收需要 6.0+
+  utsname info{};
+  int major = 0;
+  int minor = 0;
+  if (uname(&info) != 0 || std::sscanf(info.release, "%d.%d", &major, &minor) != 2 ||
+      major < 6) {
+    return false;
+  }
+  io_uring_params params{};
+  const int fd = SysSetup(4, &params);
+  if (fd < 0) {
+    return false;
+  }
+  ::close(fd);
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @brief 连接状态；由适配器与在途操作共同持有
+ */
+struct IoUringSocketAdapter::State : std::enable_shared_from_this<State> {
+  struct Chunk {
+    uint16_t bid;
+    uint32_t size;
+    uint32_t offset;
+  };
+
+  State(asio::ip::tcp::socket s, IoUringRing* r) : socket(std::move(s)), ring(r) {
+    fd = socket.native_handle();
+    recv_op.kind = Op::Kind::kRecv;
+    recv_op.owner = this;
+    direct_op.kind = Op::Kind::kRecvDirect;
+    direct_op.owner = this;
+    write_op.kind = Op::Kind::kWrite;
+    write_op.owner = this;
+  }
+
+  ~State() {
+    for (const auto& chunk : chunks) {
+      ring->RecycleBuffer(chunk.bid);
+    }
+  }
+
+  /**
+   * @brief 从已收数据拷入 target（可跨多个缓冲），耗尽的缓冲归还 ring
+   */
+  size_t CopyChunks(const asio::mutable_buffer& target) {
+    auto* out = static_cast<uint8_t*>(target.data());
+    size_t copied = 0;
+    while (!chunks.empty() && copied < target.size()) {
+      Chunk& chunk = chunks.front();
+      const size_t n = std::min<size_t>(chunk.size - chunk.offset, target.size() - copied);
+      std::memcpy(out + copied, ring->BufferData(chunk.bid) + chunk.offset, n);
+      copied += n;
+      chunk.offset += static_cast<uint32_t>(n);
+      if (chunk.offset == chunk.size) {
+        ring->RecycleBuffer(chunk.bid);
+        chunks.pop_front();
+      }
+    }
+    return copied;
+  }
+
+  void ArmRecv() {
+    recv_armed = true;
+    recv_op.keepalive = shared_from_this();
+    const bool ok = ring->Prepare([this](io_uring_sqe* sqe) {
+      sqe->opcode = IORING_OP_RECV;
+      sqe->fd = fd;
+      sqe->ioprio = IORING_RECV_MULTISHOT;
+      sqe->flags = IOSQE_BUFFER_SELECT;
+      sqe->buf_group = kBufferGroup;
+      sqe->user_data = reinterpret_cast<uint64_t>(&recv_op);
+    });
+    if (!ok) {
+      recv_armed = false;
+      recv_op.keepalive.reset();
+      read_error = asio::error::no_buffer_space;
+    }
+  }
+
+  void ArmDirectRecv() {
+    direct_pending = true;
+    direct_op.keepalive = shared_from_this();
+    const bool ok = ring->Prepare([this](io_uring_sqe* sqe) {
+      sqe->opcode = IORING_OP_RECV;
+      sqe->fd = fd;
+      sqe->addr = reinterpret_cast<uint64_t>(read_target.data());
+      sqe->len = static_cast<uint32_t>(read_target.size());
+      sqe->user_data = reinterpret_cast<uint64_t>(&direct_op);
+    });
+    if (!ok) {
+      direct_pending = false;
+      direct_op.keepalive.reset();
+      read_error = asio::error::no_buffer_space;
+    }
+  }
+
+  void SubmitWrite() {
+    write_op.keepalive = shared_from_this();
+    msg = {};
+    msg.msg_iov = iov.data() + iov_index;
+    msg.msg_iovlen = std::min(iov.size() - iov_index, kMaxIovecs);
+    const bool ok = ring->Prepare([this](io_uring_sqe* sqe) {
+      sqe->opcode = IORING_OP_SENDMSG;
+      sqe->fd = fd;
+      sqe->addr = reinterpret_cast<uint64_t>(&msg);
+      sqe->len = 1;
+      sqe->msg_flags = MSG_NOSIGNAL;
+      sqe->user_data = reinterpret_cast<uint64_t>(&write_op);
+    });
+    if (!ok) {
+      write_op.keepalive.reset();
+      auto handler = std::move(write_handler);
+      write_handler = nullptr;
+      ring->RemoveWaiter();
+      asio::post(socket.get_executor(), [handler = std::move(handler), done = write_done]() {
+        handler(asio::error::no_buffer_space, done);
+      });
+    }
+  }
+
+  /**
+   * @brief 取消本连接全部在途操作；必须在关闭 fd 之前提交到内核
+   */
+  void CancelAll() {
+    if (!recv_armed && !direct_pending && !write_handler) {
+      return;
+    }
+    const bool ok = ring->Prepare([this](io_uring_sqe* sqe) {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = fd;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+      sqe->user_data = 0;
+    });
+    if (ok) {
+      ring->SubmitNow();
+    }
+  }
+
+  void OnRecv(int32_t res, uint32_t flags) {
+    IoHandler handler;
+    asio::error_code ec;
+    size_t bytes = 0;
+    std::shared_ptr<State> released;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const bool more = (flags & IORING_CQE_F_MORE) != 0;
+      bool out_of_buffers = false;
+      if (res > 0 && (flags & IORING_CQE_F_BUFFER) != 0) {
+        chunks.push_back({static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT),
+                          static_cast<uint32_t>(res), 0});
+      } else if (res == 0) {
+        read_error = asio::error::eof;
+      } else if (res == -ENOBUFS) {
+        out_of_buffers = true;
+        monitor::Metrics::Instance().IncrementCounter("network.io_uring.recv_nobufs");
+      } else if (res < 0) {
+        read_error = res == -ECANCELED ? asio::error::operation_aborted
+                                       : asio::error_code(-res, asio::error::get_system_category());
+      }
+      if (!more) {
+        recv_armed = false;
+        released = std::move(recv_op.keepalive);
+      }
+      if (!read_handler) {
+        return;
+      }
+      if (!chunks.empty()) {
+        bytes = CopyChunks(read_target);
+      } else if (read_error) {
+        ec = read_error;
+      } else {
+        if (!more && !closed) {
+          // 共享缓冲耗尽时本次直接收进调用方缓冲，下次读取再恢复多发
+          if (out_of_buffers) {
+            ArmDirectRecv();
+          } else {
+            ArmRecv();
+          }
+        }
+        if (!read_error) {
+          return;
+        }
+        ec = read_error;
+      }
+      handler = std::move(read_handler);
+      read_handler = nullptr;
+    }
+    ring->RemoveWaiter();
+    handler(ec, bytes);
+  }
+
+  void OnDirectRecv(int32_t res) {
+    IoHandler handler;
+    asio::error_code ec;
+    std::shared_ptr<State> released;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      direct_pending = false;
+      released = std::move(direct_op.keepalive);
+      if (res == 0) {
+        read_error = asio::error::eof;
+      } else if (res < 0) {
+        read_error = res == -ECANCELED ? asio::error::operation_aborted
+                                       : asio::error_code(-res, asio::error::get_system_category());
+      }
+      ec = read_error;
+      handler = std::move(read_handler);
+      read_handler = nullptr;
+    }
+    if (handler) {
+      ring->RemoveWaiter();
+      handler(ec, res > 0 ? static_cast<size_t>(res) : 0);
+    }
+  }
+
+  void OnWrite(int32_t res) {
+    IoHandler handler;
+    asio::error_code ec;
+    size_t done = 0;
+    std::shared_ptr<State> released;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (res < 0) {
+        ec = res == -ECANCELED ? asio::error::operation_aborted
+                               : asio::error_code(-res, asio::error::get_system_category());
+      } else {
+        write_done += static_cast<size_t>(res);
+        if (write_done < write_total) {
+          // 部分写：跳过已写出的 iovec，续写剩余部分
+          size_t advance = static_cast<size_t>(res);
+          while (advance > 0 && iov_index < iov.size()) {
+            iovec& entry = iov[iov_index];
+            if (advance >= entry.iov_len) {
+              advance -= entry.iov_len;
+              ++iov_index;
+            } else {
+              entry.iov_base = static_cast<uint8_t*>(entry.iov_base) + advance;
+              entry.iov_len -= advance;
+              advance = 0;
+            }
+          }
+          SubmitWrite();
+          return;
+        }
+      }
+      released = std::move(write_op.keepalive);
+      done = write_done;
+      handler = std::move(write_handler);
+      write_handler = nullptr;
+    }
+    ring->RemoveWaiter();
+    handler(ec, done);
+  }
+
+  asio::ip::tcp::socket socket;
+  IoUringRing* ring;
+  int fd = -1;
+  std::mutex mutex;
+  bool closed = false;
+
+  Op recv_op;
+  Op direct_op;
+  bool recv_armed = false;
+  bool direct_pending = false;
+  IoHandler read_handler;
+  asio::mutable_buffer read_target;
+  std::deque<Chunk> chunks;
+  asio::error_code read_error;
+
+  Op write_op;
+  IoHandler write_handler;
+  std::vector<iovec> iov;
+  size_t iov_index = 0;
+  msghdr msg{};
+  size_t write_total = 0;
+  size_t write_done = 0;
+};
+
+namespace {
+
+void CompleteOp(Op* op, int32_t res, uint32_t flags) {
+  switch (op->kind) {
+    case Op::Kind::kRecv:
+      op->owner->OnRecv(res, flags);
+      break;
+    case Op::Kind::kRecvDirect:
+      op->owner->OnDirectRecv(res);
+      break;
+    case Op::Kind::kWrite:
+      op->owner->OnWrite(res);
+      break;
+  }
+}
+
+}  // namespace
+
+bool IoUringSocketAdapter::IsSupported() {
+  static const bool supported = ProbeKernel();
+  return supported;
+}
+
+std::unique_ptr<IoUringSocketAdapter> IoUringSocketAdapter::Create(asio::ip::tcp::socket& socket) {
+  if (!IsSupported() || !socket.is_open()) {
+    return nullptr;
+  }
+  const IoExecutor executor = socket.get_executor();
+  auto& ring = IoUringRing::For(executor);
+  if (!ring.EnsureStarted(executor)) {
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketAdapter>(std::make_shared<State>(std::move(socket), &ring));
+}
+
+IoUringSocketAdapter::IoUringSocketAdapter(std::shared_ptr<State> state)
+    : state_(std::move(state)) {}
+
+IoUringSocketAdapter::~IoUringSocketAdapter() {
+  asio::error_code ec;
+  close(ec);
+}
+
+void IoUringSocketAdapter::async_read_some(const asio::mutable_buffer& buffer, IoHandler handler) {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  if (!state_->chunks.empty() || state_->read_error) {
+    const size_t bytes = state_->chunks.empty() ? 0 : state_->CopyChunks(buffer);
+    const asio::error_code ec = bytes > 0 ? asio::error_code() : state_->read_error;
+    lock.unlock();
+    asio::post(state_->socket.get_executor(),
+               [handler = std::move(handler), ec, bytes]() { handler(ec, bytes); });
+    return;
+  }
+  if (!state_->recv_armed && !state_->direct_pending) {
+    state_->read_target = buffer;
+    state_->ArmRecv();
+    if (state_->read_error) {
+      const asio::error_code ec = state_->read_error;
+      lock.unlock();
+      asio::post(state_->socket.get_executor(),
+                 [handler = std::move(handler), ec]() { handler(ec, 0); });
+      return;
+    }
+  }
+  state_->read_handler = std::move(handler);
+  state_->read_target = buffer;
+  state_->ring->AddWaiter();
+}
+
+void IoUringSocketAdapter::async_write(const asio::const_buffer& buffer, IoHandler handler) {
+  async_write_gather({buffer}, std::move(handler));
+}
+
+void IoUringSocketAdapter::async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                                              IoHandler handler) {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->iov.clear();
+  state_->write_total = 0;
+  for (const auto& buffer : buffers) {
+    if (buffer.size() == 0) {
+      continue;
+    }
+    state_->iov.push_back({const_cast<void*>(buffer.data()), buffer.size()});
+    state_->write_total += buffer.size();
+  }
+  state_->iov_index = 0;
+  state_->write_done = 0;
+  state_->write_handler = std::move(handler);
+  state_->ring->AddWaiter();
+  state_->SubmitWrite();
+}
+
+void IoUringSocketAdapter::set_no_delay(bool enabled, asio::error_code& ec) {
+  state_->socket.set_option(asio::ip::tcp::no_delay(enabled), ec);
+}
+
+void IoUringSocketAdapter::shutdown(asio::ip::tcp::socket::shutdown_type type,
+                                    asio::error_code& ec) {
+  state_->socket.shutdown(type, ec);
+}
+
+void IoUringSocketAdapter::close(asio::error_code& ec) {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->closed) {
+    ec.clear();
+    return;
+  }
+  state_->closed = true;
+  state_->CancelAll();
+  state_->socket.close(ec);
+}
+
+asio::ip::tcp::endpoint IoUringSocketAdapter::remote_endpoint(asio::error_code& ec) const {
+  return state_->socket.remote_endpoint(ec);
+}
+
+IoExecutor IoUringSocketAdapter::GetExecutor() {
+  return state_->socket.get_executor();
+}
+
+#else  // !MIR2_NETWORK_HAS_IO_URING
+
+struct IoUringSocketAdapter::State {};
+
+bool IoUringSocketAdapter::IsSupported() {
+  return false;
+}
+
+std::unique_ptr<IoUringSocketAdapter> IoUringSocketAdapter::Create(
+    asio::ip::tcp::socket& /*socket*/) {
+  return nullptr;
+}
+
+IoUringSocketAdapter::IoUringSocketAdapter(std::shared_ptr<State> state)
+    : state_(std::move(state)) {}
+
+IoUringSocketAdapter::~IoUringSocketAdapter() = default;
+
+void IoUringSocketAdapter::async_read_some(const asio::mutable_buffer&, IoHandler) {}
+void IoUringSocketAdapter::async_write(const asio::const_buffer&, IoHandler) {}
+void IoUringSocketAdapter::async_write_gather(const std::vector<asio::const_buffer>&, IoHandler) {}
+void IoUringSocketAdapter::set_no_delay(bool, asio::error_code& ec) {
+  ec = asio::error::operation_not_supported;
+}
+void IoUringSocketAdapter::shutdown(asio::ip::tcp::socket::shutdown_type, asio::error_code& ec) {
+  ec = asio::error::operation_not_supported;
+}
+void IoUringSocketAdapter::close(asio::error_code& ec) {
+  ec = asio::error::operation_not_supported;
+}
+asio::ip::tcp::endpoint IoUringSocketAdapter::remote_endpoint(asio::error_code& ec) const {
+  ec = asio::error::operation_not_supported;
+  return {};
+}
+IoExecutor IoUringSocketAdapter::GetExecutor() {
+  return IoExecutor();
+}
+
+#endif  // MIR2_NETWORK_HAS_IO_URING
+
+}  // namespace mir2::network
@@ -0,0 +1,65 @@
+/**
+ * @file io_uring_socket.h
+ * @brief 基于 io_uring 的 Socket 适配器（Linux）
+ *
+ * 每个 io_context 一个 ring（asio 服务），由 ring 的 eventfd 接入 asio 事件循环：
+ * - 读：多发（multishot）接收 + 内核注册的提供缓冲环，一次提交持续收包；
+ * - 写：sendmsg 分散-聚集，部分写自动续写；
+ * - 提交：同一轮事件循环内的 SQE 合并为一次 io_uring_enter。
+ * 连接的建立、关闭与选项仍由底层 asio socket 完成。
+ */
+
+#ifndef MIR2_NETWORK_IO_URING_SOCKET_H
+#define MIR2_NETWORK_IO_URING_SOCKET_H
+
+#include <memory>
+
+#include <asio/ip/tcp.hpp>
+
+#include "network/tcp_connection.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define MIR2_NETWORK_HAS_IO_URING 1
+#endif
+#endif
+
+namespace mir2::network {
+
+/**
+ * @brief io_uring Socket 适配器
+ */
+class IoUringSocketAdapter : public SocketAdapter {
+ public:
+  struct State;
+
+  /**
+   * @brief 创建适配器；平台或内核不支持时返回 nullptr（socket 原样交还调用方）
+   */
+  static std::unique_ptr<IoUringSocketAdapter> Create(asio::ip::tcp::socket& socket);
+
+  /**
+   * @brief 本进程能否创建 io_uring（结果缓存）
+   */
+  static bool IsSupported();
+
+  explicit IoUringSocketAdapter(std::shared_ptr<State> state);
+  ~IoUringSocketAdapter() override;
+
+  void async_read_some(const asio::mutable_buffer& buffer, IoHandler handler) override;
+  void async_write(const asio::const_buffer& buffer, IoHandler handler) override;
+  void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                          IoHandler handler) override;
+  void set_no_delay(bool enabled, asio::error_code& ec) override;
+  void shutdown(asio::ip::tcp::socket::shutdown_type type, asio::error_code& ec) override;
+  void close(asio::error_code& ec) override;
+  asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const override;
+  IoExecutor GetExecutor() override;
+
+ private:
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_IO_URING_SOCKET_H
@@ -7,15 +7,15 @@
 namespace mir2::network {
 
 void MessageDispatcher::RegisterHandler(uint16_t msg_id, MessageHandler handler) {
-  handlers_[msg_id] = std::move(handler);
+  handlers_.At(msg_id) = std::move(handler);
 }
 
 void MessageDispatcher::Dispatch(const std::shared_ptr<TcpSession>& session, uint16_t msg_id,
-                                 const std::vector<uint8_t>& payload) const {
-  auto it = handlers_.find(msg_id);
-  if (it != handlers_.end() && it->second) {
+                                 std::span<const uint8_t> payload) const {
+  const MessageHandler* handler = handlers_.Find(msg_id);
+  if (handler && *handler) {
     const auto start = std::chrono::steady_clock::now();
-    it->second(session, payload);
+    (*handler)(session, payload);
     const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
                                 std::chrono::steady_clock::now() - start)
                                 .count();
@@ -9,8 +9,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
-#include <unordered_map>
-#include <vector>
+#include <span>
+
+#include "server/common/msg_id_table.h"
 
 namespace mir2::network {
 
@@ -18,12 +19,18 @@ class TcpSession;
 
 /**
  * @brief 消息处理回调
+ *
+ * payload 指向会话接收缓冲区，仅在回调期间有效；需要延后处理（post 到其他线程、
+ * 缓存等）时由处理函数自行拷贝。
  */
 using MessageHandler =
-    std::function<void(const std::shared_ptr<TcpSession>&, const std::vector<uint8_t>&)>;
+    std::function<void(const std::shared_ptr<TcpSession>&, std::span<const uint8_t>)>;
 
 /**
  * @brief 消息分发器
+ *
+ * 处理函数按 msg_id 直接索引，分发不做哈希查找。注册须在 NetworkManager::Start 开始监听之前
+ * 完成，此后表只读，IO 线程分发无需加锁。
  */
 class MessageDispatcher {
  public:
@@ -36,10 +43,10 @@ class MessageDispatcher {
    * @brief 分发消息
    */
   void Dispatch(const std::shared_ptr<TcpSession>& session, uint16_t msg_id,
-                const std::vector<uint8_t>& payload) const;
+                std::span<const uint8_t> payload) const;
 
  private:
-  std::unordered_map<uint16_t, MessageHandler> handlers_;
+  mir2::common::MsgIdTable<MessageHandler> handlers_;
 };
 
 }  // namespace mir2::network
@@ -1,20 +1,20 @@
 #include "network/network_manager.h"
 
-#include <asio/post.hpp>
-
 #include "monitor/metrics.h"
 
 namespace {
 
-constexpr int64_t kHeartbeatCheckIntervalMs = 30000;
 constexpr int64_t kHeartbeatTimeoutMs = 90000;
+constexpr int64_t kMetricsReportIntervalMs = 5000;
 
 }  // namespace
 
 namespace mir2::network {
 
 NetworkManager::NetworkManager(asio::io_context& io_context)
-    : io_context_(io_context), server_(io_context) {
+    : io_context_(io_context),
+      server_(io_context),
+      heartbeat_wheel_(TimingWheel::kDefaultTickMs, TcpSession::NowMs()) {
   server_.SetConnectHandler([this](const std::shared_ptr<TcpConnection>& connection) {
     AddConnection(connection);
   });
@@ -24,6 +24,10 @@ bool NetworkManager::Start(const std::string& bind_ip, uint16_t port, int max_co
   return server_.Start(bind_ip, port, max_connections);
 }
 
+void NetworkManager::SetIoContexts(std::vector<asio::io_context*> io_contexts) {
+  server_.SetIoContexts(std::move(io_contexts));
+}
+
 void NetworkManager::Stop() {
   server_.Stop();
   StopAll();
@@ -34,94 +38,108 @@ void NetworkManager::RegisterHandler(uint16_t msg_id, MessageHandler handler) {
 }
 
 void NetworkManager::Send(uint64_t connection_id, uint16_t msg_id, const std::vector<uint8_t>& payload) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto it = sessions_.find(connection_id);
-  if (it != sessions_.end() && it->second) {
-    it->second->Send(msg_id, payload);
+  if (auto session = sessions_.Find(connection_id)) {
+    session->Send(msg_id, payload);
   }
 }
 
 void NetworkManager::Broadcast(uint16_t msg_id, const std::vector<uint8_t>& payload) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& [_, session] : sessions_) {
-    if (session) {
-      session->Send(msg_id, payload);
-    }
-  }
+  Broadcast(SharedFrame::Create(msg_id, payload));
 }
 
 void NetworkManager::BroadcastIf(uint16_t msg_id, const std::vector<uint8_t>& payload,
                                  SessionFilter filter) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& [_, session] : sessions_) {
-    if (session && (!filter || filter(session))) {
-      session->Send(msg_id, payload);
+  BroadcastIf(SharedFrame::Create(msg_id, payload), std::move(filter));
+}
+
+void NetworkManager::Broadcast(const std::shared_ptr<const SharedFrame>& frame) {
+  BroadcastIf(frame, nullptr);
+}
+
+void NetworkManager::BroadcastIf(const std::shared_ptr<const SharedFrame>& frame,
+                                 SessionFilter filter) {
+  if (!frame || !frame->IsValid()) {
+    return;
+  }
+  // 分片锁内只复制会话指针，过滤与发送在锁外进行，避免阻塞 IO 线程的会话增删；
+  // 目标数组按线程复用，取出后再归还以兼容回调内的重入广播
+  thread_local std::vector<std::shared_ptr<TcpSession>> cached_targets;
+  std::vector<std::shared_ptr<TcpSession>> targets = std::move(cached_targets);
+  targets.clear();
+  targets.reserve(sessions_.Size());
+  sessions_.ForEach([&targets](const std::shared_ptr<TcpSession>& session) {
+    targets.push_back(session);
+  });
+  for (const auto& session : targets) {
+    if (!filter || filter(session)) {
+      session->SendFrame(frame);
     }
   }
+  targets.clear();
+  cached_targets = std::move(targets);
 }
 
 std::shared_ptr<TcpSession> NetworkManager::GetSession(uint64_t session_id) const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto it = sessions_.find(session_id);
-  if (it != sessions_.end()) {
-    return it->second;
-  }
-  return nullptr;
+  return sessions_.Find(session_id);
 }
 
 std::vector<std::shared_ptr<TcpSession>> NetworkManager::GetAllSessions() const {
-  std::vector<std::shared_ptr<TcpSession>> result;
-  std::lock_guard<std::mutex> lock(mutex_);
-  result.reserve(sessions_.size());
-  for (const auto& [_, session] : sessions_) {
-    if (session) {
-      result.push_back(session);
-    }
-  }
-  return result;
+  return sessions_.Snapshot();
 }
 
 size_t NetworkManager::GetConnectionCount() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return sessions_.size();
+  return sessions_.Size();
+}
+
+void NetworkManager::FlushAll() {
+  sessions_.ForEach([](const std::shared_ptr<TcpSession>& session) { session->Flush(); });
 }
 
 void NetworkManager::Tick() {
+  // Tick 末尾统一冲刷本 Tick 产生的消息
+  if (send_policy_.cork || send_policy_.routed_batch_bytes > 0) {
+    FlushAll();
+  }
+
   const int64_t now_ms = TcpSession::NowMs();
-  if (now_ms - last_heartbeat_check_ms_ < kHeartbeatCheckIntervalMs) {
+  ExpireHeartbeats(now_ms);
+  ReportMetrics(now_ms);
+}
+
+void NetworkManager::ReportMetrics(int64_t now_ms) {
+  if (now_ms < next_metrics_report_ms_) {
     return;
   }
+  next_metrics_report_ms_ = now_ms + kMetricsReportIntervalMs;
+  // 分片锁争用只在分片内原子计数，这里按周期汇总，避免热路径上的字符串查表
+  monitor::Metrics::Instance().SetGauge("network.session_registry.lock_contended",
+                                        static_cast<int64_t>(sessions_.GetContendedLocks()));
+}
 
-  last_heartbeat_check_ms_ = now_ms;
-
-  asio::post(io_context_, [this]() {
-    const int64_t now_ms = TcpSession::NowMs();
-    std::vector<std::shared_ptr<TcpSession>> expired_sessions;
-    size_t timeout_count = 0;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      for (auto& [_, session] : sessions_) {
-        if (!session) {
-          continue;
-        }
-        const int64_t last_heartbeat_ms = session->GetLastHeartbeatMs();
-        if (now_ms < last_heartbeat_ms ||
-            now_ms - last_heartbeat_ms >= kHeartbeatTimeoutMs) {
-          expired_sessions.push_back(session);
-          ++timeout_count;
-        }
-      }
+void NetworkManager::ExpireHeartbeats(int64_t now_ms) {
+  heartbeat_expired_.clear();
+  {
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    if (heartbeat_wheel_.Advance(now_ms, heartbeat_expired_) == 0) {
+      return;
     }
+  }
 
-    for (size_t i = 0; i < timeout_count; ++i) {
-      monitor::Metrics::Instance().IncrementHeartbeatTimeouts();
+  // 心跳只更新会话上的时间戳，到期条目在这里按最新心跳复核
+  for (const uint64_t session_id : heartbeat_expired_) {
+    const auto session = sessions_.Find(session_id);
+    if (!session) {
+      continue;
     }
-    for (const auto& session : expired_sessions) {
-      if (session) {
-        session->Close();
-      }
+    const int64_t last_heartbeat_ms = session->GetLastHeartbeatMs();
+    if (now_ms >= last_heartbeat_ms && now_ms - last_heartbeat_ms < kHeartbeatTimeoutMs) {
+      std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+      heartbeat_wheel_.Schedule(session_id, last_heartbeat_ms + kHeartbeatTimeoutMs);
+      continue;
     }
-  });
+    monitor::Metrics::Instance().IncrementHeartbeatTimeouts();
+    session->Close();
+  }
 }
 
 void NetworkManager::AddConnection(const std::shared_ptr<TcpConnection>& connection) {
@@ -132,6 +150,7 @@ void NetworkManager::AddConnection(const std::shared_ptr<TcpConnection>& connect
   connection->SetDisconnectHandler([this](uint64_t connection_id) {
     RemoveConnection(connection_id);
   });
+  connection->ApplySendPolicy(send_policy_);
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -166,6 +185,7 @@ std::shared_ptr<TcpConnection> NetworkManager::FindConnection(uint64_t connectio
 }
 
 void NetworkManager::BroadcastRaw(const std::vector<uint8_t>& bytes) {
+  const auto shared_bytes = std::make_shared<const std::vector<uint8_t>>(bytes);
   std::vector<std::shared_ptr<TcpConnection>> connections;
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -179,7 +199,7 @@ void NetworkManager::BroadcastRaw(const std::vector<uint8_t>& bytes) {
 
   for (const auto& connection : connections) {
     if (connection) {
-      connection->SendRaw(bytes);
+      connection->SendShared(nullptr, 0, shared_bytes);
     }
   }
 }
@@ -224,6 +244,9 @@ void NetworkManager::OnConnectionOpened(const std::shared_ptr<TcpConnection>& co
   }
 
   auto session = std::make_shared<TcpSession>(connection);
+  session->SetCompressionThreshold(send_policy_.compression_threshold);
+  session->SetRoutedBatchBytes(send_policy_.routed_batch_bytes);
+  session->SetRateLimit(max_messages_per_sec_, max_bytes_per_sec_);
   std::weak_ptr<TcpSession> weak_session = session;
   connection->SetReadHandler([weak_session](const uint8_t* data, size_t size) {
     if (auto locked = weak_session.lock()) {
@@ -239,15 +262,7 @@ void NetworkManager::OnConnectionClosed(const std::shared_ptr<TcpConnection>& co
     return;
   }
 
-  std::shared_ptr<TcpSession> session;
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = sessions_.find(connection->GetConnectionId());
-    if (it != sessions_.end()) {
-      session = it->second;
-    }
-  }
-
+  const auto session = sessions_.Find(connection->GetConnectionId());
   if (session) {
     session->HandleDisconnect(connection->GetConnectionId());
     OnSessionDisconnected(session);
@@ -259,20 +274,26 @@ void NetworkManager::OnSessionConnected(const std::shared_ptr<TcpSession>& sessi
     return;
   }
 
+  sessions_.Insert(session);
+  monitor::Metrics::Instance().SetConnections(static_cast<int64_t>(sessions_.Size()));
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    sessions_[session->GetSessionId()] = session;
-    monitor::Metrics::Instance().SetConnections(static_cast<int64_t>(sessions_.size()));
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    heartbeat_wheel_.Schedule(session->GetSessionId(),
+                              session->GetLastHeartbeatMs() + kHeartbeatTimeoutMs);
   }
 
   session->SetMessageHandler([this](const std::shared_ptr<TcpSession>& session,
-                                    const Packet& packet) {
+                                    const PacketView& packet) {
     if (!session) {
       return;
     }
     dispatcher_.Dispatch(session, packet.msg_id, packet.payload);
   });
 
+  if (session_opened_handler_) {
+    session_opened_handler_(session);
+  }
+
   session->Start();
 }
 
@@ -280,9 +301,15 @@ void NetworkManager::OnSessionDisconnected(const std::shared_ptr<TcpSession>& se
   if (!session) {
     return;
   }
-  std::lock_guard<std::mutex> lock(mutex_);
-  sessions_.erase(session->GetSessionId());
-  monitor::Metrics::Instance().SetConnections(static_cast<int64_t>(sessions_.size()));
+  sessions_.Erase(session->GetSessionId());
+  monitor::Metrics::Instance().SetConnections(static_cast<int64_t>(sessions_.Size()));
+  {
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    heartbeat_wheel_.Cancel(session->GetSessionId());
+  }
+  if (session_closed_handler_) {
+    session_closed_handler_(session);
+  }
 }
 
 
@@ -15,9 +15,12 @@
 #include <vector>
 
 #include "network/message_dispatcher.h"
+#include "network/session_registry.h"
+#include "network/shared_frame.h"
 #include "network/tcp_connection.h"
 #include "network/tcp_server.h"
 #include "network/tcp_session.h"
+#include "network/timing_wheel.h"
 
 namespace mir2::network {
 
@@ -27,6 +30,7 @@ namespace mir2::network {
 class NetworkManager {
  public:
   using SessionFilter = std::function<bool(const std::shared_ptr<TcpSession>&)>;
+  using SessionHandler = std::function<void(const std::shared_ptr<TcpSession>&)>;
   explicit NetworkManager(asio::io_context& io_context);
 
   /**
@@ -34,6 +38,54 @@ class NetworkManager {
    */
   bool Start(const std::string& bind_ip, uint16_t port, int max_connections);
 
+  /**
+   * @brief 启用每核IO上下文（须在 Start 之前调用，少于两个上下文时保持共享模式）
+   */
+  void SetIoContexts(std::vector<asio::io_context*> io_contexts);
+
+  /**
+   * @brief 设置新连接的发送策略（cork 模式下由 Tick 统一 Flush）
+   */
+  void SetSendPolicy(const SendPolicy& policy) { send_policy_ = policy; }
+
+  /**
+   * @brief 选择新连接的 Socket 后端（须在 Start 之前调用）
+   */
+  void SetSocketBackend(SocketBackend backend) { server_.SetSocketBackend(backend); }
+
+  /**
+   * @brief 设置新会话建立回调（须在 Start 之前调用）
+   *
+   * 在 IO 线程上、会话开始收包之前调用一次，上层可在此登记路由和定时器，
+   * 无需每 Tick 扫描会话表寻找新连接。
+   */
+  void SetSessionOpenedHandler(SessionHandler handler) { session_opened_handler_ = std::move(handler); }
+
+  /**
+   * @brief 设置会话断开回调（须在 Start 之前调用）
+   *
+   * 在 IO 线程上、会话从会话表移除之后调用一次，上层可在此清理按会话登记的状态。
+   */
+  void SetSessionClosedHandler(SessionHandler handler) { session_closed_handler_ = std::move(handler); }
+
+  /**
+   * @brief 设置新会话的接收限速（0 表示不限）
+   */
+  void SetRateLimit(uint32_t max_messages_per_sec, uint32_t max_bytes_per_sec) {
+    max_messages_per_sec_ = max_messages_per_sec;
+    max_bytes_per_sec_ = max_bytes_per_sec;
+  }
+
+  /**
+   * @brief 实际监听端口（以端口 0 启动时由系统分配）
+   */
+  uint16_t GetListenPort() const { return server_.GetListenPort(); }
+
+  /**
+   * @brief 投递所有会话积攒的发送批次
+   */
+  void FlushAll();
+
   /**
    * @brief 停止网络
    */
@@ -55,11 +107,19 @@ class NetworkManager {
   void Broadcast(uint16_t msg_id, const std::vector<uint8_t>& payload);
   void BroadcastIf(uint16_t msg_id, const std::vector<uint8_t>& payload, SessionFilter filter);
 
+  /**
+   * @brief 广播已编码的共享帧（负载只编码一次，所有会话共享）
+   *
+   * 过滤器与发送均在会话表锁外执行，过滤器内可以再访问 NetworkManager。
+   */
+  void Broadcast(const std::shared_ptr<const SharedFrame>& frame);
+  void BroadcastIf(const std::shared_ptr<const SharedFrame>& frame, SessionFilter filter);
+
   std::shared_ptr<TcpSession> GetSession(uint64_t session_id) const;
   std::vector<std::shared_ptr<TcpSession>> GetAllSessions() const;
 
   /**
-   * @brief Tick更新
+   * @brief Tick更新（冲刷发送批次，关闭心跳超时的会话，定期导出会话表指标）
    */
   void Tick();
 
@@ -77,15 +137,27 @@ class NetworkManager {
   void OnConnectionClosed(const std::shared_ptr<TcpConnection>& connection);
   void OnSessionConnected(const std::shared_ptr<TcpSession>& session);
   void OnSessionDisconnected(const std::shared_ptr<TcpSession>& session);
+  void ExpireHeartbeats(int64_t now_ms);
+  void ReportMetrics(int64_t now_ms);
 
   asio::io_context& io_context_;
   TcpServer server_;
   MessageDispatcher dispatcher_;
 
+  // 仅保护 connections_（连接生命周期）；会话查找走分片的 sessions_
   mutable std::mutex mutex_;
   std::unordered_map<uint64_t, std::shared_ptr<TcpConnection>> connections_;
-  std::unordered_map<uint64_t, std::shared_ptr<TcpSession>> sessions_;
-  int64_t last_heartbeat_check_ms_ = 0;
+  SessionRegistry sessions_;
+  // 心跳超时时间轮：会话建立时登记，到期时复核最后心跳，未超时则按新截止时间重新登记
+  std::mutex heartbeat_mutex_;
+  TimingWheel heartbeat_wheel_;
+  std::vector<uint64_t> heartbeat_expired_;
+  int64_t next_metrics_report_ms_ = 0;
+  SendPolicy send_policy_;
+  SessionHandler session_opened_handler_;
+  SessionHandler session_closed_handler_;
+  uint32_t max_messages_per_sec_ = TcpSession::kDefaultMaxMessagesPerSec;
+  uint32_t max_bytes_per_sec_ = TcpSession::kDefaultMaxBytesPerSec;
 };
 
 }  // namespace mir2::network
@@ -6,10 +6,41 @@ std::vector<uint8_t> PacketCodec::Encode(uint16_t msg_id, const uint8_t* payload
   return mir2::common::EncodePacket(msg_id, payload, payload_size);
 }
 
+PooledBuffer PacketCodec::EncodePooled(uint16_t msg_id, const uint8_t* payload,
+                                       size_t payload_size) {
+  if (payload_size > mir2::common::kMaxPayloadSize) {
+    return {};
+  }
+  auto buffer = BufferPool::Acquire(PacketHeader::kSize + payload_size);
+  if (mir2::common::EncodePacketInto(msg_id, payload, payload_size, buffer.Data(),
+                                     buffer.Size()) == 0) {
+    return {};
+  }
+  return buffer;
+}
+
+PooledBuffer PacketCodec::EncodeGatherPooled(uint16_t msg_id, PayloadView prefix,
+                                             PayloadView payload) {
+  const size_t payload_size = prefix.size() + payload.size();
+  if (payload_size > mir2::common::kMaxPayloadSize) {
+    return {};
+  }
+  auto buffer = BufferPool::Acquire(PacketHeader::kSize + payload_size);
+  if (mir2::common::EncodePacketGatherInto(msg_id, prefix, payload, buffer.Data(),
+                                           buffer.Size()) == 0) {
+    return {};
+  }
+  return buffer;
+}
+
 DecodeStatus PacketCodec::Decode(const uint8_t* data, size_t length, Packet* out_packet) {
   return mir2::common::DecodePacket(data, length, out_packet);
 }
 
+DecodeStatus PacketCodec::DecodeView(const uint8_t* data, size_t length, PacketView* out_view) {
+  return mir2::common::DecodePacketView(data, length, out_view);
+}
+
 std::vector<uint8_t> PacketCodec::EncodeV2(uint16_t msg_id,
                                            const uint8_t* payload,
                                            size_t payload_size,
@@ -18,6 +49,39 @@ std::vector<uint8_t> PacketCodec::EncodeV2(uint16_t msg_id,
   return mir2::common::EncodePacketV2(msg_id, payload, payload_size, sequence, flags);
 }
 
+PooledBuffer PacketCodec::EncodeV2Pooled(uint16_t msg_id,
+                                         const uint8_t* payload,
+                                         size_t payload_size,
+                                         uint16_t sequence,
+                                         uint8_t flags) {
+  if (payload_size > mir2::common::kMaxPayloadSize) {
+    return {};
+  }
+  auto buffer = BufferPool::Acquire(PacketHeaderV2::kSize + payload_size);
+  if (mir2::common::EncodePacketV2Into(msg_id, payload, payload_size, sequence, flags,
+                                       buffer.Data(), buffer.Size()) == 0) {
+    return {};
+  }
+  return buffer;
+}
+
+PooledBuffer PacketCodec::EncodeV2GatherPooled(uint16_t msg_id,
+                                               PayloadView prefix,
+                                               PayloadView payload,
+                                               uint16_t sequence,
+                                               uint8_t flags) {
+  const size_t payload_size = prefix.size() + payload.size();
+  if (payload_size > mir2::common::kMaxPayloadSize) {
+    return {};
+  }
+  auto buffer = BufferPool::Acquire(PacketHeaderV2::kSize + payload_size);
+  if (mir2::common::EncodePacketV2GatherInto(msg_id, prefix, payload, sequence, flags,
+                                             buffer.Data(), buffer.Size()) == 0) {
+    return {};
+  }
+  return buffer;
+}
+
 DecodeStatus PacketCodec::DecodeV2(const uint8_t* data,
                                    size_t length,
                                    Packet* out_packet,
@@ -26,4 +90,12 @@ DecodeStatus PacketCodec::DecodeV2(const uint8_t* data,
   return mir2::common::DecodePacketV2(data, length, out_packet, out_sequence, out_flags);
 }
 
+DecodeStatus PacketCodec::DecodeV2View(const uint8_t* data,
+                                       size_t length,
+                                       PacketView* out_view,
+                                       uint16_t* out_sequence,
+                                       uint8_t* out_flags) {
+  return mir2::common::DecodePacketV2View(data, length, out_view, out_sequence, out_flags);
+}
+
 }  // namespace mir2::network
@@ -6,13 +6,18 @@
 #ifndef MIR2_NETWORK_PACKET_CODEC_H
 #define MIR2_NETWORK_PACKET_CODEC_H
 
+#include <span>
+
 #include "common/protocol/packet_codec.h"
+#include "network/buffer_pool.h"
 
 namespace mir2::network {
 
 using PacketHeader = mir2::common::PacketHeader;
 using PacketHeaderV2 = mir2::common::PacketHeaderV2;
 using Packet = mir2::common::NetworkPacket;
+using PacketView = mir2::common::NetworkPacketView;
+using PayloadView = std::span<const uint8_t>;
 using DecodeStatus = mir2::common::DecodeStatus;
 using ProtocolVersion = mir2::common::ProtocolVersion;
 
@@ -26,11 +31,26 @@ class PacketCodec {
    */
   static std::vector<uint8_t> Encode(uint16_t msg_id, const uint8_t* payload, size_t payload_size);
 
+  /**
+   * @brief 编码网络包到池化缓冲（负载超限时返回空缓冲）
+   */
+  static PooledBuffer EncodePooled(uint16_t msg_id, const uint8_t* payload, size_t payload_size);
+
+  /**
+   * @brief 编码 prefix + payload 拼接负载到池化缓冲（超限时返回空缓冲）
+   */
+  static PooledBuffer EncodeGatherPooled(uint16_t msg_id, PayloadView prefix, PayloadView payload);
+
   /**
    * @brief 解码网络包
    */
   static DecodeStatus Decode(const uint8_t* data, size_t length, Packet* out_packet);
 
+  /**
+   * @brief 解码网络包（零拷贝视图）
+   */
+  static DecodeStatus DecodeView(const uint8_t* data, size_t length, PacketView* out_view);
+
   /**
    * @brief 编码 V2 网络包
    */
@@ -40,6 +60,24 @@ class PacketCodec {
                                        uint16_t sequence,
                                        uint8_t flags = 0);
 
+  /**
+   * @brief 编码 V2 网络包到池化缓冲（负载超限时返回空缓冲）
+   */
+  static PooledBuffer EncodeV2Pooled(uint16_t msg_id,
+                                     const uint8_t* payload,
+                                     size_t payload_size,
+                                     uint16_t sequence,
+                                     uint8_t flags = 0);
+
+  /**
+   * @brief V2 编码 prefix + payload 拼接负载到池化缓冲（超限时返回空缓冲）
+   */
+  static PooledBuffer EncodeV2GatherPooled(uint16_t msg_id,
+                                           PayloadView prefix,
+                                           PayloadView payload,
+                                           uint16_t sequence,
+                                           uint8_t flags = 0);
+
   /**
    * @brief 解码 V2 网络包
    */
@@ -48,6 +86,15 @@ class PacketCodec {
                                Packet* out_packet,
                                uint16_t* out_sequence = nullptr,
                                uint8_t* out_flags = nullptr);
+
+  /**
+   * @brief 解码 V2 网络包（零拷贝视图）
+   */
+  static DecodeStatus DecodeV2View(const uint8_t* data,
+                                   size_t length,
+                                   PacketView* out_view,
+                                   uint16_t* out_sequence = nullptr,
+                                   uint8_t* out_flags = nullptr);
 };
 
 }  // namespace mir2::network
@@ -0,0 +1,43 @@
+#include "network/receive_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mir2::network {
+
+bool ReceiveBuffer::Append(const uint8_t* data, size_t size) {
+  if (size == 0) {
+    return true;
+  }
+  const size_t pending = Size();
+  if (size > capacity_ - pending) {
+    return false;
+  }
+
+  if (storage_.size() - write_pos_ < size) {
+    if (read_pos_ > 0) {
+      if (pending > 0) {
+        std::memmove(storage_.data(), storage_.data() + read_pos_, pending);
+      }
+      read_pos_ = 0;
+      write_pos_ = pending;
+    }
+    if (storage_.size() - write_pos_ < size) {
+      const size_t required = write_pos_ + size;
+      storage_.resize(std::min(capacity_, std::max(required, storage_.size() * 2)));
+    }
+  }
+
+  std::memcpy(storage_.data() + write_pos_, data, size);
+  write_pos_ += size;
+  return true;
+}
+
+void ReceiveBuffer::Consume(size_t size) {
+  read_pos_ += std::min(size, Size());
+  if (read_pos_ == write_pos_) {
+    read_pos_ = write_pos_ = 0;
+  }
+}
+
+}  // namespace mir2::network
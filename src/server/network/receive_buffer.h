@@ -0,0 +1,52 @@
+/**
+ * @file receive_buffer.h
+ * @brief 会话接收缓冲区
+ */
+
+#ifndef MIR2_NETWORK_RECEIVE_BUFFER_H
+#define MIR2_NETWORK_RECEIVE_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mir2::network {
+
+/**
+ * @brief 定容接收缓冲区
+ *
+ * 读写游标分离：Consume 只移动读游标（O(1)），仅在尾部空间不足时才把未读数据
+ * 整体前移一次。存储按需倍增至容量上限后不再释放，稳态下不产生堆分配。
+ * 未读数据始终连续，便于直接在其上构造零拷贝包视图。
+ */
+class ReceiveBuffer {
+ public:
+  explicit ReceiveBuffer(size_t capacity) : capacity_(capacity) {}
+
+  const uint8_t* Data() const { return storage_.data() + read_pos_; }
+  size_t Size() const { return write_pos_ - read_pos_; }
+  bool Empty() const { return read_pos_ == write_pos_; }
+  size_t Capacity() const { return capacity_; }
+
+  /**
+   * @brief 追加数据；超过容量返回 false 且不修改缓冲区
+   */
+  bool Append(const uint8_t* data, size_t size);
+
+  /**
+   * @brief 丢弃已处理的前 size 字节
+   */
+  void Consume(size_t size);
+
+  void Clear() { read_pos_ = write_pos_ = 0; }
+
+ private:
+  size_t capacity_ = 0;
+  std::vector<uint8_t> storage_;
+  size_t read_pos_ = 0;
+  size_t write_pos_ = 0;
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_RECEIVE_BUFFER_H
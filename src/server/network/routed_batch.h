@@ -0,0 +1,88 @@
+/**
+ * @file routed_batch.h
+ * @brief 内部路由帧攒批（网关与后端之间按 Tick 合并 kRoutedFrame）
+ */
+
+#ifndef MIR2_NETWORK_ROUTED_BATCH_H
+#define MIR2_NETWORK_ROUTED_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "server/common/routed_envelope.h"
+
+namespace mir2::network {
+
+/**
+ * @brief 路由帧批次
+ *
+ * 把多条路由帧首尾相接攒成一个 kRoutedBatch 负载，Flush（通常在 Tick 末尾）或
+ * 批次达到 limit 字节时经调用方提供的 send 写出。写出在批次锁内完成，
+ * 并发追加与冲刷时批次之间的先后顺序不会颠倒。limit 为 0 表示关闭攒批。
+ */
+class RoutedBatch {
+ public:
+  void SetLimit(size_t limit_bytes) { limit_bytes_ = limit_bytes; }
+  bool Enabled() const { return limit_bytes_ > 0; }
+
+  /**
+   * @brief 追加一条路由帧，批次达到上限时立即经 send(bytes, count) 写出
+   */
+  template <typename Sender>
+  void Append(uint64_t client_id, uint16_t msg_id, std::span<const uint8_t> payload,
+              Sender&& send) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mir2::common::AppendRoutedFrame(&bytes_, client_id, msg_id, payload);
+    ++count_;
+    if (bytes_.size() >= limit_bytes_) {
+      DrainLocked(send);
+    }
+  }
+
+  /**
+   * @brief 追加一条组播帧，规则同 Append
+   */
+  template <typename Sender>
+  void AppendMulticast(std::span<const uint64_t> client_ids, uint16_t msg_id,
+                       std::span<const uint8_t> payload, Sender&& send) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mir2::common::AppendRoutedMulticast(&bytes_, client_ids, msg_id, payload);
+    ++count_;
+    if (bytes_.size() >= limit_bytes_) {
+      DrainLocked(send);
+    }
+  }
+
+  /**
+   * @brief 写出已积攒的批次（为空时不调用 send）
+   */
+  template <typename Sender>
+  void Flush(Sender&& send) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DrainLocked(send);
+  }
+
+ private:
+  template <typename Sender>
+  void DrainLocked(Sender& send) {
+    if (count_ == 0) {
+      return;
+    }
+    send(std::span<const uint8_t>(bytes_), count_);
+    // 保留容量，稳态下攒批不再分配
+    bytes_.clear();
+    count_ = 0;
+  }
+
+  size_t limit_bytes_ = 0;
+  std::mutex mutex_;
+  std::vector<uint8_t> bytes_;
+  size_t count_ = 0;
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_ROUTED_BATCH_H
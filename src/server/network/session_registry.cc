@@ -0,0 +1,60 @@
+#include "network/session_registry.h"
+
+#include "network/tcp_session.h"
+
+namespace mir2::network {
+
+std::unique_lock<std::mutex> SessionRegistry::LockShard(const Shard& shard) const {
+  std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    shard.contended_locks.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
+}
+
+uint64_t SessionRegistry::GetContendedLocks() const {
+  uint64_t total = 0;
+  for (const auto& shard : shards_) {
+    total += shard.contended_locks.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void SessionRegistry::Insert(const std::shared_ptr<TcpSession>& session) {
+  if (!session) {
+    return;
+  }
+  const uint64_t session_id = session->GetSessionId();
+  auto& shard = ShardFor(session_id);
+  auto lock = LockShard(shard);
+  if (shard.sessions.insert_or_assign(session_id, session).second) {
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool SessionRegistry::Erase(uint64_t session_id) {
+  auto& shard = ShardFor(session_id);
+  auto lock = LockShard(shard);
+  if (shard.sessions.erase(session_id) == 0) {
+    return false;
+  }
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+std::shared_ptr<TcpSession> SessionRegistry::Find(uint64_t session_id) const {
+  const auto& shard = ShardFor(session_id);
+  auto lock = LockShard(shard);
+  const auto it = shard.sessions.find(session_id);
+  return it != shard.sessions.end() ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<TcpSession>> SessionRegistry::Snapshot() const {
+  std::vector<std::shared_ptr<TcpSession>> result;
+  result.reserve(Size());
+  ForEach([&result](const std::shared_ptr<TcpSession>& session) { result.push_back(session); });
+  return result;
+}
+
+}  // namespace mir2::network
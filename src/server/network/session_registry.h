@@ -0,0 +1,91 @@
+/**
+ * @file session_registry.h
+ * @brief 分片会话表
+ */
+
+#ifndef MIR2_NETWORK_SESSION_REGISTRY_H
+#define MIR2_NETWORK_SESSION_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mir2::network {
+
+class TcpSession;
+
+/**
+ * @brief 会话表
+ *
+ * 按 session_id 分为 kShardCount 个分片，每个分片独占一条缓存行并有各自的互斥锁，
+ * 单次查找只锁一个分片，IO 线程与逻辑线程之间的冲突概率降为约 1/kShardCount。
+ * 获取分片锁时若发生等待，计入该分片自身的原子计数，由持有者周期性汇总导出。
+ */
+class SessionRegistry {
+ public:
+  static constexpr size_t kShardCount = 32;
+
+  /**
+   * @brief 插入或替换会话（以 GetSessionId() 为键）
+   */
+  void Insert(const std::shared_ptr<TcpSession>& session);
+
+  /**
+   * @brief 移除会话，返回是否存在
+   */
+  bool Erase(uint64_t session_id);
+
+  std::shared_ptr<TcpSession> Find(uint64_t session_id) const;
+
+  /**
+   * @brief 复制当前所有会话
+   */
+  std::vector<std::shared_ptr<TcpSession>> Snapshot() const;
+
+  /**
+   * @brief 逐分片遍历会话
+   *
+   * 回调在分片锁内执行，不得再访问本会话表。
+   */
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (const auto& shard : shards_) {
+      auto lock = LockShard(shard);
+      for (const auto& [_, session] : shard.sessions) {
+        if (session) {
+          fn(session);
+        }
+      }
+    }
+  }
+
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 分片锁发生等待的累计次数
+   */
+  uint64_t GetContendedLocks() const;
+
+ private:
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<TcpSession>> sessions;
+    mutable std::atomic<uint64_t> contended_locks{0};
+  };
+
+  Shard& ShardFor(uint64_t session_id) { return shards_[session_id % kShardCount]; }
+  const Shard& ShardFor(uint64_t session_id) const { return shards_[session_id % kShardCount]; }
+  std::unique_lock<std::mutex> LockShard(const Shard& shard) const;
+
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<size_t> size_{0};
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_SESSION_REGISTRY_H
@@ -0,0 +1,49 @@
+#include "network/shared_frame.h"
+
+#include <cstring>
+
+namespace mir2::network {
+
+SharedFrame::SharedFrame(uint16_t msg_id, const uint8_t* payload, size_t payload_size)
+    : msg_id_(msg_id), bytes_(PacketCodec::Encode(msg_id, payload, payload_size)) {
+  if (bytes_.empty()) {
+    return;
+  }
+  payload_crc_ = mir2::common::UpdateCRC16(0, GetPayload(), GetPayloadSize());
+  payload_shift_ = mir2::common::CRC16Shift::ForZeroBytes(GetPayloadSize());
+}
+
+std::shared_ptr<const SharedFrame> SharedFrame::Create(uint16_t msg_id,
+                                                       const uint8_t* payload,
+                                                       size_t payload_size) {
+  return std::make_shared<const SharedFrame>(msg_id, payload, payload_size);
+}
+
+std::shared_ptr<const SharedFrame> SharedFrame::Create(uint16_t msg_id,
+                                                       const std::vector<uint8_t>& payload) {
+  return Create(msg_id, payload.data(), payload.size());
+}
+
+std::shared_ptr<const std::vector<uint8_t>> SharedFrame::GetBytes() const {
+  return std::shared_ptr<const std::vector<uint8_t>>(shared_from_this(), &bytes_);
+}
+
+std::array<uint8_t, PacketHeaderV2::kSize> SharedFrame::BuildHeaderV2(uint16_t sequence,
+                                                                      uint8_t flags) const {
+  PacketHeaderV2 header;
+  header.msg_id = msg_id_;
+  header.payload_size = static_cast<uint32_t>(GetPayloadSize());
+  header.sequence = sequence;
+  header.flags = flags;
+
+  auto bytes = header.ToBytes();
+  const uint16_t header_crc = mir2::common::UpdateCRC16(
+      0xFFFF, bytes.data(), PacketHeaderV2::kSize - sizeof(header.checksum));
+  const uint16_t checksum =
+      static_cast<uint16_t>(payload_shift_.Apply(header_crc) ^ payload_crc_);
+  std::memcpy(bytes.data() + PacketHeaderV2::kSize - sizeof(checksum), &checksum,
+              sizeof(checksum));
+  return bytes;
+}
+
+}  // namespace mir2::network
@@ -0,0 +1,67 @@
+/**
+ * @file shared_frame.h
+ * @brief 编码一次、多会话共享的广播帧
+ */
+
+#ifndef MIR2_NETWORK_SHARED_FRAME_H
+#define MIR2_NETWORK_SHARED_FRAME_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "network/packet_codec.h"
+
+namespace mir2::network {
+
+/**
+ * @brief 不可变、引用计数的广播帧
+ *
+ * 负载只编码一次：V1 会话直接共享完整帧字节；V2 会话各自生成 16 字节包头
+ * （本会话序号 + 由预计算负载 CRC 拼接出的校验和），主体字节仍然共享，不重新编码。
+ */
+class SharedFrame : public std::enable_shared_from_this<SharedFrame> {
+ public:
+  /// 负载在 GetBytes() 中的偏移（紧随 V1 包头）
+  static constexpr size_t kPayloadOffset = PacketHeader::kSize;
+
+  static std::shared_ptr<const SharedFrame> Create(uint16_t msg_id,
+                                                   const uint8_t* payload,
+                                                   size_t payload_size);
+  static std::shared_ptr<const SharedFrame> Create(uint16_t msg_id,
+                                                   const std::vector<uint8_t>& payload);
+
+  /**
+   * @brief 负载超限时编码失败，帧为空
+   */
+  bool IsValid() const { return !bytes_.empty(); }
+
+  uint16_t GetMsgId() const { return msg_id_; }
+  size_t GetPayloadSize() const { return IsValid() ? bytes_.size() - kPayloadOffset : 0; }
+  const uint8_t* GetPayload() const { return bytes_.data() + kPayloadOffset; }
+
+  /**
+   * @brief 完整 V1 帧（包头 + 负载），与帧本身共享生命周期
+   */
+  std::shared_ptr<const std::vector<uint8_t>> GetBytes() const;
+
+  /**
+   * @brief 生成指定序号的 V2 包头（仅 O(1) 计算，不重算负载 CRC）
+   */
+  std::array<uint8_t, PacketHeaderV2::kSize> BuildHeaderV2(uint16_t sequence,
+                                                           uint8_t flags = 0) const;
+
+  SharedFrame(uint16_t msg_id, const uint8_t* payload, size_t payload_size);
+
+ private:
+  uint16_t msg_id_ = 0;
+  std::vector<uint8_t> bytes_;
+  uint16_t payload_crc_ = 0;
+  mir2::common::CRC16Shift payload_shift_;
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_SHARED_FRAME_H
@@ -0,0 +1,45 @@
+#include "network/socket_backend.h"
+
+#include "log/logger.h"
+#include "network/io_uring_socket.h"
+
+namespace mir2::network {
+
+SocketBackend ParseSocketBackend(const std::string& name) {
+  if (name == "io_uring") {
+    return SocketBackend::kIoUring;
+  }
+  if (name != "asio" && !name.empty()) {
+    SYSLOG_WARN("Unknown socket backend '{}', using asio", name);
+  }
+  return SocketBackend::kAsio;
+}
+
+const char* ToString(SocketBackend backend) {
+  switch (backend) {
+    case SocketBackend::kIoUring:
+      return "io_uring";
+    case SocketBackend::kAsio:
+      break;
+  }
+  return "asio";
+}
+
+bool IsSocketBackendAvailable(SocketBackend backend) {
+  if (backend == SocketBackend::kIoUring) {
+    return IoUringSocketAdapter::IsSupported();
+  }
+  return true;
+}
+
+std::unique_ptr<SocketAdapter> CreateSocketAdapter(asio::ip::tcp::socket socket,
+                                                   SocketBackend backend) {
+  if (backend == SocketBackend::kIoUring) {
+    if (auto adapter = IoUringSocketAdapter::Create(socket)) {
+      return adapter;
+    }
+  }
+  return std::make_unique<AsioSocketAdapter>(std::move(socket));
+}
+
+}  // namespace mir2::network
@@ -0,0 +1,46 @@
+/**
+ * @file socket_backend.h
+ * @brief Socket 后端选择（asio / io_uring）
+ */
+
+#ifndef MIR2_NETWORK_SOCKET_BACKEND_H
+#define MIR2_NETWORK_SOCKET_BACKEND_H
+
+#include <memory>
+#include <string>
+
+#include <asio/ip/tcp.hpp>
+
+#include "network/tcp_connection.h"
+
+namespace mir2::network {
+
+/**
+ * @brief 连接读写所用的 Socket 后端
+ */
+enum class SocketBackend {
+  kAsio,    ///< AsioSocketAdapter（默认，跨平台）
+  kIoUring  ///< IoUringSocketAdapter（仅 Linux）
+};
+
+/**
+ * @brief 解析配置值（"asio" / "io_uring"），未知值返回 kAsio
+ */
+SocketBackend ParseSocketBackend(const std::string& name);
+
+const char* ToString(SocketBackend backend);
+
+/**
+ * @brief 当前进程能否使用指定后端（io_uring 需要编译期支持且内核允许创建 ring）
+ */
+bool IsSocketBackendAvailable(SocketBackend backend);
+
+/**
+ * @brief 为已连接的 socket 创建适配器；io_uring 不可用时退回 asio
+ */
+std::unique_ptr<SocketAdapter> CreateSocketAdapter(asio::ip::tcp::socket socket,
+                                                   SocketBackend backend);
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_SOCKET_BACKEND_H
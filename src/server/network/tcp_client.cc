@@ -3,6 +3,10 @@
 #include <asio/connect.hpp>
 #include <asio/ip/tcp.hpp>
 
+#include "common/enums.h"
+#include "monitor/metrics.h"
+#include "server/common/routed_envelope.h"
+
 namespace mir2::network {
 
 namespace {
@@ -63,6 +67,65 @@ void TcpClient::Send(uint16_t msg_id, const std::vector<uint8_t>& payload) {
   connection_->SendRaw(buffer);
 }
 
+void TcpClient::SendRouted(uint64_t client_id, uint16_t msg_id,
+                           std::span<const uint8_t> payload) {
+  if (!connection_) {
+    return;
+  }
+  if (routed_batch_.Enabled()) {
+    routed_batch_.Append(client_id, msg_id, payload,
+                         [this](std::span<const uint8_t> batch, size_t frame_count) {
+                           SendRoutedBatch(batch, frame_count);
+                         });
+    return;
+  }
+  mir2::common::RoutedEnvelope envelope;
+  envelope.client_id = client_id;
+  envelope.msg_id = msg_id;
+  envelope.payload_size = static_cast<uint32_t>(payload.size());
+  const auto envelope_bytes = envelope.ToBytes();
+  const uint16_t frame_msg_id = static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedFrame);
+
+  PooledBuffer buffer;
+  if (protocol_version_ == ProtocolVersion::kV2) {
+    const uint16_t sequence = send_sequence_.fetch_add(1, std::memory_order_relaxed);
+    buffer = PacketCodec::EncodeV2GatherPooled(frame_msg_id, envelope_bytes, payload, sequence);
+  } else {
+    buffer = PacketCodec::EncodeGatherPooled(frame_msg_id, envelope_bytes, payload);
+  }
+  if (buffer.Empty()) {
+    return;
+  }
+  connection_->SendBuffer(std::move(buffer));
+}
+
+void TcpClient::Flush() {
+  if (!connection_ || !routed_batch_.Enabled()) {
+    return;
+  }
+  routed_batch_.Flush([this](std::span<const uint8_t> batch, size_t frame_count) {
+    SendRoutedBatch(batch, frame_count);
+  });
+}
+
+void TcpClient::SendRoutedBatch(std::span<const uint8_t> batch, size_t frame_count) {
+  const uint16_t batch_msg_id = static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedBatch);
+  PooledBuffer buffer;
+  if (protocol_version_ == ProtocolVersion::kV2) {
+    const uint16_t sequence = send_sequence_.fetch_add(1, std::memory_order_relaxed);
+    buffer = PacketCodec::EncodeV2Pooled(batch_msg_id, batch.data(), batch.size(), sequence);
+  } else {
+    buffer = PacketCodec::EncodePooled(batch_msg_id, batch.data(), batch.size());
+  }
+  if (buffer.Empty()) {
+    return;
+  }
+  connection_->SendBuffer(std::move(buffer));
+  auto& metrics = monitor::Metrics::Instance();
+  metrics.IncrementCounter("network.routed_batch.batches");
+  metrics.AddCounter("network.routed_batch.frames", frame_count);
+}
+
 void TcpClient::Close() {
   if (connection_) {
     connection_->Close();
@@ -129,17 +192,17 @@ void TcpClient::HandleBytes(const uint8_t* data, size_t size) {
       return;
     }
 
-    Packet packet{};
+    PacketView packet{};
     if (protocol_version_ == ProtocolVersion::kV2) {
       uint16_t sequence = 0;
       const auto status =
-          PacketCodec::DecodeV2(read_buffer_.data(), packet_size, &packet, &sequence);
+          PacketCodec::DecodeV2View(read_buffer_.data(), packet_size, &packet, &sequence);
       if (status != DecodeStatus::kOk || !CheckRecvSequence(sequence)) {
         Close();
         return;
       }
     } else {
-      const auto status = PacketCodec::Decode(read_buffer_.data(), packet_size, &packet);
+      const auto status = PacketCodec::DecodeView(read_buffer_.data(), packet_size, &packet);
       if (status != DecodeStatus::kOk) {
         Close();
         return;
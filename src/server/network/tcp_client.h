@@ -11,12 +11,14 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <asio/io_context.hpp>
 
 #include "network/packet_codec.h"
+#include "network/routed_batch.h"
 #include "network/tcp_connection.h"
 
 namespace mir2::network {
@@ -26,7 +28,8 @@ namespace mir2::network {
  */
 class TcpClient {
  public:
-  using PacketHandler = std::function<void(const Packet&)>;
+  // 负载视图指向接收缓冲，仅在回调期间有效
+  using PacketHandler = std::function<void(const PacketView&)>;
   using DisconnectHandler = std::function<void()>;
 
   explicit TcpClient(asio::io_context& io_context);
@@ -41,6 +44,21 @@ class TcpClient {
    */
   void Send(uint16_t msg_id, const std::vector<uint8_t>& payload);
 
+  /**
+   * @brief 以定长路由信封转发客户端消息（kRoutedFrame），信封与负载直接编码进发送缓冲
+   */
+  void SendRouted(uint64_t client_id, uint16_t msg_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief 开启路由帧攒批（0 表示逐条发送）；开启后 SendRouted 积攒到 Flush 或达到上限
+   */
+  void SetRoutedBatchBytes(size_t limit_bytes) { routed_batch_.SetLimit(limit_bytes); }
+
+  /**
+   * @brief 写出积攒的路由批次
+   */
+  void Flush();
+
   /**
    * @brief 关闭连接
    */
@@ -48,6 +66,11 @@ class TcpClient {
 
   bool IsConnected() const { return connected_.load(); }
 
+  /**
+   * @brief 发送队列中尚未写出的字节数
+   */
+  size_t GetQueuedBytes() const { return connection_ ? connection_->GetQueuedBytes() : 0; }
+
   void SetPacketHandler(PacketHandler handler) { packet_handler_ = std::move(handler); }
   void SetDisconnectHandler(DisconnectHandler handler) { disconnect_handler_ = std::move(handler); }
 
@@ -55,6 +78,7 @@ class TcpClient {
   void HandleDisconnect(uint64_t connection_id);
   void HandleBytes(const uint8_t* data, size_t size);
   bool CheckRecvSequence(uint16_t seq);
+  void SendRoutedBatch(std::span<const uint8_t> batch, size_t frame_count);
 
   asio::io_context& io_context_;
   std::shared_ptr<TcpConnection> connection_;
@@ -66,6 +90,7 @@ class TcpClient {
   bool protocol_version_detected_ = false;
   std::atomic<uint16_t> send_sequence_{0};
   std::atomic<uint16_t> recv_sequence_{0};
+  RoutedBatch routed_batch_;
 };
 
 }  // namespace mir2::network
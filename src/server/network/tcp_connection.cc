@@ -1,5 +1,8 @@
 #include "network/tcp_connection.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <asio/dispatch.hpp>
 #include <asio/post.hpp>
 
@@ -22,21 +25,234 @@ void TcpConnection::Start() {
   DoRead();
 }
 
+size_t TcpConnection::WriteEntry::Size() const {
+  size_t size = header_size + owned.Size();
+  if (shared && shared_offset < shared->size()) {
+    size += shared->size() - shared_offset;
+  }
+  return size;
+}
+
+void TcpConnection::WriteEntry::AppendBuffers(std::vector<asio::const_buffer>* buffers) const {
+  if (header_size > 0) {
+    buffers->emplace_back(header.data(), header_size);
+  }
+  if (!owned.Empty()) {
+    buffers->emplace_back(owned.Data(), owned.Size());
+  }
+  if (shared && shared_offset < shared->size()) {
+    buffers->emplace_back(shared->data() + shared_offset, shared->size() - shared_offset);
+  }
+}
+
 void TcpConnection::SendRaw(const std::vector<uint8_t>& bytes) {
-  monitor::Metrics::Instance().AddBytesOut(bytes.size());
+  if (bytes.empty()) {
+    return;
+  }
+  auto buffer = BufferPool::Acquire(bytes.size());
+  std::memcpy(buffer.Data(), bytes.data(), bytes.size());
+  SendBuffer(std::move(buffer));
+}
+
+void TcpConnection::SendBuffer(PooledBuffer buffer, uint64_t replace_key) {
+  if (buffer.Empty()) {
+    return;
+  }
+  WriteEntry entry;
+  entry.owned = std::move(buffer);
+  entry.replace_key = replace_key;
+  Enqueue(std::move(entry));
+}
+
+void TcpConnection::SendShared(const uint8_t* header, size_t header_size,
+                               std::shared_ptr<const std::vector<uint8_t>> body,
+                               size_t body_offset, uint64_t replace_key) {
+  if (header_size > kMaxFrameHeaderSize) {
+    SYSLOG_ERROR("Frame header too large (size={}), connection {}", header_size, connection_id_);
+    return;
+  }
+  WriteEntry entry;
+  if (header && header_size > 0) {
+    std::memcpy(entry.header.data(), header, header_size);
+    entry.header_size = header_size;
+  }
+  entry.shared = std::move(body);
+  entry.shared_offset = body_offset;
+  entry.replace_key = replace_key;
+  Enqueue(std::move(entry));
+}
+
+void TcpConnection::ApplySendPolicy(const SendPolicy& policy) {
+  asio::error_code ec;
+  socket_->set_no_delay(policy.tcp_nodelay, ec);
+  if (ec) {
+    SYSLOG_WARN("Failed to set TCP_NODELAY on connection {}: {}", connection_id_, ec.message());
+  }
+
+  bool flush = false;
+  {
+    std::lock_guard<std::mutex> lock(send_inbox_mutex_);
+    flush = corked_ && !policy.cork;
+    corked_ = policy.cork;
+    cork_bytes_ = policy.cork_bytes;
+  }
+  if (flush) {
+    Flush();
+  }
+}
+
+void TcpConnection::Enqueue(WriteEntry entry) {
+  const size_t entry_size = entry.Size();
+  monitor::Metrics::Instance().AddBytesOut(entry_size);
+  bool cork_threshold_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(send_inbox_mutex_);
+    send_inbox_.push_back(std::move(entry));
+    send_inbox_bytes_ += entry_size;
+    if (send_inbox_scheduled_) {
+      return;
+    }
+    if (corked_) {
+      if (send_inbox_bytes_ < cork_bytes_) {
+        return;
+      }
+      cork_threshold_flush = true;
+    }
+    send_inbox_scheduled_ = true;
+  }
+  // 指标表有自己的锁，放到 send_inbox_mutex_ 之外计数，避免延长 IO 线程的等待
+  if (cork_threshold_flush) {
+    monitor::Metrics::Instance().IncrementCounter("network.send.cork_threshold_flush");
+  }
+  // 每批只投递一次：逻辑线程跨线程 post 需要分配处理器，按消息投递会抵消缓冲池的收益
   auto self = shared_from_this();
-  asio::post(socket_->GetExecutor(), [this, self, data = bytes]() mutable {
-    if (write_queue_.size() >= kMaxWriteQueueSize) {
-      SYSLOG_WARN("Write queue full (size={}), closing connection {}",
-                  write_queue_.size(), connection_id_);
-      Close();
+  asio::post(socket_->GetExecutor(), [this, self]() { DrainSendInbox(); });
+}
+
+void TcpConnection::Flush() {
+  {
+    std::lock_guard<std::mutex> lock(send_inbox_mutex_);
+    if (send_inbox_.empty() || send_inbox_scheduled_) {
       return;
     }
-    write_queue_.push_back(std::move(data));
-    if (!writing_.exchange(true)) {
-      DoWrite();
+    send_inbox_scheduled_ = true;
+  }
+  auto self = shared_from_this();
+  asio::post(socket_->GetExecutor(), [this, self]() { DrainSendInbox(); });
+}
+
+size_t TcpConnection::GetQueuedBytes() const {
+  std::lock_guard<std::mutex> lock(send_inbox_mutex_);
+  return send_inbox_bytes_ + queued_bytes_snapshot_.load(std::memory_order_relaxed);
+}
+
+void TcpConnection::DrainSendInbox() {
+  {
+    std::lock_guard<std::mutex> lock(send_inbox_mutex_);
+    send_staging_.swap(send_inbox_);
+    send_inbox_bytes_ = 0;
+    send_inbox_scheduled_ = false;
+  }
+
+  AdmitStats stats;
+  bool admitted = true;
+  for (auto& entry : send_staging_) {
+    if (!AdmitEntry(entry, stats)) {
+      admitted = false;
+      break;
     }
-  });
+  }
+  send_staging_.clear();
+  ReportAdmitStats(stats);
+  if (!admitted) {
+    SYSLOG_WARN("Write queue over high-water mark (bytes={}, entries={}), closing connection {}",
+                write_queue_bytes_, write_queue_.size() + write_inflight_.size(), connection_id_);
+    Close();
+    return;
+  }
+  queued_bytes_snapshot_.store(write_queue_bytes_, std::memory_order_relaxed);
+
+  if (!writing_.exchange(true)) {
+    DoWrite();
+  }
+}
+
+bool TcpConnection::AdmitEntry(WriteEntry& entry, AdmitStats& stats) {
+  const size_t entry_size = entry.Size();
+  auto over_limit = [this, &entry, entry_size]() {
+    // 单条超过水位的大包仍允许在空队列时发出
+    if (write_queue_bytes_ == 0) {
+      return false;
+    }
+    if (write_queue_bytes_ + entry_size > kMaxWriteQueueBytes) {
+      return true;
+    }
+    return entry.replace_key != 0 && replaceable_bytes_ + entry_size > kMaxReplaceableQueueBytes;
+  };
+
+  if (entry.replace_key != 0) {
+    // 新状态追加到队尾而不是覆盖原位置，保证不早于其前面发出的可靠消息
+    const auto it = replaceable_index_.find(entry.replace_key);
+    if (it != replaceable_index_.end() && it->second >= write_queue_base_) {
+      DropQueuedEntry(write_queue_[it->second - write_queue_base_]);
+      ++stats.replaced;
+    }
+  }
+
+  while (over_limit()) {
+    if (!ShedOldestReplaceable()) {
+      if (entry.replace_key == 0) {
+        return false;
+      }
+      // 没有更旧的状态可丢，丢弃本条
+      replaceable_index_.erase(entry.replace_key);
+      ++stats.shed;
+      return true;
+    }
+    ++stats.shed;
+  }
+
+  if (entry.replace_key != 0) {
+    replaceable_index_[entry.replace_key] = write_queue_base_ + write_queue_.size();
+    replaceable_bytes_ += entry_size;
+  }
+  write_queue_.push_back(std::move(entry));
+  write_queue_bytes_ += entry_size;
+  return true;
+}
+
+void TcpConnection::ReportAdmitStats(const AdmitStats& stats) {
+  // 按批上报：每条都查一次字符串键的指标表在慢客户端大量丢状态时开销可观
+  if (stats.replaced > 0) {
+    monitor::Metrics::Instance().AddCounter("network.send.state_replaced", stats.replaced);
+  }
+  if (stats.shed > 0) {
+    monitor::Metrics::Instance().AddCounter("network.send.state_shed", stats.shed);
+  }
+}
+
+bool TcpConnection::ShedOldestReplaceable() {
+  size_t position = std::max(shed_cursor_, write_queue_base_);
+  for (; position - write_queue_base_ < write_queue_.size(); ++position) {
+    auto& entry = write_queue_[position - write_queue_base_];
+    if (entry.replace_key != 0) {
+      replaceable_index_.erase(entry.replace_key);
+      DropQueuedEntry(entry);
+      shed_cursor_ = position + 1;
+      return true;
+    }
+  }
+  shed_cursor_ = position;
+  return false;
+}
+
+void TcpConnection::DropQueuedEntry(WriteEntry& entry) {
+  const size_t entry_size = entry.Size();
+  write_queue_bytes_ -= entry_size;
+  if (entry.replace_key != 0) {
+    replaceable_bytes_ -= entry_size;
+  }
+  entry = WriteEntry{};
 }
 
 void TcpConnection::Close() {
@@ -89,22 +305,73 @@ void TcpConnection::DoWrite() {
     return;
   }
 
+  // 合并队列中的连续条目为一次分散-聚集写，总字节受 kMaxWriteBatchBytes 约束（至少一条非空条目）
+  size_t batch_count = 0;
+  size_t batch_replaceable_bytes = 0;
+  write_batch_bytes_ = 0;
+  for (const auto& entry : write_queue_) {
+    const size_t entry_size = entry.Size();
+    if (write_batch_bytes_ > 0 && write_batch_bytes_ + entry_size > kMaxWriteBatchBytes) {
+      break;
+    }
+    ++batch_count;
+    write_batch_bytes_ += entry_size;
+    if (entry.replace_key != 0) {
+      batch_replaceable_bytes += entry_size;
+    }
+  }
+  // 进入在途的条目不再可替换
+  replaceable_bytes_ -= batch_replaceable_bytes;
+  write_queue_base_ += batch_count;
+
+  // 批次移入在途队列后再取缓冲地址：之后的入队可能让 write_queue_ 扩容搬移
+  if (batch_count == write_queue_.size()) {
+    write_inflight_.swap(write_queue_);
+  } else {
+    const auto batch_end = write_queue_.begin() + static_cast<std::ptrdiff_t>(batch_count);
+    write_inflight_.insert(write_inflight_.end(), std::make_move_iterator(write_queue_.begin()),
+                           std::make_move_iterator(batch_end));
+    write_queue_.erase(write_queue_.begin(), batch_end);
+  }
+  if (write_queue_.empty()) {
+    replaceable_index_.clear();
+  }
+
+  write_buffers_.clear();
+  for (const auto& entry : write_inflight_) {
+    entry.AppendBuffers(&write_buffers_);
+  }
+  if (write_buffers_.empty()) {
+    // 剩余条目全部是已丢弃的空洞
+    write_inflight_.clear();
+    writing_.store(false);
+    return;
+  }
+
   auto self = shared_from_this();
-  socket_->async_write(asio::buffer(write_queue_.front()),
-                       [this, self](const asio::error_code& ec, std::size_t) {
-                         if (ec) {
-                           monitor::Metrics::Instance().IncrementError("write");
-                           Close();
-                           return;
-                         }
-
-                         write_queue_.pop_front();
-                         if (!write_queue_.empty()) {
-                           DoWrite();
-                         } else {
-                           writing_.store(false);
-                         }
-                       });
+  auto on_written = [this, self](const asio::error_code& ec, std::size_t) {
+    // 清空而非释放：池化缓冲在此归还当前 IO 线程的缓存，vector 保留容量
+    write_inflight_.clear();
+    write_queue_bytes_ -= write_batch_bytes_;
+    queued_bytes_snapshot_.store(write_queue_bytes_, std::memory_order_relaxed);
+    if (ec) {
+      monitor::Metrics::Instance().IncrementError("write");
+      Close();
+      return;
+    }
+
+    if (!write_queue_.empty()) {
+      DoWrite();
+    } else {
+      writing_.store(false);
+    }
+  };
+
+  if (write_buffers_.size() == 1) {
+    socket_->async_write(write_buffers_.front(), std::move(on_written));
+  } else {
+    socket_->async_write_gather(write_buffers_, std::move(on_written));
+  }
 }
 
 }  // namespace mir2::network
@@ -10,11 +10,12 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -23,6 +24,8 @@
 #include <asio/ip/tcp.hpp>
 #include <asio/write.hpp>
 
+#include "network/buffer_pool.h"
+
 namespace mir2::network {
 
 using IoExecutor =
@@ -38,6 +41,28 @@ class SocketAdapter {
   virtual ~SocketAdapter() = default;
   virtual void async_read_some(const asio::mutable_buffer& buffer, IoHandler handler) = 0;
   virtual void async_write(const asio::const_buffer& buffer, IoHandler handler) = 0;
+
+  /**
+   * @brief 分散-聚集写（默认实现：拼接为单块后写出）
+   */
+  virtual void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                                  IoHandler handler) {
+    auto flat = std::make_shared<std::vector<uint8_t>>();
+    flat->reserve(asio::buffer_size(buffers));
+    for (const auto& buffer : buffers) {
+      const auto* data = static_cast<const uint8_t*>(buffer.data());
+      flat->insert(flat->end(), data, data + buffer.size());
+    }
+    async_write(asio::buffer(*flat),
+                [flat, handler = std::move(handler)](const asio::error_code& ec,
+                                                     std::size_t bytes) { handler(ec, bytes); });
+  }
+
+  /**
+   * @brief 设置 TCP_NODELAY（默认实现：不支持的适配器忽略）
+   */
+  virtual void set_no_delay(bool /*enabled*/, asio::error_code& ec) { ec.clear(); }
+
   virtual void shutdown(asio::ip::tcp::socket::shutdown_type type, asio::error_code& ec) = 0;
   virtual void close(asio::error_code& ec) = 0;
   virtual asio::ip::tcp::endpoint remote_endpoint(asio::error_code& ec) const = 0;
@@ -59,6 +84,15 @@ class AsioSocketAdapter : public SocketAdapter {
     asio::async_write(socket_, buffer, std::move(handler));
   }
 
+  void async_write_gather(const std::vector<asio::const_buffer>& buffers,
+                          IoHandler handler) override {
+    asio::async_write(socket_, buffers, std::move(handler));
+  }
+
+  void set_no_delay(bool enabled, asio::error_code& ec) override {
+    socket_.set_option(asio::ip::tcp::no_delay(enabled), ec);
+  }
+
   void shutdown(asio::ip::tcp::socket::shutdown_type type, asio::error_code& ec) override {
     socket_.shutdown(type, ec);
   }
@@ -77,6 +111,20 @@ class AsioSocketAdapter : public SocketAdapter {
   asio::ip::tcp::socket socket_;
 };
 
+/**
+ * @brief 发送策略
+ *
+ * cork 开启时，发送先积攒在连接的待发批次中，直到 Flush（通常在逻辑 Tick 末尾）
+ * 或批次达到 cork_bytes 才投递写出：以至多一个 Tick 的延迟换取更少的包与系统调用。
+ */
+struct SendPolicy {
+  bool cork = false;
+  size_t cork_bytes = 16 * 1024;
+  bool tcp_nodelay = true;
+  size_t compression_threshold = 0;  // 由 TcpSession 使用，0 表示不压缩
+  size_t routed_batch_bytes = 0;     // 由 TcpSession 使用：路由帧攒批上限，0 表示逐条发送
+};
+
 /**
  * @brief TCP连接
  */
@@ -97,6 +145,38 @@ class TcpConnection : public std::enable_shared_from_this<TcpConnection> {
    */
   void SendRaw(const std::vector<uint8_t>& bytes);
 
+  /**
+   * @brief 发送已编码的池化帧（转移所有权，写完成后归还缓冲池）
+   *
+   * replace_key 非 0 表示可替换状态：同键尚未写出的旧帧被丢弃，拥塞时优先丢弃这类帧；
+   * 为 0 的可靠帧只在可替换帧全部丢弃后仍超出上限时才断开连接。
+   */
+  void SendBuffer(PooledBuffer buffer, uint64_t replace_key = 0);
+
+  /**
+   * @brief 发送共享帧：私有小包头（可为空）+ 多连接共享的只读主体，不复制主体
+   *
+   * replace_key 语义同 SendBuffer。
+   */
+  void SendShared(const uint8_t* header, size_t header_size,
+                  std::shared_ptr<const std::vector<uint8_t>> body, size_t body_offset = 0,
+                  uint64_t replace_key = 0);
+
+  /**
+   * @brief 应用发送策略（应在 Start 之前调用）
+   */
+  void ApplySendPolicy(const SendPolicy& policy);
+
+  /**
+   * @brief 立即投递已积攒的发送批次（未开启 cork 时无需调用）
+   */
+  void Flush();
+
+  /**
+   * @brief 尚未写出的字节数（待投递 + 待写 + 写出中），用于队列深度监控
+   */
+  size_t GetQueuedBytes() const;
+
   /**
    * @brief 关闭连接
    */
@@ -119,16 +199,88 @@ class TcpConnection : public std::enable_shared_from_this<TcpConnection> {
 
  private:
   // Prevent unbounded memory growth when clients read slowly.
-  static constexpr size_t kMaxWriteQueueSize = 100;
+  static constexpr size_t kMaxWriteQueueBytes = 1024 * 1024;
+  // Replaceable state may only use part of the budget so reliable messages keep headroom.
+  static constexpr size_t kMaxReplaceableQueueBytes = 256 * 1024;
+  // Upper bound for one coalesced gather write.
+  static constexpr size_t kMaxWriteBatchBytes = 64 * 1024;
+  // Large enough for PacketHeaderV2.
+  static constexpr size_t kMaxFrameHeaderSize = 16;
+
+  /**
+   * @brief 写队列条目：私有包头 + 私有字节 或 共享主体
+   */
+  struct WriteEntry {
+    std::array<uint8_t, kMaxFrameHeaderSize> header{};
+    size_t header_size = 0;
+    PooledBuffer owned;
+    std::shared_ptr<const std::vector<uint8_t>> shared;
+    size_t shared_offset = 0;
+    uint64_t replace_key = 0;
+
+    size_t Size() const;
+    void AppendBuffers(std::vector<asio::const_buffer>* buffers) const;
+  };
 
+  /**
+   * @brief 单次 DrainSendInbox 内被替换/丢弃的状态条目数，整批结束后一次性上报
+   */
+  struct AdmitStats {
+    uint64_t replaced = 0;
+    uint64_t shed = 0;
+  };
+
+  void Enqueue(WriteEntry entry);
+  void DrainSendInbox();
+
+  /**
+   * @brief 将条目放入待写队列（IO 线程）；可靠条目无法容纳时返回 false
+   */
+  bool AdmitEntry(WriteEntry& entry, AdmitStats& stats);
+  static void ReportAdmitStats(const AdmitStats& stats);
+
+  /**
+   * @brief 丢弃最旧的一条待写可替换条目；没有可丢弃条目时返回 false
+   */
+  bool ShedOldestReplaceable();
+
+  /**
+   * @brief 将待写条目置为空洞（写出时跳过），并扣除其字节
+   */
+  void DropQueuedEntry(WriteEntry& entry);
   void DoRead();
   void DoWrite();
 
   std::unique_ptr<SocketAdapter> socket_;
   uint64_t connection_id_ = 0;
   std::array<uint8_t, 4096> read_buffer_{};
-  std::deque<std::vector<uint8_t>> write_queue_;
+  // Sends from any thread land here; one posted drain moves them onto the socket executor.
+  mutable std::mutex send_inbox_mutex_;
+  std::vector<WriteEntry> send_inbox_;
+  size_t send_inbox_bytes_ = 0;
+  bool send_inbox_scheduled_ = false;
+  bool corked_ = false;
+  size_t cork_bytes_ = 0;
+  std::vector<WriteEntry> send_staging_;
+  // Pending entries; both vectors keep their capacity so steady-state sends do not allocate.
+  std::vector<WriteEntry> write_queue_;
+  // Bytes pending plus in flight, checked against kMaxWriteQueueBytes.
+  size_t write_queue_bytes_ = 0;
+  // Absolute position of write_queue_[0]; positions let the index survive front removals.
+  size_t write_queue_base_ = 0;
+  // replace_key -> absolute position of its newest pending entry (stale once < base).
+  std::unordered_map<uint64_t, size_t> replaceable_index_;
+  // Pending replaceable bytes, checked against kMaxReplaceableQueueBytes.
+  size_t replaceable_bytes_ = 0;
+  // Positions below this hold no live replaceable entry.
+  size_t shed_cursor_ = 0;
+  // Entries covered by the in-flight write; untouched until it completes.
+  std::vector<WriteEntry> write_inflight_;
+  size_t write_batch_bytes_ = 0;
+  std::vector<asio::const_buffer> write_buffers_;
   std::atomic<bool> writing_{false};
+  // write_queue_bytes_ as last published by the IO thread, readable from any thread.
+  std::atomic<size_t> queued_bytes_snapshot_{0};
 
   BytesHandler read_handler_;
   DisconnectHandler disconnect_handler_;
@@ -1,65 +1,200 @@
 #include "network/tcp_server.h"
 
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
 
 namespace mir2::network {
 
+namespace {
+
+#ifdef SO_REUSEPORT
+/**
+ * @brief SO_REUSEPORT 套接字选项（满足 asio SettableSocketOption/GettableSocketOption）
+ */
+class ReusePort {
+ public:
+  explicit ReusePort(bool enabled = false) : value_(enabled ? 1 : 0) {}
+
+  bool enabled() const { return value_ != 0; }
+
+  template <typename Protocol>
+  int level(const Protocol&) const {
+    return SOL_SOCKET;
+  }
+
+  template <typename Protocol>
+  int name(const Protocol&) const {
+    return SO_REUSEPORT;
+  }
+
+  template <typename Protocol>
+  int* data(const Protocol&) {
+    return &value_;
+  }
+
+  template <typename Protocol>
+  const int* data(const Protocol&) const {
+    return &value_;
+  }
+
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const {
+    return sizeof(value_);
+  }
+
+  template <typename Protocol>
+  void resize(const Protocol&, std::size_t size) {
+    if (size != sizeof(value_)) {
+      throw std::length_error("ReusePort socket option resize");
+    }
+  }
+
+ private:
+  int value_;
+};
+constexpr bool kHasReusePort = true;
+#else
+constexpr bool kHasReusePort = false;
+#endif
+
+}  // namespace
+
 TcpServer::TcpServer(asio::io_context& io_context)
     : io_context_(io_context) {}
 
+void TcpServer::SetIoContexts(std::vector<asio::io_context*> io_contexts) {
+  io_contexts_ = std::move(io_contexts);
+}
+
 bool TcpServer::Start(const std::string& bind_ip, uint16_t port, int max_connections) {
   max_connections_ = max_connections;
   asio::ip::tcp::endpoint endpoint(asio::ip::make_address(bind_ip), port);
-  acceptor_ = std::make_unique<asio::ip::tcp::acceptor>(io_context_);
+  acceptors_.clear();
+
+  const bool per_core = io_contexts_.size() > 1;
+  if (!per_core || !kHasReusePort) {
+    auto acceptor = OpenAcceptor(per_core ? *io_contexts_.front() : io_context_, endpoint, false);
+    if (!acceptor) {
+      return false;
+    }
+    acceptors_.push_back(std::move(acceptor));
+  } else {
+    for (auto* io_context : io_contexts_) {
+      auto acceptor = OpenAcceptor(*io_context, endpoint, true);
+      if (!acceptor) {
+        acceptors_.clear();
+        return false;
+      }
+      // 端口为 0 时后续监听套接字需绑定到首个套接字分配到的端口
+      endpoint.port(acceptor->local_endpoint().port());
+      acceptors_.push_back(std::move(acceptor));
+    }
+  }
+
+  for (size_t i = 0; i < acceptors_.size(); ++i) {
+    DoAccept(i);
+  }
+  return true;
+}
+
+std::unique_ptr<asio::ip::tcp::acceptor> TcpServer::OpenAcceptor(
+    asio::io_context& io_context, const asio::ip::tcp::endpoint& endpoint, bool reuse_port) {
+  auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(io_context);
 
   asio::error_code ec;
-  acceptor_->open(endpoint.protocol(), ec);
+  acceptor->open(endpoint.protocol(), ec);
   if (ec) {
     std::cerr << "Failed to open acceptor: " << ec.message() << std::endl;
-    return false;
+    return nullptr;
   }
-  acceptor_->set_option(asio::socket_base::reuse_address(true), ec);
-  acceptor_->bind(endpoint, ec);
+  acceptor->set_option(asio::socket_base::reuse_address(true), ec);
+#ifdef SO_REUSEPORT
+  if (reuse_port) {
+    acceptor->set_option(ReusePort(true), ec);
+    if (ec) {
+      std::cerr << "Failed to set SO_REUSEPORT: " << ec.message() << std::endl;
+      return nullptr;
+    }
+  }
+#else
+  (void)reuse_port;
+#endif
+  acceptor->bind(endpoint, ec);
   if (ec) {
     std::cerr << "Failed to bind acceptor: " << ec.message() << std::endl;
-    return false;
+    return nullptr;
   }
-  acceptor_->listen(asio::socket_base::max_listen_connections, ec);
+  acceptor->listen(asio::socket_base::max_listen_connections, ec);
   if (ec) {
     std::cerr << "Failed to listen: " << ec.message() << std::endl;
-    return false;
+    return nullptr;
   }
-
-  DoAccept();
-  return true;
+  return acceptor;
 }
 
 void TcpServer::Stop() {
-  if (acceptor_) {
+  for (auto& acceptor : acceptors_) {
     asio::error_code ec;
-    acceptor_->close(ec);
+    acceptor->close(ec);
   }
 }
 
-void TcpServer::DoAccept() {
-  if (!acceptor_) {
+uint16_t TcpServer::GetListenPort() const {
+  if (acceptors_.empty()) {
+    return 0;
+  }
+  asio::error_code ec;
+  const auto endpoint = acceptors_.front()->local_endpoint(ec);
+  return ec ? 0 : endpoint.port();
+}
+
+asio::io_context& TcpServer::NextAcceptContext(size_t acceptor_index) {
+  if (io_contexts_.size() <= 1) {
+    return io_context_;
+  }
+  if (acceptors_.size() > 1) {
+    // 每个监听套接字只为自己的上下文接受连接
+    return *io_contexts_[acceptor_index];
+  }
+  asio::io_context& io_context = *io_contexts_[next_context_];
+  next_context_ = (next_context_ + 1) % io_contexts_.size();
+  return io_context;
+}
+
+void TcpServer::SetSocketBackend(SocketBackend backend) {
+  if (!IsSocketBackendAvailable(backend)) {
+    std::cerr << "Socket backend " << ToString(backend) << " unavailable, falling back to asio"
+              << std::endl;
+    backend = SocketBackend::kAsio;
+  }
+  socket_backend_ = backend;
+}
+
+void TcpServer::DoAccept(size_t acceptor_index) {
+  if (acceptor_index >= acceptors_.size() || !acceptors_[acceptor_index]->is_open()) {
     return;
   }
 
-  acceptor_->async_accept([this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
-    if (!ec) {
-      uint64_t connection_id = next_connection_id_.fetch_add(1);
-      auto connection = std::make_shared<TcpConnection>(
-          std::make_unique<AsioSocketAdapter>(std::move(socket)),
-          connection_id);
-      if (connect_handler_) {
-        connect_handler_(connection);
-      } else {
-        connection->Close();
-      }
-    }
-    DoAccept();
-  });
+  acceptors_[acceptor_index]->async_accept(
+      NextAcceptContext(acceptor_index),
+      [this, acceptor_index](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        if (!ec) {
+          uint64_t connection_id = next_connection_id_.fetch_add(1);
+          auto connection = std::make_shared<TcpConnection>(
+              CreateSocketAdapter(std::move(socket), socket_backend_),
+              connection_id);
+          if (connect_handler_) {
+            connect_handler_(connection);
+          } else {
+            connection->Close();
+          }
+        }
+        DoAccept(acceptor_index);
+      });
 }
 
 }  // namespace mir2::network
@@ -11,15 +11,22 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <asio/ip/tcp.hpp>
 
+#include "network/socket_backend.h"
 #include "network/tcp_connection.h"
 
 namespace mir2::network {
 
 /**
  * @brief TCP服务器封装
+ *
+ * 默认在构造时给定的 io_context 上监听与接受连接。通过 SetIoContexts 传入多个
+ * 上下文后进入每核模式：每个上下文各自持有一个 SO_REUSEPORT 监听套接字，由内核
+ * 分摊新连接，连接的 socket 与回调固定在接受它的上下文上；平台不支持
+ * SO_REUSEPORT 时退化为单监听套接字轮转分配上下文。
  */
 class TcpServer {
  public:
@@ -27,6 +34,11 @@ class TcpServer {
 
   explicit TcpServer(asio::io_context& io_context);
 
+  /**
+   * @brief 设置每核IO上下文（须在 Start 之前调用）
+   */
+  void SetIoContexts(std::vector<asio::io_context*> io_contexts);
+
   /**
    * @brief 启动监听
    */
@@ -37,15 +49,34 @@ class TcpServer {
    */
   void Stop();
 
+  /**
+   * @brief 选择新连接的 Socket 后端（不可用时退回 asio）
+   */
+  void SetSocketBackend(SocketBackend backend);
+
   void SetConnectHandler(ConnectHandler handler) { connect_handler_ = std::move(handler); }
 
+  /**
+   * @brief 实际监听端口（绑定端口为 0 时由系统分配）
+   */
+  uint16_t GetListenPort() const;
+
+  size_t GetAcceptorCount() const { return acceptors_.size(); }
+
  private:
-  void DoAccept();
+  std::unique_ptr<asio::ip::tcp::acceptor> OpenAcceptor(asio::io_context& io_context,
+                                                        const asio::ip::tcp::endpoint& endpoint,
+                                                        bool reuse_port);
+  void DoAccept(size_t acceptor_index);
+  asio::io_context& NextAcceptContext(size_t acceptor_index);
 
   asio::io_context& io_context_;
-  std::unique_ptr<asio::ip::tcp::acceptor> acceptor_;
+  std::vector<asio::io_context*> io_contexts_;
+  std::vector<std::unique_ptr<asio::ip::tcp::acceptor>> acceptors_;
   std::atomic<uint64_t> next_connection_id_{1};
+  size_t next_context_ = 0;  // 仅在单监听轮转模式下使用，accept 回调串行执行
   int max_connections_ = 0;
+  SocketBackend socket_backend_ = SocketBackend::kAsio;
 
   ConnectHandler connect_handler_;
 };
@@ -1,12 +1,15 @@
 #include "network/tcp_session.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <asio/post.hpp>
 #include <flatbuffers/flatbuffers.h>
 
 #include "common/enums.h"
+#include "common/protocol/payload_compression.h"
 #include "server/common/error_codes.h"
+#include "server/common/routed_envelope.h"
 #include "log/logger.h"
 #include "monitor/metrics.h"
 #include "system_generated.h"
@@ -16,15 +19,21 @@ namespace mir2::network {
 namespace {
 
 constexpr int64_t kRateWindowMs = 1000;
-constexpr uint32_t kMaxMessagesPerSec = 50;
-constexpr uint32_t kMaxBytesPerSec = 64 * 1024;
 constexpr size_t kMaxReadBufferSize = 64 * 1024;
 constexpr uint16_t kSequenceWindow = 256;
+constexpr uint8_t kCompressedFlag = static_cast<uint8_t>(mir2::common::PacketFlags::kCompressed);
+constexpr uint8_t kAcceptCompressedFlag =
+    static_cast<uint8_t>(mir2::common::PacketFlags::kAcceptCompressed);
+
+// 高 16 位为消息号，低 48 位为实体 ID；消息号非 0，因此键永不为 0
+uint64_t MakeReplaceKey(uint16_t msg_id, uint64_t entity_id) {
+  return (static_cast<uint64_t>(msg_id) << 48) | (entity_id & 0xFFFFFFFFFFFFull);
+}
 
 }  // namespace
 
 TcpSession::TcpSession(std::shared_ptr<TcpConnection> connection)
-    : connection_(std::move(connection)) {
+    : connection_(std::move(connection)), read_buffer_(kMaxReadBufferSize) {
   if (connection_) {
     connection_id_ = connection_->GetConnectionId();
     remote_address_ = connection_->GetRemoteAddress();
@@ -57,24 +66,157 @@ void TcpSession::Start() {
   });
 }
 
-void TcpSession::Send(uint16_t msg_id, const std::vector<uint8_t>& payload) {
+void TcpSession::Send(uint16_t msg_id, std::span<const uint8_t> payload) {
+  SendEncoded(msg_id, payload, 0);
+}
+
+void TcpSession::SendRouted(uint64_t client_id, uint16_t msg_id,
+                            std::span<const uint8_t> payload) {
+  if (!connection_) {
+    return;
+  }
+  if (state_.load() != SessionState::kActive) {
+    return;
+  }
+  if (routed_batch_.Enabled()) {
+    routed_batch_.Append(client_id, msg_id, payload,
+                         [this](std::span<const uint8_t> batch, size_t frame_count) {
+                           SendRoutedBatch(batch, frame_count);
+                         });
+    return;
+  }
+  mir2::common::RoutedEnvelope envelope;
+  envelope.client_id = client_id;
+  envelope.msg_id = msg_id;
+  envelope.payload_size = static_cast<uint32_t>(payload.size());
+  const auto envelope_bytes = envelope.ToBytes();
+  const uint16_t frame_msg_id = static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedFrame);
+
+  PooledBuffer buffer;
+  if (protocol_version_ == ProtocolVersion::kV2) {
+    const uint8_t flags = compression_threshold_ > 0 ? kAcceptCompressedFlag : 0;
+    buffer = PacketCodec::EncodeV2GatherPooled(frame_msg_id, envelope_bytes, payload,
+                                               NextSendSequence(), flags);
+  } else {
+    buffer = PacketCodec::EncodeGatherPooled(frame_msg_id, envelope_bytes, payload);
+  }
+  if (buffer.Empty()) {
+    return;
+  }
+  connection_->SendBuffer(std::move(buffer));
+  monitor::Metrics::Instance().IncrementMessagesSent();
+}
+
+void TcpSession::SendRoutedMulticast(std::span<const uint64_t> client_ids, uint16_t msg_id,
+                                     std::span<const uint8_t> payload) {
+  if (!connection_ || client_ids.empty()) {
+    return;
+  }
+  if (state_.load() != SessionState::kActive) {
+    return;
+  }
+  auto& metrics = monitor::Metrics::Instance();
+  metrics.IncrementCounter("network.routed_multicast.messages");
+  metrics.AddCounter("network.routed_multicast.recipients", client_ids.size());
+  if (routed_batch_.Enabled()) {
+    routed_batch_.AppendMulticast(client_ids, msg_id, payload,
+                                  [this](std::span<const uint8_t> batch, size_t frame_count) {
+                                    SendRoutedBatch(batch, frame_count);
+                                  });
+    return;
+  }
+  thread_local std::vector<uint8_t> frame;
+  frame.clear();
+  mir2::common::AppendRoutedMulticast(&frame, client_ids, msg_id, payload);
+  SendEncoded(static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedFrame), frame, 0);
+}
+
+void TcpSession::SendRoutedBatch(std::span<const uint8_t> batch, size_t frame_count) {
+  SendEncoded(static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedBatch), batch, 0);
+  auto& metrics = monitor::Metrics::Instance();
+  metrics.IncrementCounter("network.routed_batch.batches");
+  metrics.AddCounter("network.routed_batch.frames", frame_count);
+}
+
+void TcpSession::SendLatest(uint16_t msg_id, uint64_t entity_id,
+                            std::span<const uint8_t> payload) {
+  SendEncoded(msg_id, payload, MakeReplaceKey(msg_id, entity_id));
+}
+
+void TcpSession::SendEncoded(uint16_t msg_id, std::span<const uint8_t> payload,
+                             uint64_t replace_key) {
   if (!connection_) {
     return;
   }
   if (state_.load() != SessionState::kActive) {
     return;
   }
-  std::vector<uint8_t> buffer;
+  PooledBuffer buffer;
   if (protocol_version_ == ProtocolVersion::kV2) {
     const uint16_t sequence = NextSendSequence();
-    buffer = PacketCodec::EncodeV2(msg_id, payload.data(), payload.size(), sequence);
+    uint8_t flags = compression_threshold_ > 0 ? kAcceptCompressedFlag : 0;
+    if (compression_threshold_ > 0 && payload.size() >= compression_threshold_ &&
+        peer_accepts_compression_.load(std::memory_order_relaxed)) {
+      thread_local std::vector<uint8_t> compressed;
+      if (mir2::common::CompressPayload(payload.data(), payload.size(), &compressed)) {
+        auto& metrics = monitor::Metrics::Instance();
+        metrics.IncrementCounter("network.compression.packets");
+        metrics.AddCounter("network.compression.bytes_saved", payload.size() - compressed.size());
+        buffer = PacketCodec::EncodeV2Pooled(msg_id, compressed.data(), compressed.size(), sequence,
+                                             flags | kCompressedFlag);
+      }
+    }
+    if (buffer.Empty()) {
+      buffer = PacketCodec::EncodeV2Pooled(msg_id, payload.data(), payload.size(), sequence, flags);
+    }
   } else {
-    buffer = PacketCodec::Encode(msg_id, payload.data(), payload.size());
+    buffer = PacketCodec::EncodePooled(msg_id, payload.data(), payload.size());
   }
-  connection_->SendRaw(buffer);
+  connection_->SendBuffer(std::move(buffer), replace_key);
   monitor::Metrics::Instance().IncrementMessagesSent();
 }
 
+void TcpSession::SendFrame(const std::shared_ptr<const SharedFrame>& frame) {
+  SendShared(frame, 0);
+}
+
+void TcpSession::SendFrameLatest(const std::shared_ptr<const SharedFrame>& frame,
+                                 uint64_t entity_id) {
+  if (!frame) {
+    return;
+  }
+  SendShared(frame, MakeReplaceKey(frame->GetMsgId(), entity_id));
+}
+
+void TcpSession::SendShared(const std::shared_ptr<const SharedFrame>& frame, uint64_t replace_key) {
+  if (!connection_ || !frame || !frame->IsValid()) {
+    return;
+  }
+  if (state_.load() != SessionState::kActive) {
+    return;
+  }
+  if (protocol_version_ == ProtocolVersion::kV2) {
+    const auto header = frame->BuildHeaderV2(NextSendSequence());
+    connection_->SendShared(header.data(), header.size(), frame->GetBytes(),
+                            SharedFrame::kPayloadOffset, replace_key);
+  } else {
+    connection_->SendShared(nullptr, 0, frame->GetBytes(), 0, replace_key);
+  }
+  monitor::Metrics::Instance().IncrementMessagesSent();
+}
+
+void TcpSession::Flush() {
+  if (!connection_) {
+    return;
+  }
+  if (routed_batch_.Enabled()) {
+    routed_batch_.Flush([this](std::span<const uint8_t> batch, size_t frame_count) {
+      SendRoutedBatch(batch, frame_count);
+    });
+  }
+  connection_->Flush();
+}
+
 void TcpSession::Close() {
   if (!connection_) {
     return;
@@ -115,6 +257,7 @@ void TcpSession::Kick(mir2::common::ErrorCode reason, const std::string& text) {
   const uint8_t* data = builder.GetBufferPointer();
   std::vector<uint8_t> payload(data, data + builder.GetSize());
   Send(static_cast<uint16_t>(mir2::common::MsgId::kKick), payload);
+  Flush();
   Close();
 }
 
@@ -153,7 +296,7 @@ bool TcpSession::CheckRecvSequence(uint16_t seq) {
   return false;
 }
 
-void TcpSession::HandlePacket(uint64_t connection_id, const Packet& packet) {
+void TcpSession::HandlePacket(uint64_t connection_id, const PacketView& packet) {
   if (connection_id != connection_id_) {
     return;
   }
@@ -198,50 +341,129 @@ void TcpSession::HandleBytes(const uint8_t* data, size_t size) {
     return;
   }
 
+  while (size > 0) {
+    if (read_buffer_.Empty()) {
+      // 快路径：直接在连接的读缓冲上解析，只把尾部残包拷入 read_buffer_
+      size_t consumed = 0;
+      if (!ParsePackets(data, size, &consumed)) {
+        return;
+      }
+      data += consumed;
+      size -= consumed;
+      if (size == 0) {
+        return;
+      }
+      StashBytes(data, size);
+      return;
+    }
+
+    // 补齐残包：只拷贝完成当前包所需的字节，其余数据回到快路径
+    const size_t take = std::min(size, BytesToCompleteFrame());
+    if (!StashBytes(data, take)) {
+      return;
+    }
+    data += take;
+    size -= take;
+
+    size_t consumed = 0;
+    if (!ParsePackets(read_buffer_.Data(), read_buffer_.Size(), &consumed)) {
+      return;
+    }
+    read_buffer_.Consume(consumed);
+    if (take == 0 && consumed == 0) {
+      return;
+    }
+  }
+}
+
+bool TcpSession::StashBytes(const uint8_t* data, size_t size) {
   // Prevent unbounded buffer growth from slow or malicious peers.
-  if (read_buffer_.size() >= kMaxReadBufferSize ||
-      size > kMaxReadBufferSize - read_buffer_.size()) {
+  if (!read_buffer_.Append(data, size)) {
     SYSLOG_WARN("Read buffer overflow (current={}, incoming={}), closing session {}",
-                read_buffer_.size(), size, GetSessionId());
+                read_buffer_.Size(), size, GetSessionId());
     Close();
-    return;
+    return false;
   }
+  return true;
+}
+
+size_t TcpSession::BytesToCompleteFrame() const {
+  const uint8_t* data = read_buffer_.Data();
+  const size_t buffered = read_buffer_.Size();
+  if (buffered < sizeof(uint32_t)) {
+    return sizeof(uint32_t) - buffered;
+  }
+
+  const ProtocolVersion version = protocol_version_detected_
+                                      ? protocol_version_
+                                      : mir2::common::DetectProtocolVersion(data);
+  const size_t header_size =
+      version == ProtocolVersion::kV2 ? PacketHeaderV2::kSize : PacketHeader::kSize;
+  if (buffered < header_size) {
+    return header_size - buffered;
+  }
+
+  size_t payload_size = 0;
+  if (version == ProtocolVersion::kV2) {
+    PacketHeaderV2 header{};
+    if (!PacketHeaderV2::FromBytes(data, header_size, &header)) {
+      return 0;
+    }
+    payload_size = header.payload_size;
+  } else {
+    PacketHeader header{};
+    if (!PacketHeader::FromBytes(data, header_size, &header)) {
+      return 0;
+    }
+    payload_size = header.payload_size;
+  }
+  // 非法长度交给 ParsePackets 统一报错
+  if (payload_size > mir2::common::kMaxPayloadSize) {
+    return 0;
+  }
+  const size_t packet_size = header_size + payload_size;
+  return packet_size > buffered ? packet_size - buffered : 0;
+}
 
-  read_buffer_.insert(read_buffer_.end(), data, data + size);
+bool TcpSession::ParsePackets(const uint8_t* data, size_t size, size_t* consumed) {
+  size_t offset = 0;
+  *consumed = 0;
 
   while (true) {
-    if (read_buffer_.size() < sizeof(uint32_t)) {
-      return;
+    const uint8_t* packet_data = data + offset;
+    const size_t available = size - offset;
+    if (available < sizeof(uint32_t)) {
+      return true;
     }
 
     if (!protocol_version_detected_) {
-      protocol_version_ = mir2::common::DetectProtocolVersion(read_buffer_.data());
+      protocol_version_ = mir2::common::DetectProtocolVersion(packet_data);
       protocol_version_detected_ = true;
     }
 
     const size_t header_size = protocol_version_ == ProtocolVersion::kV2
                                    ? PacketHeaderV2::kSize
                                    : PacketHeader::kSize;
-    if (read_buffer_.size() < header_size) {
-      return;
+    if (available < header_size) {
+      return true;
     }
 
     size_t payload_size = 0;
     if (protocol_version_ == ProtocolVersion::kV2) {
       PacketHeaderV2 header{};
-      if (!PacketHeaderV2::FromBytes(read_buffer_.data(), header_size, &header) ||
+      if (!PacketHeaderV2::FromBytes(packet_data, header_size, &header) ||
           header.version != PacketHeaderV2::kVersion) {
         monitor::Metrics::Instance().IncrementError("decode_header");
         Close();
-        return;
+        return false;
       }
       payload_size = header.payload_size;
     } else {
       PacketHeader header{};
-      if (!PacketHeader::FromBytes(read_buffer_.data(), header_size, &header)) {
+      if (!PacketHeader::FromBytes(packet_data, header_size, &header)) {
         monitor::Metrics::Instance().IncrementError("decode_header");
         Close();
-        return;
+        return false;
       }
       payload_size = header.payload_size;
     }
@@ -249,44 +471,60 @@ void TcpSession::HandleBytes(const uint8_t* data, size_t size) {
     if (payload_size > mir2::common::kMaxPayloadSize) {
       monitor::Metrics::Instance().IncrementError("decode_body");
       Close();
-      return;
+      return false;
     }
 
     const size_t packet_size = header_size + payload_size;
-    if (read_buffer_.size() < packet_size) {
-      return;
+    if (available < packet_size) {
+      return true;
     }
 
-    Packet packet{};
+    PacketView packet{};
     if (protocol_version_ == ProtocolVersion::kV2) {
       uint16_t sequence = 0;
+      uint8_t flags = 0;
       const auto status =
-          PacketCodec::DecodeV2(read_buffer_.data(), packet_size, &packet, &sequence);
+          PacketCodec::DecodeV2View(packet_data, packet_size, &packet, &sequence, &flags);
       if (status != DecodeStatus::kOk) {
         monitor::Metrics::Instance().IncrementError("decode_body");
         Close();
-        return;
+        return false;
       }
       if (!CheckRecvSequence(sequence)) {
         monitor::Metrics::Instance().IncrementError("sequence");
         Close();
-        return;
+        return false;
+      }
+      if (compression_threshold_ > 0 && (flags & kAcceptCompressedFlag) != 0) {
+        peer_accepts_compression_.store(true, std::memory_order_relaxed);
+      }
+      if ((flags & kCompressedFlag) != 0) {
+        // 只接受已声明支持的压缩；明文上限与接收缓冲一致，防御解压炸弹
+        if (compression_threshold_ == 0 ||
+            !mir2::common::DecompressPayload(packet.payload, &decompress_buffer_,
+                                             kMaxReadBufferSize)) {
+          monitor::Metrics::Instance().IncrementError("decompress");
+          Close();
+          return false;
+        }
+        packet.payload = decompress_buffer_;
       }
     } else {
-      const auto status = PacketCodec::Decode(read_buffer_.data(), packet_size, &packet);
+      const auto status = PacketCodec::DecodeView(packet_data, packet_size, &packet);
       if (status != DecodeStatus::kOk) {
         monitor::Metrics::Instance().IncrementError("decode_body");
         Close();
-        return;
+        return false;
       }
     }
 
     HandlePacket(connection_id_, packet);
     if (state_.load() != SessionState::kActive) {
-      return;
+      return false;
     }
 
-    read_buffer_.erase(read_buffer_.begin(), read_buffer_.begin() + packet_size);
+    offset += packet_size;
+    *consumed = offset;
   }
 }
 
@@ -313,8 +551,8 @@ bool TcpSession::CheckRateLimit(size_t payload_size) {
       rate_msg_count_.fetch_add(1, std::memory_order_relaxed);
   const uint32_t bytes_count =
       rate_bytes_count_.fetch_add(payload_size32, std::memory_order_relaxed);
-  if (msg_count + 1 > kMaxMessagesPerSec ||
-      bytes_count + payload_size32 > kMaxBytesPerSec) {
+  if ((max_messages_per_sec_ != 0 && msg_count + 1 > max_messages_per_sec_) ||
+      (max_bytes_per_sec_ != 0 && bytes_count + payload_size32 > max_bytes_per_sec_)) {
     rate_limited_.store(true, std::memory_order_relaxed);
     return false;
   }
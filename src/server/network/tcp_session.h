@@ -11,10 +11,14 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "network/packet_codec.h"
+#include "network/receive_buffer.h"
+#include "network/routed_batch.h"
+#include "network/shared_frame.h"
 #include "network/tcp_connection.h"
 
 namespace mir2::common {
@@ -28,6 +32,9 @@ namespace mir2::network {
  */
 class TcpSession : public std::enable_shared_from_this<TcpSession> {
  public:
+  static constexpr uint32_t kDefaultMaxMessagesPerSec = 50;
+  static constexpr uint32_t kDefaultMaxBytesPerSec = 64 * 1024;
+
   enum class SessionState {
     kInit,
     kActive,
@@ -44,7 +51,9 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
 
   using ConnectedHandler = std::function<void(const std::shared_ptr<TcpSession>&)>;
   using DisconnectedHandler = std::function<void(const std::shared_ptr<TcpSession>&)>;
-  using MessageHandler = std::function<void(const std::shared_ptr<TcpSession>&, const Packet&)>;
+  /// packet 为指向接收缓冲区的视图，仅在回调期间有效；需延后处理时调用 ToOwned()
+  using MessageHandler =
+      std::function<void(const std::shared_ptr<TcpSession>&, const PacketView&)>;
 
   explicit TcpSession(std::shared_ptr<TcpConnection> connection);
 
@@ -56,7 +65,57 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
   /**
    * @brief 发送消息
    */
-  void Send(uint16_t msg_id, const std::vector<uint8_t>& payload);
+  void Send(uint16_t msg_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief 以定长路由信封转发客户端消息（kRoutedFrame），信封与负载直接编码进发送缓冲
+   *
+   * 开启路由攒批时追加到 kRoutedBatch 批次，由 Flush 或批次达到上限时写出。
+   */
+  void SendRouted(uint64_t client_id, uint16_t msg_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief 以组播路由帧把同一负载发往多个客户端（负载只携带一份，由网关展开）
+   */
+  void SendRoutedMulticast(std::span<const uint64_t> client_ids, uint16_t msg_id,
+                           std::span<const uint8_t> payload);
+
+  /**
+   * @brief 发送可替换的实体状态（EntityMove/EntityUpdate 等）
+   *
+   * 同一 (msg_id, entity_id) 尚未写出的旧状态会被新状态取代；对端读得慢时，
+   * 连接优先丢弃过期状态而不是断开。可靠消息请使用 Send。
+   */
+  void SendLatest(uint16_t msg_id, uint64_t entity_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief 发送共享广播帧（主体不重新编码，V2 仅生成本会话包头）
+   */
+  void SendFrame(const std::shared_ptr<const SharedFrame>& frame);
+
+  /**
+   * @brief 以可替换状态发送共享广播帧，替换规则同 SendLatest
+   */
+  void SendFrameLatest(const std::shared_ptr<const SharedFrame>& frame, uint64_t entity_id);
+
+  /**
+   * @brief 启用负载压缩（仅 V2；0 表示关闭）
+   *
+   * 启用后本端发出的包带 kAcceptCompressed 能力位；只有对端同样声明该能力后，
+   * 长度不小于 threshold 且压缩后更小的负载才会以 kCompressed 发送。
+   */
+  void SetCompressionThreshold(size_t threshold) { compression_threshold_ = threshold; }
+  bool PeerAcceptsCompression() const { return peer_accepts_compression_.load(); }
+
+  /**
+   * @brief 开启路由帧攒批（0 表示逐条发送，应在会话开始收发前设置）
+   */
+  void SetRoutedBatchBytes(size_t limit_bytes) { routed_batch_.SetLimit(limit_bytes); }
+
+  /**
+   * @brief 写出积攒的路由批次，并投递 cork 模式下积攒的发送批次
+   */
+  void Flush();
 
   /**
    * @brief 关闭会话
@@ -91,14 +150,41 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
   uint16_t NextSendSequence();
   bool CheckRecvSequence(uint16_t seq);
 
+  /**
+   * @brief 设置接收限速（每秒消息数 / 负载字节数，0 表示不限）
+   */
+  void SetRateLimit(uint32_t max_messages_per_sec, uint32_t max_bytes_per_sec) {
+    max_messages_per_sec_ = max_messages_per_sec;
+    max_bytes_per_sec_ = max_bytes_per_sec;
+  }
   bool IsRateLimited() const { return rate_limited_.load(); }
 
-  void HandlePacket(uint64_t connection_id, const Packet& packet);
+  void HandlePacket(uint64_t connection_id, const PacketView& packet);
   void HandleDisconnect(uint64_t connection_id);
   void HandleBytes(const uint8_t* data, size_t size);
 
  private:
   bool CheckRateLimit(size_t payload_size);
+  void SendEncoded(uint16_t msg_id, std::span<const uint8_t> payload, uint64_t replace_key);
+  void SendRoutedBatch(std::span<const uint8_t> batch, size_t frame_count);
+  void SendShared(const std::shared_ptr<const SharedFrame>& frame, uint64_t replace_key);
+
+  /**
+   * @brief 解析 data 中的完整包并逐个分发
+   * @param consumed 输出：已处理的字节数（其后为残包）
+   * @return 会话因错误或回调而关闭时返回 false
+   */
+  bool ParsePackets(const uint8_t* data, size_t size, size_t* consumed);
+
+  /**
+   * @brief 暂存残包字节；超出容量时关闭会话并返回 false
+   */
+  bool StashBytes(const uint8_t* data, size_t size);
+
+  /**
+   * @brief 补全 read_buffer_ 中首个残包还需要的字节数（0 表示包头非法或已完整）
+   */
+  size_t BytesToCompleteFrame() const;
 
   std::shared_ptr<TcpConnection> connection_;
   uint64_t connection_id_ = 0;
@@ -115,12 +201,21 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
   std::atomic<int64_t> rate_window_start_ms_{0};
   std::atomic<uint32_t> rate_msg_count_{0};
   std::atomic<uint32_t> rate_bytes_count_{0};
+  uint32_t max_messages_per_sec_ = kDefaultMaxMessagesPerSec;
+  uint32_t max_bytes_per_sec_ = kDefaultMaxBytesPerSec;
 
   std::atomic<uint16_t> send_sequence_{0};
   std::atomic<uint16_t> recv_sequence_{0};
   ProtocolVersion protocol_version_ = ProtocolVersion::kV1;
   bool protocol_version_detected_ = false;
-  std::vector<uint8_t> read_buffer_;
+  ReceiveBuffer read_buffer_;
+
+  size_t compression_threshold_ = 0;
+  std::atomic<bool> peer_accepts_compression_{false};
+  // 解压后的负载，仅在分发回调期间有效（与包视图同一约定）
+  std::vector<uint8_t> decompress_buffer_;
+
+  RoutedBatch routed_batch_;
 
   ConnectedHandler connected_handler_;
   DisconnectedHandler disconnected_handler_;
@@ -0,0 +1,171 @@
+#include "network/timing_wheel.h"
+
+#include <algorithm>
+
+namespace mir2::network {
+
+namespace {
+
+int64_t FloorDiv(int64_t value, int64_t divisor) {
+  const int64_t quotient = value / divisor;
+  return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+}  // namespace
+
+TimingWheel::TimingWheel(int64_t tick_ms, int64_t now_ms)
+    : tick_ms_(std::max<int64_t>(tick_ms, 1)), current_tick_(0) {
+  current_tick_ = ToTick(now_ms);
+  heads_.fill(kNil);
+}
+
+int64_t TimingWheel::ToTick(int64_t ms) const {
+  return FloorDiv(ms, tick_ms_);
+}
+
+uint32_t TimingWheel::SlotFor(int64_t deadline_tick) const {
+  int64_t delta = deadline_tick - current_tick_;
+  if (delta <= 0) {
+    return kDueSlot;
+  }
+  if (delta < static_cast<int64_t>(kLevel0Slots)) {
+    return static_cast<uint32_t>(deadline_tick & (kLevel0Slots - 1));
+  }
+  // 超出总跨度的截止时间先放在最高层最远的槽，下放时重新计算
+  constexpr int64_t kMaxDelta = int64_t{1} << (kLevel0Bits + kLevelBits * (kLevelCount - 1));
+  if (delta >= kMaxDelta) {
+    delta = kMaxDelta - 1;
+    deadline_tick = current_tick_ + delta;
+  }
+  for (int level = 1; level < kLevelCount; ++level) {
+    const int shift = kLevel0Bits + kLevelBits * (level - 1);
+    if (delta < (int64_t{1} << (shift + kLevelBits))) {
+      const size_t index = static_cast<size_t>(deadline_tick >> shift) & (kLevelSlots - 1);
+      return static_cast<uint32_t>(kLevel0Slots + kLevelSlots * (level - 1) + index);
+    }
+  }
+  return kDueSlot;
+}
+
+void TimingWheel::Link(uint32_t node, uint32_t slot) {
+  Node& entry = nodes_[node];
+  entry.slot = slot;
+  entry.prev = kNil;
+  entry.next = heads_[slot];
+  if (entry.next != kNil) {
+    nodes_[entry.next].prev = node;
+  }
+  heads_[slot] = node;
+}
+
+void TimingWheel::Unlink(uint32_t node) {
+  Node& entry = nodes_[node];
+  if (entry.prev != kNil) {
+    nodes_[entry.prev].next = entry.next;
+  } else {
+    heads_[entry.slot] = entry.next;
+  }
+  if (entry.next != kNil) {
+    nodes_[entry.next].prev = entry.prev;
+  }
+  entry.prev = kNil;
+  entry.next = kNil;
+  entry.slot = kNil;
+}
+
+void TimingWheel::Release(uint32_t node) {
+  index_.erase(nodes_[node].id);
+  free_nodes_.push_back(node);
+}
+
+void TimingWheel::Schedule(uint64_t id, int64_t deadline_ms) {
+  // 截止时间向上取整到 tick，保证不会提前报告
+  const int64_t deadline_tick = FloorDiv(deadline_ms + tick_ms_ - 1, tick_ms_);
+  auto [it, inserted] = index_.try_emplace(id, kNil);
+  if (inserted) {
+    if (!free_nodes_.empty()) {
+      it->second = free_nodes_.back();
+      free_nodes_.pop_back();
+    } else {
+      it->second = static_cast<uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+    }
+    nodes_[it->second].id = id;
+  } else {
+    Unlink(it->second);
+  }
+  nodes_[it->second].deadline_tick = deadline_tick;
+  Link(it->second, SlotFor(deadline_tick));
+}
+
+bool TimingWheel::Cancel(uint64_t id) {
+  const auto it = index_.find(id);
+  if (it == index_.end()) {
+    return false;
+  }
+  const uint32_t node = it->second;
+  Unlink(node);
+  Release(node);
+  return true;
+}
+
+void TimingWheel::Cascade(int level) {
+  const int shift = kLevel0Bits + kLevelBits * (level - 1);
+  const size_t index = static_cast<size_t>(current_tick_ >> shift) & (kLevelSlots - 1);
+  const uint32_t slot = static_cast<uint32_t>(kLevel0Slots + kLevelSlots * (level - 1) + index);
+  uint32_t node = heads_[slot];
+  heads_[slot] = kNil;
+  while (node != kNil) {
+    const uint32_t next = nodes_[node].next;
+    Link(node, SlotFor(nodes_[node].deadline_tick));
+    node = next;
+  }
+}
+
+void TimingWheel::Expire(uint32_t slot, std::vector<uint64_t>& expired) {
+  uint32_t node = heads_[slot];
+  heads_[slot] = kNil;
+  while (node != kNil) {
+    const uint32_t next = nodes_[node].next;
+    expired.push_back(nodes_[node].id);
+    nodes_[node].slot = kNil;
+    Release(node);
+    node = next;
+  }
+}
+
+size_t TimingWheel::Advance(int64_t now_ms, std::vector<uint64_t>& expired) {
+  const size_t before = expired.size();
+  const int64_t target_tick = ToTick(now_ms);
+  Expire(kDueSlot, expired);
+  if (index_.empty()) {
+    current_tick_ = std::max(current_tick_, target_tick);
+    return expired.size() - before;
+  }
+
+  constexpr int64_t kLevel0Mask = static_cast<int64_t>(kLevel0Slots) - 1;
+  constexpr int64_t kLevelMask = static_cast<int64_t>(kLevelSlots) - 1;
+  while (current_tick_ < target_tick) {
+    ++current_tick_;
+    // 低层转满一圈时把上一层当前槽下放
+    if ((current_tick_ & kLevel0Mask) == 0) {
+      Cascade(1);
+      for (int level = 2; level < kLevelCount; ++level) {
+        const int lower_shift = kLevel0Bits + kLevelBits * (level - 2);
+        if (((current_tick_ >> lower_shift) & kLevelMask) != 0) {
+          break;
+        }
+        Cascade(level);
+      }
+    }
+    Expire(static_cast<uint32_t>(current_tick_ & kLevel0Mask), expired);
+    Expire(kDueSlot, expired);
+    if (index_.empty()) {
+      current_tick_ = target_tick;
+      break;
+    }
+  }
+  return expired.size() - before;
+}
+
+}  // namespace mir2::network
@@ -0,0 +1,89 @@
+/**
+ * @file timing_wheel.h
+ * @brief 分层时间轮（心跳超时、空闲会话过期）
+ */
+
+#ifndef MIR2_NETWORK_TIMING_WHEEL_H
+#define MIR2_NETWORK_TIMING_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mir2::network {
+
+/**
+ * @brief 分层时间轮
+ *
+ * 第 0 层 256 槽，以上各层 64 槽，每层跨度为下一层整圈；以 tick_ms 为粒度时
+ * （默认 100ms）覆盖约 77 天，更远的截止时间钳到最高层。
+ * Schedule / Cancel 为 O(1)（按 id 索引的侵入式链表）；Advance 每个 tick 只处理
+ * 当前槽，高层槽在低层转满一圈时逐级下放。到期在截止时间后一个 tick 内报告，
+ * 调用方若需精确语义应自行复核截止时间。
+ *
+ * 非线程安全，由持有者加锁。
+ */
+class TimingWheel {
+ public:
+  static constexpr int64_t kDefaultTickMs = 100;
+
+  explicit TimingWheel(int64_t tick_ms = kDefaultTickMs, int64_t now_ms = 0);
+
+  /**
+   * @brief 安排（或重新安排）id 在 deadline_ms 到期；已过期的截止时间在下次 Advance 报告
+   */
+  void Schedule(uint64_t id, int64_t deadline_ms);
+
+  /**
+   * @brief 取消 id，返回是否存在
+   */
+  bool Cancel(uint64_t id);
+
+  bool Contains(uint64_t id) const { return index_.count(id) != 0; }
+  size_t Size() const { return index_.size(); }
+
+  /**
+   * @brief 推进到 now_ms，把到期的 id 追加到 expired 并移出时间轮，返回到期数量
+   */
+  size_t Advance(int64_t now_ms, std::vector<uint64_t>& expired);
+
+ private:
+  static constexpr int kLevel0Bits = 8;
+  static constexpr int kLevelBits = 6;
+  static constexpr int kLevelCount = 4;
+  static constexpr size_t kLevel0Slots = size_t{1} << kLevel0Bits;
+  static constexpr size_t kLevelSlots = size_t{1} << kLevelBits;
+  static constexpr size_t kSlotCount = kLevel0Slots + kLevelSlots * (kLevelCount - 1);
+  static constexpr uint32_t kDueSlot = static_cast<uint32_t>(kSlotCount);
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+  struct Node {
+    uint64_t id = 0;
+    int64_t deadline_tick = 0;
+    uint32_t prev = kNil;
+    uint32_t next = kNil;
+    uint32_t slot = kNil;
+  };
+
+  int64_t ToTick(int64_t ms) const;
+  uint32_t SlotFor(int64_t deadline_tick) const;
+  void Link(uint32_t node, uint32_t slot);
+  void Unlink(uint32_t node);
+  void Release(uint32_t node);
+  void Cascade(int level);
+  void Expire(uint32_t slot, std::vector<uint64_t>& expired);
+
+  int64_t tick_ms_;
+  int64_t current_tick_;
+  // 各层槽链表头，末尾额外一槽存放安排时已到期的条目
+  std::array<uint32_t, kSlotCount + 1> heads_;
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> free_nodes_;
+  std::unordered_map<uint64_t, uint32_t> index_;
+};
+
+}  // namespace mir2::network
+
+#endif  // MIR2_NETWORK_TIMING_WHEEL_H
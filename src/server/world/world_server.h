@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -40,7 +41,7 @@ class WorldServer {
   void RegisterHandlers();
   void RegisterMessageHandlers();
   void HandleRoutedMessage(const std::shared_ptr<network::TcpSession>& session,
-                          const std::vector<uint8_t>& payload);
+                           std::span<const uint8_t> payload, bool framed);
 
   core::Application app_;
   std::unique_ptr<network::NetworkManager> network_;
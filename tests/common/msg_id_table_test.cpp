@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "server/common/msg_id_table.h"
+
+using mir2::common::MsgIdTable;
+
+TEST(MsgIdTableTest, FindReturnsNullForUnallocatedPage) {
+    MsgIdTable<int> table;
+    EXPECT_EQ(table.Find(0), nullptr);
+    EXPECT_EQ(table.Find(1001), nullptr);
+    EXPECT_EQ(table.Find(65535), nullptr);
+}
+
+TEST(MsgIdTableTest, AtAllocatesPageWithEmptySlots) {
+    MsgIdTable<int> table;
+    table.At(1001) = 7;
+
+    ASSERT_NE(table.Find(1001), nullptr);
+    EXPECT_EQ(*table.Find(1001), 7);
+    // Neighbours on the same page exist but hold a value-initialized slot.
+    ASSERT_NE(table.Find(1002), nullptr);
+    EXPECT_EQ(*table.Find(1002), 0);
+    EXPECT_EQ(table.Find(60011), nullptr);
+}
+
+TEST(MsgIdTableTest, CoversFullMsgIdRange) {
+    MsgIdTable<uint32_t> table;
+    for (uint32_t id = 0; id <= 0xFFFF; id += 257) {
+        table.At(static_cast<uint16_t>(id)) = id + 1;
+    }
+    table.At(0xFFFF) = 0x10000;
+
+    for (uint32_t id = 0; id <= 0xFFFF; id += 257) {
+        ASSERT_NE(table.Find(static_cast<uint16_t>(id)), nullptr);
+        EXPECT_EQ(*table.Find(static_cast<uint16_t>(id)), id + 1);
+    }
+    EXPECT_EQ(*table.Find(0xFFFF), 0x10000u);
+}
+
+TEST(MsgIdTableTest, CopyIsDeep) {
+    MsgIdTable<std::function<int()>> table;
+    table.At(60010) = [] { return 1; };
+
+    MsgIdTable<std::function<int()>> copy(table);
+    copy.At(60010) = [] { return 2; };
+    copy.At(3001) = [] { return 3; };
+
+    EXPECT_EQ((*table.Find(60010))(), 1);
+    EXPECT_EQ(table.Find(3001), nullptr);
+    EXPECT_EQ((*copy.Find(60010))(), 2);
+    EXPECT_EQ((*copy.Find(3001))(), 3);
+}
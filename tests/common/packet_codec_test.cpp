@@ -269,6 +269,47 @@ TEST(packet_codec, CRC16KnownVector) {
     EXPECT_EQ(crc, 0x29B1);
 }
 
+TEST(packet_codec, CRC16ImplementationsBitExact) {
+    // Pseudo-random bytes so every table lane and fold path is exercised.
+    std::vector<uint8_t> data(4096 + 7);
+    uint32_t state = 0x12345678;
+    for (auto& byte : data) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+
+    const mir2::common::CRC16Impl impls[] = {mir2::common::CRC16Impl::kSlicing8,
+                                             mir2::common::CRC16Impl::kClmul};
+    for (const auto impl : impls) {
+        if (!mir2::common::IsCRC16ImplSupported(impl)) {
+            continue;
+        }
+        for (size_t length = 0; length <= 300; ++length) {
+            for (const size_t offset : {size_t{0}, size_t{3}}) {
+                for (const uint16_t init : {uint16_t{0}, uint16_t{0xFFFF}, uint16_t{0x1D0F}}) {
+                    const uint16_t expected = mir2::common::UpdateCRC16With(
+                        mir2::common::CRC16Impl::kBytewise, init, data.data() + offset, length);
+                    EXPECT_EQ(mir2::common::UpdateCRC16With(impl, init, data.data() + offset, length),
+                              expected)
+                        << "impl=" << static_cast<int>(impl) << " length=" << length
+                        << " offset=" << offset << " init=" << init;
+                }
+            }
+        }
+        for (const size_t length : {size_t{1024}, size_t{1500}, size_t{4096}}) {
+            EXPECT_EQ(mir2::common::UpdateCRC16With(impl, 0xFFFF, data.data() + 7, length),
+                      mir2::common::UpdateCRC16With(mir2::common::CRC16Impl::kBytewise, 0xFFFF,
+                                                    data.data() + 7, length))
+                << "impl=" << static_cast<int>(impl) << " length=" << length;
+        }
+    }
+
+    // The dispatching entry point agrees with the reference as well.
+    EXPECT_EQ(mir2::common::CalcCRC16(data.data(), data.size()),
+              mir2::common::UpdateCRC16With(mir2::common::CRC16Impl::kBytewise, 0xFFFF,
+                                            data.data(), data.size()));
+}
+
 TEST(packet_codec, DetectProtocolVersionTest) {
     uint32_t v1_magic = mir2::common::PacketHeader::kMagic;
     uint32_t v2_magic = mir2::common::PacketHeaderV2::kMagic;
@@ -321,3 +362,55 @@ TEST(packet_codec, V2FlagsPreserved) {
     EXPECT_EQ(status, mir2::common::DecodeStatus::kOk);
     EXPECT_EQ(decoded_flags, flags);
 }
+
+TEST(packet_codec, DecodeViewPointsIntoInputBuffer) {
+    const auto payload = BuildPayload(48);
+    const auto encoded = mir2::common::EncodePacket(
+        static_cast<uint16_t>(mir2::common::MsgId::kMoveReq), payload.data(), payload.size());
+
+    mir2::common::NetworkPacketView view;
+    ASSERT_EQ(mir2::common::DecodePacketView(encoded.data(), encoded.size(), &view),
+              mir2::common::DecodeStatus::kOk);
+    EXPECT_EQ(view.msg_id, static_cast<uint16_t>(mir2::common::MsgId::kMoveReq));
+    EXPECT_EQ(view.payload.data(), encoded.data() + mir2::common::PacketHeader::kSize);
+    EXPECT_EQ(view.ToOwned().payload, payload);
+}
+
+TEST(packet_codec, V2DecodeViewPointsIntoInputBuffer) {
+    const auto payload = BuildPayload(48);
+    const auto encoded = mir2::common::EncodePacketV2(
+        static_cast<uint16_t>(mir2::common::MsgId::kMoveReq), payload.data(), payload.size(), 9);
+
+    mir2::common::NetworkPacketView view;
+    uint16_t sequence = 0;
+    ASSERT_EQ(mir2::common::DecodePacketV2View(encoded.data(), encoded.size(), &view, &sequence),
+              mir2::common::DecodeStatus::kOk);
+    EXPECT_EQ(sequence, 9);
+    EXPECT_EQ(view.payload.data(), encoded.data() + mir2::common::PacketHeaderV2::kSize);
+    EXPECT_EQ(view.ToOwned().payload, payload);
+
+    auto corrupted = encoded;
+    corrupted.back() ^= 0xFF;
+    EXPECT_EQ(mir2::common::DecodePacketV2View(corrupted.data(), corrupted.size(), &view),
+              mir2::common::DecodeStatus::kInvalidChecksum);
+}
+
+TEST(packet_codec, GatherEncodeMatchesContiguousPayload) {
+    const auto prefix = BuildPayload(16);
+    const auto body = BuildPayload(300);
+    std::vector<uint8_t> joined(prefix);
+    joined.insert(joined.end(), body.begin(), body.end());
+    const uint16_t msg_id = static_cast<uint16_t>(mir2::common::MsgId::kMoveReq);
+
+    const auto v1 = mir2::network::PacketCodec::EncodeGatherPooled(msg_id, prefix, body);
+    EXPECT_EQ(std::vector<uint8_t>(v1.Data(), v1.Data() + v1.Size()),
+              mir2::common::EncodePacket(msg_id, joined.data(), joined.size()));
+
+    const auto v2 = mir2::network::PacketCodec::EncodeV2GatherPooled(msg_id, prefix, body, 7, 0);
+    EXPECT_EQ(std::vector<uint8_t>(v2.Data(), v2.Data() + v2.Size()),
+              mir2::common::EncodePacketV2(msg_id, joined.data(), joined.size(), 7, 0));
+
+    const auto empty_body = mir2::network::PacketCodec::EncodeGatherPooled(msg_id, prefix, {});
+    EXPECT_EQ(std::vector<uint8_t>(empty_body.Data(), empty_body.Data() + empty_body.Size()),
+              mir2::common::EncodePacket(msg_id, prefix.data(), prefix.size()));
+}
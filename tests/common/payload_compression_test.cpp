@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/protocol/packet_codec.h"
+#include "common/protocol/payload_compression.h"
+
+namespace {
+
+std::vector<uint8_t> BuildRepetitive(size_t size) {
+    // Shaped like a FlatBuffers entity list: repeated small records with a changing id.
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>((i % 24 == 0) ? (i / 24) & 0xFF : (i % 24) * 3);
+    }
+    return data;
+}
+
+std::vector<uint8_t> BuildRandom(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(size);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return data;
+}
+
+std::vector<uint8_t> RoundTrip(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> block(mir2::common::Lz4CompressBound(input.size()));
+    const size_t size = mir2::common::Lz4CompressBlock(input.data(), input.size(), block.data(),
+                                                       block.size());
+    EXPECT_GT(size, 0u);
+    std::vector<uint8_t> output(input.size());
+    EXPECT_TRUE(mir2::common::Lz4DecompressBlock(block.data(), size, output.data(), output.size()));
+    return output;
+}
+
+}  // namespace
+
+TEST(payload_compression, BlockRoundTripVariousSizes) {
+    for (const size_t size : {size_t{0}, size_t{1}, size_t{12}, size_t{13}, size_t{64}, size_t{4096},
+                              size_t{70000}, size_t{300000}}) {
+        const auto repetitive = BuildRepetitive(size);
+        EXPECT_EQ(RoundTrip(repetitive), repetitive) << "size=" << size;
+        const auto random = BuildRandom(size, static_cast<uint32_t>(size));
+        EXPECT_EQ(RoundTrip(random), random) << "size=" << size;
+    }
+}
+
+TEST(payload_compression, LongRunsUseOverlappingMatches) {
+    std::vector<uint8_t> input(5000, 0x41);
+    input.push_back(0x42);
+    EXPECT_EQ(RoundTrip(input), input);
+}
+
+TEST(payload_compression, KnownBlockDecodes) {
+    // Hand-assembled LZ4 block: literals "abc", match offset 3 length 9, literals "xyz!!".
+    const std::vector<uint8_t> block = {0x35, 'a', 'b', 'c', 0x03, 0x00, 0x50, 'x', 'y', 'z', '!', '!'};
+    std::vector<uint8_t> output(17);
+    ASSERT_TRUE(mir2::common::Lz4DecompressBlock(block.data(), block.size(), output.data(),
+                                                 output.size()));
+    EXPECT_EQ(std::string(output.begin(), output.end()), "abcabcabcabcxyz!!");
+}
+
+TEST(payload_compression, CompressPayloadShrinksRepetitiveData) {
+    const auto payload = BuildRepetitive(2048);
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(mir2::common::CompressPayload(payload.data(), payload.size(), &compressed));
+    EXPECT_LT(compressed.size(), payload.size() / 2);
+
+    std::vector<uint8_t> restored;
+    ASSERT_TRUE(mir2::common::DecompressPayload(compressed, &restored));
+    EXPECT_EQ(restored, payload);
+}
+
+TEST(payload_compression, CompressPayloadRejectsIncompressibleData) {
+    const auto payload = BuildRandom(1024, 7);
+    std::vector<uint8_t> compressed;
+    EXPECT_FALSE(mir2::common::CompressPayload(payload.data(), payload.size(), &compressed));
+}
+
+TEST(payload_compression, MalformedInputIsRejected) {
+    const auto payload = BuildRepetitive(4096);
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(mir2::common::CompressPayload(payload.data(), payload.size(), &compressed));
+
+    std::vector<uint8_t> restored;
+    // Truncated block.
+    std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 3);
+    EXPECT_FALSE(mir2::common::DecompressPayload(truncated, &restored));
+
+    // Declared size larger than the protocol limit.
+    std::vector<uint8_t> oversized = compressed;
+    const uint32_t huge = static_cast<uint32_t>(mir2::common::kMaxPayloadSize + 1);
+    std::memcpy(oversized.data(), &huge, sizeof(huge));
+    EXPECT_FALSE(mir2::common::DecompressPayload(oversized, &restored));
+
+    // Match offset pointing before the start of the output.
+    const std::vector<uint8_t> bad_offset = {0x10, 'a', 0x05, 0x00, 0x00};
+    std::vector<uint8_t> output(8);
+    EXPECT_FALSE(mir2::common::Lz4DecompressBlock(bad_offset.data(), bad_offset.size(),
+                                                  output.data(), output.size()));
+
+    // Flipping bytes must never crash; most variants are rejected.
+    for (size_t i = sizeof(uint32_t); i < compressed.size(); i += 7) {
+        auto corrupted = compressed;
+        corrupted[i] ^= 0xFF;
+        mir2::common::DecompressPayload(corrupted, &restored);
+    }
+}
@@ -45,7 +45,8 @@ TEST(TcpSessionTest, RateLimitExceededMarksLimited) {
   asio::io_context io_context;
   auto session = CreateSession(io_context);
 
-  Packet packet{1, std::vector<uint8_t>(1, 0)};
+  const std::vector<uint8_t> payload(1, 0);
+  const PacketView packet{1, payload};
   for (int i = 0; i < 50; ++i) {
     session->HandlePacket(1, packet);
     EXPECT_FALSE(session->IsRateLimited());
@@ -56,4 +57,19 @@ TEST(TcpSessionTest, RateLimitExceededMarksLimited) {
   EXPECT_NE(session->GetState(), TcpSession::SessionState::kActive);
 }
 
+TEST(TcpSessionTest, ZeroRateLimitDisablesLimiter) {
+  asio::io_context io_context;
+  auto session = CreateSession(io_context);
+  session->SetRateLimit(0, 0);
+
+  const std::vector<uint8_t> payload(1024, 0);
+  const PacketView packet{1, payload};
+  for (int i = 0; i < 1000; ++i) {
+    session->HandlePacket(1, packet);
+  }
+
+  EXPECT_FALSE(session->IsRateLimited());
+  EXPECT_EQ(session->GetState(), TcpSession::SessionState::kActive);
+}
+
 }  // namespace mir2::network
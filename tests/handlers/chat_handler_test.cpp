@@ -38,9 +38,10 @@ TEST(ChatHandlerTest, WorldChatBroadcastsMessage) {
                    payload,
                    [&responses](const legend2::handlers::ResponseList& rsp) { responses = rsp; });
 
-    ASSERT_EQ(responses.size(), 3u);
+    ASSERT_EQ(responses.size(), 2u);
     EXPECT_EQ(responses[0].msg_id,
               static_cast<uint16_t>(mir2::common::MsgId::kChatRsp));
+    EXPECT_EQ(responses[1].recipients.size(), 2u);
 
     flatbuffers::Verifier verifier(responses[1].payload.data(), responses[1].payload.size());
     ASSERT_TRUE(verifier.VerifyBuffer<mir2::proto::ChatMessage>(nullptr));
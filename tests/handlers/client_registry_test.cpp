@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <asio/io_context.hpp>
+
+#include <cstdint>
+#include <memory>
+
+#include "handlers/client_registry.h"
+#include "mocks/mock_socket.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace {
+
+std::shared_ptr<mir2::network::TcpSession> CreateGatewaySession(asio::io_context& io_context,
+                                                                uint64_t connection_id) {
+    auto socket = std::make_unique<mir2::network::MockSocket>(io_context.get_executor());
+    auto connection =
+        std::make_shared<mir2::network::TcpConnection>(std::move(socket), connection_id);
+    auto session = std::make_shared<mir2::network::TcpSession>(connection);
+    session->Start();
+    return session;
+}
+
+}  // namespace
+
+TEST(ClientRegistryTest, LearnsOwningGatewayPerClient) {
+    asio::io_context io_context;
+    auto gateway_a = CreateGatewaySession(io_context, 1);
+    auto gateway_b = CreateGatewaySession(io_context, 2);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway_a);
+    registry.Track(200, gateway_b);
+
+    EXPECT_EQ(registry.GetGateway(100), gateway_a);
+    EXPECT_EQ(registry.GetGateway(200), gateway_b);
+    EXPECT_EQ(registry.GetGateway(300), nullptr);
+    EXPECT_TRUE(registry.Contains(100));
+    EXPECT_EQ(registry.GetAll().size(), 2u);
+}
+
+TEST(ClientRegistryTest, ReconnectThroughAnotherGatewayMovesAffinity) {
+    asio::io_context io_context;
+    auto gateway_a = CreateGatewaySession(io_context, 1);
+    auto gateway_b = CreateGatewaySession(io_context, 2);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway_a);
+    registry.Track(100, gateway_b);
+    EXPECT_EQ(registry.GetGateway(100), gateway_b);
+
+    // Tracking without a gateway keeps the learned one.
+    registry.Track(100);
+    EXPECT_EQ(registry.GetGateway(100), gateway_b);
+}
+
+TEST(ClientRegistryTest, LogoutAndClosedGatewayClearAffinity) {
+    asio::io_context io_context;
+    auto gateway = CreateGatewaySession(io_context, 1);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway);
+    registry.Track(200, gateway);
+
+    registry.Remove(100);
+    EXPECT_FALSE(registry.Contains(100));
+    EXPECT_EQ(registry.GetGateway(100), nullptr);
+
+    gateway->Close();
+    EXPECT_EQ(registry.GetGateway(200), nullptr);
+    gateway.reset();
+    EXPECT_EQ(registry.GetGateway(200), nullptr);
+}
+
+TEST(ClientRegistryTest, LookupDropsClientOfReleasedGateway) {
+    asio::io_context io_context;
+    auto gateway = CreateGatewaySession(io_context, 1);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway);
+    registry.Track(200);
+
+    gateway->Close();
+    gateway.reset();
+    // Let pending IO handlers release their references to the session.
+    io_context.run();
+    EXPECT_EQ(registry.GetGateway(100), nullptr);
+    EXPECT_FALSE(registry.Contains(100));
+
+    // A client tracked without a gateway is not treated as stale.
+    EXPECT_EQ(registry.GetGateway(200), nullptr);
+    EXPECT_TRUE(registry.Contains(200));
+}
+
+TEST(ClientRegistryTest, RemoveGatewaySweepsOnlyItsClients) {
+    asio::io_context io_context;
+    auto gateway_a = CreateGatewaySession(io_context, 1);
+    auto gateway_b = CreateGatewaySession(io_context, 2);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway_a);
+    registry.Track(101, gateway_a);
+    registry.Track(200, gateway_b);
+    registry.Track(300);
+
+    EXPECT_EQ(registry.RemoveGateway(gateway_a), 2u);
+    EXPECT_FALSE(registry.Contains(100));
+    EXPECT_FALSE(registry.Contains(101));
+    EXPECT_EQ(registry.GetGateway(200), gateway_b);
+    EXPECT_TRUE(registry.Contains(300));
+    EXPECT_EQ(registry.RemoveGateway(nullptr), 0u);
+}
+
+TEST(ClientRegistryTest, RemembersGatewayFraming) {
+    asio::io_context io_context;
+    auto gateway = CreateGatewaySession(io_context, 1);
+
+    legend2::handlers::ClientRegistry registry;
+    registry.Track(100, gateway, false);
+
+    bool framed = true;
+    EXPECT_EQ(registry.GetGateway(100, &framed), gateway);
+    EXPECT_FALSE(framed);
+
+    // The gateway upgrading to routed frames is picked up on its next request.
+    registry.Track(100, gateway, true);
+    EXPECT_EQ(registry.GetGateway(100, &framed), gateway);
+    EXPECT_TRUE(framed);
+}
@@ -2,6 +2,7 @@
 
 #include <entt/entt.hpp>
 
+#include <algorithm>
 #include <thread>
 #include <vector>
 
@@ -86,9 +87,15 @@ TEST(MovementHandlerTest, ValidMoveBroadcastsAndResponds) {
                    payload,
                    [&responses](const legend2::handlers::ResponseList& rsp) { responses = rsp; });
 
-    ASSERT_EQ(responses.size(), 3u);
+    ASSERT_EQ(responses.size(), 2u);
     EXPECT_EQ(responses[0].msg_id,
               static_cast<uint16_t>(mir2::common::MsgId::kMoveRsp));
+    // The broadcast is a single multicast response carrying one payload.
+    EXPECT_EQ(responses[1].msg_id,
+              static_cast<uint16_t>(mir2::common::MsgId::kEntityMove));
+    auto recipients = responses[1].recipients;
+    std::sort(recipients.begin(), recipients.end());
+    EXPECT_EQ(recipients, (std::vector<uint64_t>{1, 2}));
 
     mir2::common::MoveResponse response;
     const auto status = mir2::common::DecodeMoveResponse(
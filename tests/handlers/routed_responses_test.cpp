@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/enums.h"
+#include "handlers/client_registry.h"
+#include "handlers/routed_responses.h"
+#include "mocks/mock_socket.h"
+#include "network/packet_codec.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+#include "server/common/routed_envelope.h"
+
+namespace {
+
+struct Gateway {
+    std::shared_ptr<mir2::network::TcpSession> session;
+    mir2::network::MockSocket* socket = nullptr;
+};
+
+Gateway CreateGateway(asio::io_context& io_context, uint64_t connection_id) {
+    auto socket = std::make_unique<mir2::network::MockSocket>(io_context.get_executor());
+    Gateway gateway;
+    gateway.socket = socket.get();
+    auto connection =
+        std::make_shared<mir2::network::TcpConnection>(std::move(socket), connection_id);
+    gateway.session = std::make_shared<mir2::network::TcpSession>(connection);
+    gateway.session->Start();
+    return gateway;
+}
+
+void DrainIoContext(asio::io_context& io_context) {
+    while (io_context.poll_one() > 0) {
+    }
+    io_context.restart();
+}
+
+// Decodes the written stream (writes may coalesce several packets) into the sorted
+// recipient list of each routed multicast frame.
+std::vector<std::vector<uint64_t>> MulticastRecipients(const mir2::network::MockSocket* socket) {
+    std::vector<uint8_t> stream;
+    for (const auto& write : socket->GetWrites()) {
+        stream.insert(stream.end(), write.begin(), write.end());
+    }
+    std::vector<std::vector<uint64_t>> result;
+    size_t offset = 0;
+    while (offset < stream.size()) {
+        mir2::network::Packet packet;
+        if (mir2::network::PacketCodec::Decode(stream.data() + offset, stream.size() - offset,
+                                               &packet) != mir2::network::DecodeStatus::kOk) {
+            break;
+        }
+        offset += mir2::network::PacketHeader::kSize + packet.payload.size();
+        mir2::common::RoutedFrameView view;
+        mir2::common::RoutedMulticastView multicast;
+        if (!mir2::common::PeelRoutedFrame(packet.payload, &view) ||
+            !mir2::common::PeelRoutedMulticast(view, &multicast)) {
+            continue;
+        }
+        std::vector<uint64_t> recipients;
+        for (size_t i = 0; i < multicast.recipient_count; ++i) {
+            recipients.push_back(multicast.RecipientAt(i));
+        }
+        std::sort(recipients.begin(), recipients.end());
+        result.push_back(std::move(recipients));
+    }
+    return result;
+}
+
+// Message ids of every packet written to the socket, in order.
+std::vector<uint16_t> PacketIds(const mir2::network::MockSocket* socket) {
+    std::vector<uint8_t> stream;
+    for (const auto& write : socket->GetWrites()) {
+        stream.insert(stream.end(), write.begin(), write.end());
+    }
+    std::vector<uint16_t> ids;
+    size_t offset = 0;
+    while (offset < stream.size()) {
+        mir2::network::Packet packet;
+        if (mir2::network::PacketCodec::Decode(stream.data() + offset, stream.size() - offset,
+                                               &packet) != mir2::network::DecodeStatus::kOk) {
+            break;
+        }
+        offset += mir2::network::PacketHeader::kSize + packet.payload.size();
+        ids.push_back(packet.msg_id);
+    }
+    return ids;
+}
+
+legend2::handlers::ResponseList BuildMulticast(std::vector<uint64_t> recipients) {
+    legend2::handlers::ResponseList responses;
+    responses.push_back({0, static_cast<uint16_t>(mir2::common::MsgId::kEntityMove),
+                         std::vector<uint8_t>{1, 2, 3}, std::move(recipients)});
+    return responses;
+}
+
+}  // namespace
+
+TEST(RoutedResponsesTest, MulticastSentOnceThroughRequestingGateway) {
+    asio::io_context io_context;
+    auto gateway = CreateGateway(io_context, 1);
+
+    legend2::handlers::SendRoutedResponses(gateway.session, BuildMulticast({1, 2, 3}), true);
+    DrainIoContext(io_context);
+
+    const auto frames = MulticastRecipients(gateway.socket);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], (std::vector<uint64_t>{1, 2, 3}));
+}
+
+TEST(RoutedResponsesTest, MulticastSplitByOwningGateway) {
+    asio::io_context io_context;
+    auto gateway_a = CreateGateway(io_context, 1);
+    auto gateway_b = CreateGateway(io_context, 2);
+
+    legend2::handlers::ClientRegistry clients;
+    clients.Track(1, gateway_a.session);
+    clients.Track(2, gateway_a.session);
+    clients.Track(3, gateway_b.session);
+
+    // Client 4 has no known gateway and goes through the requesting one.
+    legend2::handlers::SendRoutedResponses(gateway_a.session, BuildMulticast({1, 2, 3, 4}), true,
+                                           &clients);
+    DrainIoContext(io_context);
+
+    const auto frames_a = MulticastRecipients(gateway_a.socket);
+    ASSERT_EQ(frames_a.size(), 2u);
+    EXPECT_EQ(frames_a[0], (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(frames_a[1], (std::vector<uint64_t>{4}));
+
+    const auto frames_b = MulticastRecipients(gateway_b.socket);
+    ASSERT_EQ(frames_b.size(), 1u);
+    EXPECT_EQ(frames_b[0], (std::vector<uint64_t>{3}));
+}
+
+TEST(RoutedResponsesTest, LegacyGatewayReceivesPerClientRoutedMessages) {
+    asio::io_context io_context;
+    auto framed_gateway = CreateGateway(io_context, 1);
+    auto legacy_gateway = CreateGateway(io_context, 2);
+
+    legend2::handlers::ClientRegistry clients;
+    clients.Track(1, framed_gateway.session, true);
+    clients.Track(2, legacy_gateway.session, false);
+    clients.Track(3, legacy_gateway.session, false);
+
+    legend2::handlers::SendRoutedResponses(framed_gateway.session, BuildMulticast({1, 2, 3}), true,
+                                           &clients);
+    DrainIoContext(io_context);
+
+    const auto frames = MulticastRecipients(framed_gateway.socket);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], (std::vector<uint64_t>{1}));
+
+    // The legacy gateway never sees a routed frame it cannot parse.
+    const auto legacy_id = static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedMessage);
+    EXPECT_EQ(PacketIds(legacy_gateway.socket), (std::vector<uint16_t>{legacy_id, legacy_id}));
+}
+
+TEST(RoutedResponsesTest, SendRoutedToFollowsGatewayFraming) {
+    asio::io_context io_context;
+    auto gateway = CreateGateway(io_context, 1);
+    const std::vector<uint8_t> payload{7, 8};
+    const auto msg_id = static_cast<uint16_t>(mir2::common::MsgId::kEntityMove);
+
+    legend2::handlers::SendRoutedTo(*gateway.session, 5, msg_id, payload, false);
+    legend2::handlers::SendRoutedTo(*gateway.session, 5, msg_id, payload, true);
+    DrainIoContext(io_context);
+
+    EXPECT_EQ(PacketIds(gateway.socket),
+              (std::vector<uint16_t>{
+                  static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedMessage),
+                  static_cast<uint16_t>(mir2::common::InternalMsgId::kRoutedFrame)}));
+}
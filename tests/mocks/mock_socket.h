@@ -52,6 +52,7 @@ class MockSocket : public SocketAdapter {
   const std::vector<std::vector<uint8_t>>& GetWrites() const { return writes_; }
   bool IsClosed() const { return closed_; }
   bool ShutdownCalled() const { return shutdown_called_; }
+  bool NoDelay() const { return no_delay_; }
 
   void async_read_some(const asio::mutable_buffer& buffer, IoHandler handler) override {
     if (read_error_once_) {
@@ -85,6 +86,11 @@ class MockSocket : public SocketAdapter {
     asio::post(executor_, [handler = std::move(handler), bytes]() { handler({}, bytes); });
   }
 
+  void set_no_delay(bool enabled, asio::error_code& ec) override {
+    no_delay_ = enabled;
+    ec.clear();
+  }
+
   void shutdown(asio::ip::tcp::socket::shutdown_type /*type*/, asio::error_code& ec) override {
     shutdown_called_ = true;
     ec.clear();
@@ -161,6 +167,7 @@ class MockSocket : public SocketAdapter {
   bool write_error_once_ = false;
   bool closed_ = false;
   bool shutdown_called_ = false;
+  bool no_delay_ = false;
 };
 
 }  // namespace mir2::network
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <asio/io_context.hpp>
+
+#include "mocks/mock_socket.h"
+#include "network/buffer_pool.h"
+#include "network/packet_codec.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace mir2::network {
+
+TEST(BufferPoolTest, AcquireRoundsUpToSizeClass) {
+  auto small = BufferPool::Acquire(10);
+  EXPECT_EQ(small.Size(), 10u);
+  EXPECT_EQ(small.Capacity(), BufferPool::kSizeClasses.front());
+
+  auto medium = BufferPool::Acquire(300);
+  EXPECT_EQ(medium.Capacity(), 512u);
+
+  const size_t oversize = BufferPool::kSizeClasses.back() + 1;
+  EXPECT_EQ(BufferPool::SizeClassFor(oversize), BufferPool::kUnpooled);
+  auto large = BufferPool::Acquire(oversize);
+  EXPECT_EQ(large.Size(), oversize);
+}
+
+TEST(BufferPoolTest, ReleasedBlockIsReusedWithoutHeapAllocation) {
+  uint8_t* first = nullptr;
+  {
+    auto buffer = BufferPool::Acquire(100);
+    first = buffer.Data();
+  }
+  const auto before = BufferPool::GetStats();
+  auto buffer = BufferPool::Acquire(120);
+  EXPECT_EQ(buffer.Data(), first);
+  EXPECT_EQ(BufferPool::GetStats().heap_allocs, before.heap_allocs);
+}
+
+TEST(BufferPoolTest, MoveTransfersOwnership) {
+  auto buffer = BufferPool::Acquire(32);
+  uint8_t* data = buffer.Data();
+  PooledBuffer moved = std::move(buffer);
+  EXPECT_EQ(moved.Data(), data);
+  EXPECT_EQ(buffer.Data(), nullptr);
+  EXPECT_TRUE(buffer.Empty());
+}
+
+TEST(BufferPoolTest, CrossThreadReleaseIsRecycled) {
+  // Frames are encoded on the logic thread and released on the IO thread after the write.
+  constexpr int kRounds = 50;
+  constexpr int kFramesPerRound = 256;
+  for (int round = 0; round < kRounds; ++round) {
+    std::vector<PooledBuffer> frames;
+    for (int i = 0; i < kFramesPerRound; ++i) {
+      frames.push_back(BufferPool::Acquire(48));
+    }
+    std::thread io_thread([frames = std::move(frames)]() mutable { frames.clear(); });
+    io_thread.join();
+  }
+  const auto warm = BufferPool::GetStats();
+  for (int round = 0; round < kRounds; ++round) {
+    std::vector<PooledBuffer> frames;
+    for (int i = 0; i < kFramesPerRound; ++i) {
+      frames.push_back(BufferPool::Acquire(48));
+    }
+    std::thread io_thread([frames = std::move(frames)]() mutable { frames.clear(); });
+    io_thread.join();
+  }
+  EXPECT_EQ(BufferPool::GetStats().heap_allocs, warm.heap_allocs);
+}
+
+TEST(BufferPoolTest, PooledEncodeMatchesVectorEncode) {
+  std::vector<uint8_t> payload(77);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 13);
+  }
+  const auto v1 = PacketCodec::EncodePooled(9, payload.data(), payload.size());
+  const auto expected_v1 = PacketCodec::Encode(9, payload.data(), payload.size());
+  EXPECT_EQ(std::vector<uint8_t>(v1.Data(), v1.Data() + v1.Size()), expected_v1);
+
+  const auto v2 = PacketCodec::EncodeV2Pooled(9, payload.data(), payload.size(), 42, 0x01);
+  const auto expected_v2 = PacketCodec::EncodeV2(9, payload.data(), payload.size(), 42, 0x01);
+  EXPECT_EQ(std::vector<uint8_t>(v2.Data(), v2.Data() + v2.Size()), expected_v2);
+
+  const std::vector<uint8_t> too_large(mir2::common::kMaxPayloadSize + 1);
+  EXPECT_TRUE(PacketCodec::EncodePooled(9, too_large.data(), too_large.size()).Empty());
+}
+
+TEST(BufferPoolTest, SteadyStateSessionSendDoesNotGrowPool) {
+  asio::io_context io_context;
+  auto socket = std::make_unique<MockSocket>(io_context.get_executor());
+  auto session = std::make_shared<TcpSession>(
+      std::make_shared<TcpConnection>(std::move(socket), 1));
+  session->SetProtocolVersion(ProtocolVersion::kV2);
+  session->Start();
+
+  const std::vector<uint8_t> payload(40, 0x7E);
+  auto send_burst = [&]() {
+    for (int i = 0; i < 32; ++i) {
+      session->Send(1, payload);
+    }
+    io_context.restart();
+    io_context.run();
+  };
+
+  send_burst();
+  const auto warm = BufferPool::GetStats();
+  for (int i = 0; i < 100; ++i) {
+    send_burst();
+  }
+  EXPECT_EQ(BufferPool::GetStats().heap_allocs, warm.heap_allocs);
+}
+
+}  // namespace mir2::network
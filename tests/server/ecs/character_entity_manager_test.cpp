@@ -159,3 +159,28 @@ TEST(CharacterEntityManagerDirtyTest, UpdateUsesSaveIfDirty) {
     EXPECT_EQ(stored->stats.hp, 77);
     EXPECT_FALSE(dirty_tracker::is_dirty(registry, entity));
 }
+
+TEST(CharacterEntityManagerDirtyTest, UpdateDefersSavesBeyondPerTickLimit) {
+    entt::registry registry;
+    CharacterEntityManager manager(registry);
+    manager.SetSaveIntervalSeconds(0.1f);
+    manager.SetAutoSaveLimit(2);
+    for (uint32_t id = 31; id <= 33; ++id) {
+        auto entity = manager.GetOrCreate(id);
+        dirty_tracker::mark_attributes_dirty(registry, entity);
+    }
+
+    manager.Update(0.11f);
+
+    int stored = 0;
+    for (uint32_t id = 31; id <= 33; ++id) {
+        stored += manager.GetStoredData(id).has_value() ? 1 : 0;
+    }
+    EXPECT_EQ(stored, 2);
+
+    // The character that missed its slot is saved on the next tick.
+    manager.Update(0.0f);
+    for (uint32_t id = 31; id <= 33; ++id) {
+        EXPECT_TRUE(manager.GetStoredData(id).has_value());
+    }
+}
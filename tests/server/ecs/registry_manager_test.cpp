@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "ecs/registry_manager.h"
 #include "ecs/components/character_components.h"
 
@@ -63,7 +65,8 @@ TEST(RegistryManagerTest, CharacterMovesAcrossWorlds) {
 
     EXPECT_EQ(character_manager.TryGetMapId(kCharacterId).value_or(0), kMapId1);
 
-    EXPECT_TRUE(character_manager.MoveToMap(kCharacterId, kMapId2, 10, 11));
+    EXPECT_EQ(character_manager.MoveToMap(kCharacterId, kMapId2, 10, 11),
+              mir2::ecs::CharacterEntityManager::MoveResult::kMoved);
 
     auto moved_entity = character_manager.TryGet(kCharacterId);
     ASSERT_TRUE(moved_entity.has_value());
@@ -77,3 +80,97 @@ TEST(RegistryManagerTest, CharacterMovesAcrossWorlds) {
     EXPECT_EQ(state->position.x, 10);
     EXPECT_EQ(state->position.y, 11);
 }
+
+namespace {
+
+class MoveOnUpdateSystem : public mir2::ecs::System {
+public:
+    MoveOnUpdateSystem(uint32_t character_id, uint32_t target_map, bool* moved_during_update)
+        : System(mir2::ecs::SystemPriority::kMovement),
+          character_id_(character_id),
+          target_map_(target_map),
+          moved_during_update_(moved_during_update) {}
+
+    void Update(entt::registry& /*registry*/, float /*delta_time*/) override {
+        auto& character_manager = mir2::ecs::RegistryManager::Instance().GetCharacterManager();
+        if (character_manager.TryGetMapId(character_id_).value_or(0) == target_map_) {
+            return;
+        }
+        EXPECT_EQ(character_manager.MoveToMap(character_id_, target_map_, 3, 4),
+                  mir2::ecs::CharacterEntityManager::MoveResult::kDeferred);
+        *moved_during_update_ =
+            character_manager.TryGetMapId(character_id_).value_or(0) == target_map_;
+    }
+
+private:
+    uint32_t character_id_;
+    uint32_t target_map_;
+    bool* moved_during_update_;
+};
+
+}  // namespace
+
+TEST(RegistryManagerTest, ParallelUpdateAllUpdatesEveryWorld) {
+    auto& manager = mir2::ecs::RegistryManager::Instance();
+    constexpr uint32_t kFirstMapId = 9201;
+    constexpr int kWorldCount = 8;
+
+    std::vector<int> counters(kWorldCount, 0);
+    std::vector<mir2::ecs::World*> worlds;
+    for (int i = 0; i < kWorldCount; ++i) {
+        auto* world = manager.CreateWorld(kFirstMapId + i);
+        ASSERT_NE(world, nullptr);
+        world->CreateSystem<CounterSystem>(&counters[i]);
+        worlds.push_back(world);
+    }
+
+    manager.SetParallelUpdate(3);
+    EXPECT_TRUE(manager.IsParallelUpdate());
+    manager.UpdateAll(0.016f);
+    manager.UpdateAll(0.016f);
+    manager.SetParallelUpdate(0);
+    EXPECT_FALSE(manager.IsParallelUpdate());
+
+    for (int counter : counters) {
+        EXPECT_EQ(counter, 2);
+    }
+    for (auto* world : worlds) {
+        world->ClearSystems();
+    }
+}
+
+TEST(RegistryManagerTest, ParallelUpdateDefersCrossMapMoves) {
+    auto& manager = mir2::ecs::RegistryManager::Instance();
+    constexpr uint32_t kMapId1 = 9301;
+    constexpr uint32_t kMapId2 = 9302;
+    constexpr uint32_t kCharacterId = 50002;
+
+    auto* world1 = manager.CreateWorld(kMapId1);
+    auto* world2 = manager.CreateWorld(kMapId2);
+    ASSERT_NE(world1, nullptr);
+    ASSERT_NE(world2, nullptr);
+
+    auto& character_manager = manager.GetCharacterManager();
+    character_manager.GetOrCreate(kCharacterId, kMapId1);
+
+    bool moved_during_update = true;
+    world1->CreateSystem<MoveOnUpdateSystem>(kCharacterId, kMapId2, &moved_during_update);
+
+    manager.SetParallelUpdate(2);
+    manager.UpdateAll(0.016f);
+    manager.SetParallelUpdate(0);
+
+    // The move is queued while worlds update and applied in the serial merge phase.
+    EXPECT_FALSE(moved_during_update);
+    EXPECT_FALSE(mir2::ecs::RegistryManager::InParallelPhase());
+    EXPECT_EQ(character_manager.TryGetMapId(kCharacterId).value_or(0), kMapId2);
+    auto moved_entity = character_manager.TryGet(kCharacterId);
+    ASSERT_TRUE(moved_entity.has_value());
+    const auto* state = world2->Registry().try_get<mir2::ecs::CharacterStateComponent>(
+        *moved_entity);
+    ASSERT_NE(state, nullptr);
+    EXPECT_EQ(state->position.x, 3);
+    EXPECT_EQ(state->position.y, 4);
+
+    world1->ClearSystems();
+}
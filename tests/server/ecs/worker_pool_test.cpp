@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ecs/worker_pool.h"
+
+TEST(WorkerPoolTest, RunsEveryTaskExactlyOnce) {
+    mir2::ecs::WorkerPool pool(3);
+    EXPECT_EQ(pool.ThreadCount(), 3u);
+
+    constexpr std::size_t kTasks = 100;
+    std::vector<std::atomic<int>> hits(kTasks);
+    pool.Run(kTasks, [&](std::size_t index) { hits[index].fetch_add(1); });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(WorkerPoolTest, RunCanBeRepeated) {
+    mir2::ecs::WorkerPool pool(2);
+    std::atomic<int> total{0};
+    for (int round = 0; round < 50; ++round) {
+        pool.Run(7, [&](std::size_t) { total.fetch_add(1); });
+    }
+    EXPECT_EQ(total.load(), 350);
+}
+
+TEST(WorkerPoolTest, EmptyRunReturnsImmediately) {
+    mir2::ecs::WorkerPool pool(2);
+    bool called = false;
+    pool.Run(0, [&](std::size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(WorkerPoolTest, CallerThreadParticipates) {
+    mir2::ecs::WorkerPool pool(0);
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> ran_on(4);
+    pool.Run(ran_on.size(), [&](std::size_t index) { ran_on[index] = std::this_thread::get_id(); });
+    for (const auto& id : ran_on) {
+        EXPECT_EQ(id, caller);
+    }
+}
+
+TEST(WorkerPoolTest, RethrowsTaskExceptionOnCaller) {
+    mir2::ecs::WorkerPool pool(2);
+    std::atomic<int> completed{0};
+    EXPECT_THROW(pool.Run(10,
+                          [&](std::size_t index) {
+                              if (index == 5) {
+                                  throw std::runtime_error("task failed");
+                              }
+                              completed.fetch_add(1);
+                          }),
+                 std::runtime_error);
+    EXPECT_EQ(completed.load(), 9);
+
+    // The pool stays usable after a failed run.
+    std::atomic<int> total{0};
+    pool.Run(4, [&](std::size_t) { total.fetch_add(1); });
+    EXPECT_EQ(total.load(), 4);
+}
@@ -2,6 +2,14 @@
 
 #include <entt/entt.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/timer.h"
+#include "ecs/worker_pool.h"
 #include "ecs/world.h"
 
 namespace {
@@ -33,6 +41,75 @@ class RecordingSystem : public mir2::ecs::System {
     float last_delta_ = 0.0f;
 };
 
+struct PositionTag {
+    int value = 0;
+};
+
+struct HealthTag {
+    int value = 0;
+};
+
+template <typename Component, bool kWrites>
+class TagSystem : public mir2::ecs::System {
+ public:
+    explicit TagSystem(mir2::ecs::SystemPriority priority) : mir2::ecs::System(priority) {
+        if constexpr (kWrites) {
+            Writes<Component>();
+        } else {
+            Reads<Component>();
+        }
+    }
+
+    void Update(entt::registry& registry, float /*delta_time*/) override {
+        update_count_.fetch_add(1);
+        if constexpr (kWrites) {
+            for (auto [entity, component] : registry.view<Component>().each()) {
+                (void)entity;
+                component.value += 1;
+            }
+        }
+    }
+
+    int update_count() const { return update_count_.load(); }
+
+ private:
+    std::atomic<int> update_count_{0};
+};
+
+class SlicedSystem : public mir2::ecs::System {
+ public:
+    SlicedSystem() : mir2::ecs::System(mir2::ecs::SystemPriority::kLevelUp) {
+        Reads<PositionTag>();
+        MarkDeferrable();
+    }
+
+    void Update(entt::registry& registry, float delta_time) override {
+        update_count_ += 1;
+        last_delta_ = delta_time;
+        ForEachInSlice<PositionTag>(registry, [this](entt::entity entity) {
+            visited_.push_back(entity);
+        });
+    }
+
+    int update_count() const { return update_count_; }
+    float last_delta() const { return last_delta_; }
+    const std::vector<entt::entity>& visited() const { return visited_; }
+
+ private:
+    int update_count_ = 0;
+    float last_delta_ = 0.0f;
+    std::vector<entt::entity> visited_;
+};
+
+void ExhaustBudget(mir2::core::TickBudget* budget) {
+    budget->Begin(std::chrono::microseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+using PositionReader = TagSystem<PositionTag, false>;
+using PositionWriter = TagSystem<PositionTag, true>;
+using HealthWriter = TagSystem<HealthTag, true>;
+
 }  // namespace
 
 TEST(WorldTest, CreateSystemAddsToCount) {
@@ -86,3 +163,148 @@ TEST(WorldTest, UpdatePassesDeltaTime) {
 
     EXPECT_FLOAT_EQ(system->last_delta(), 1.25f);
 }
+
+TEST(WorldTest, DisjointSystemsShareOneStage) {
+    mir2::ecs::World world;
+    world.ClearSystems();
+    world.CreateSystem<PositionWriter>(mir2::ecs::SystemPriority::kMovement);
+    world.CreateSystem<HealthWriter>(mir2::ecs::SystemPriority::kCombat);
+
+    const auto& stages = world.GetStages();
+
+    ASSERT_EQ(stages.size(), 1u);
+    EXPECT_EQ(stages[0].size(), 2u);
+}
+
+TEST(WorldTest, ConflictingSystemsKeepPriorityOrder) {
+    mir2::ecs::World world;
+    world.ClearSystems();
+    auto* writer = world.CreateSystem<PositionWriter>(mir2::ecs::SystemPriority::kCombat);
+    auto* reader = world.CreateSystem<PositionReader>(mir2::ecs::SystemPriority::kMovement);
+    auto* health = world.CreateSystem<HealthWriter>(mir2::ecs::SystemPriority::kLevelUp);
+
+    const auto& stages = world.GetStages();
+
+    // The reader runs first by priority; the writer waits for it, the
+    // unrelated health system joins the first stage.
+    ASSERT_EQ(stages.size(), 2u);
+    ASSERT_EQ(stages[0].size(), 2u);
+    EXPECT_EQ(stages[0][0], reader);
+    EXPECT_EQ(stages[0][1], health);
+    ASSERT_EQ(stages[1].size(), 1u);
+    EXPECT_EQ(stages[1][0], writer);
+}
+
+TEST(WorldTest, UndeclaredSystemRunsInItsOwnStage) {
+    mir2::ecs::World world;
+    world.ClearSystems();
+    world.CreateSystem<PositionWriter>(mir2::ecs::SystemPriority::kMovement);
+    auto* undeclared =
+        world.CreateSystem<RecordingSystem>(mir2::ecs::SystemPriority::kInventory, nullptr, 1);
+    world.CreateSystem<HealthWriter>(mir2::ecs::SystemPriority::kCombat);
+
+    const auto& stages = world.GetStages();
+
+    ASSERT_EQ(stages.size(), 3u);
+    ASSERT_EQ(stages[1].size(), 1u);
+    EXPECT_EQ(stages[1][0], undeclared);
+}
+
+TEST(WorldTest, JobPoolRunsEachSystemOncePerUpdate) {
+    mir2::ecs::WorkerPool pool(2);
+    mir2::ecs::World world;
+    world.SetJobPool(&pool);
+
+    auto& registry = world.Registry();
+    for (int i = 0; i < 100; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<PositionTag>(entity);
+        registry.emplace<HealthTag>(entity);
+    }
+
+    auto* position = world.CreateSystem<PositionWriter>(mir2::ecs::SystemPriority::kMovement);
+    auto* health = world.CreateSystem<HealthWriter>(mir2::ecs::SystemPriority::kCombat);
+    auto* reader = world.CreateSystem<PositionReader>(mir2::ecs::SystemPriority::kLevelUp);
+
+    world.Update(0.1f);
+    world.Update(0.1f);
+
+    EXPECT_EQ(position->update_count(), 2);
+    EXPECT_EQ(health->update_count(), 2);
+    EXPECT_EQ(reader->update_count(), 2);
+    for (auto [entity, tag] : registry.view<PositionTag>().each()) {
+        (void)entity;
+        EXPECT_EQ(tag.value, 2);
+    }
+    for (auto [entity, tag] : registry.view<HealthTag>().each()) {
+        (void)entity;
+        EXPECT_EQ(tag.value, 2);
+    }
+    world.SetJobPool(nullptr);
+}
+
+TEST(WorldTest, TimeSliceResumesWhereThePreviousTickStopped) {
+    mir2::ecs::World world;
+    world.ClearSystems();
+    world.SetTimeSlice(3);
+    auto* sliced = world.CreateSystem<SlicedSystem>();
+
+    auto& registry = world.Registry();
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 5; ++i) {
+        entities.push_back(registry.create());
+        registry.emplace<PositionTag>(entities.back());
+    }
+
+    world.Update(0.05f);
+    ASSERT_EQ(sliced->visited().size(), 3u);
+
+    world.Update(0.05f);
+    ASSERT_EQ(sliced->visited().size(), 6u);
+    // Two ticks cover all five entities before wrapping around.
+    for (auto entity : entities) {
+        EXPECT_NE(std::find(sliced->visited().begin(), sliced->visited().end(), entity),
+                  sliced->visited().end());
+    }
+}
+
+TEST(WorldTest, DeferrableSystemWaitsForBudgetAndCatchesUpDelta) {
+    mir2::core::TickBudget budget;
+    mir2::ecs::World world;
+    world.ClearSystems();
+    world.SetTickBudget(&budget);
+    auto* sliced = world.CreateSystem<SlicedSystem>();
+    auto* critical = world.CreateSystem<RecordingSystem>(mir2::ecs::SystemPriority::kMovement, nullptr, 1);
+
+    ExhaustBudget(&budget);
+    world.Update(0.05f);
+    world.Update(0.05f);
+
+    // Latency-critical systems always run; the deferrable one yields.
+    EXPECT_EQ(critical->update_count(), 2);
+    EXPECT_EQ(sliced->update_count(), 0);
+
+    budget.Begin(std::chrono::seconds(10));
+    world.Update(0.05f);
+    EXPECT_EQ(sliced->update_count(), 1);
+    EXPECT_NEAR(sliced->last_delta(), 0.15f, 1e-5f);
+    world.SetTickBudget(nullptr);
+}
+
+TEST(WorldTest, DeferrableSystemRunsAfterMaxDeferredTicks) {
+    mir2::core::TickBudget budget;
+    mir2::ecs::World world;
+    world.ClearSystems();
+    world.SetTickBudget(&budget);
+    auto* sliced = world.CreateSystem<SlicedSystem>();
+
+    ExhaustBudget(&budget);
+    for (std::size_t i = 0; i < mir2::ecs::World::kMaxDeferredTicks; ++i) {
+        world.Update(0.05f);
+    }
+    EXPECT_EQ(sliced->update_count(), 0);
+
+    world.Update(0.05f);
+    EXPECT_EQ(sliced->update_count(), 1);
+    world.SetTickBudget(nullptr);
+}
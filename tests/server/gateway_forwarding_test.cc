@@ -7,6 +7,7 @@
 
 #include "common/enums.h"
 #include "common/internal_message_helper.h"
+#include "common/routed_envelope.h"
 #include "network/packet_codec.h"
 #include "network/tcp_connection.h"
 #include "network/tcp_session.h"
@@ -51,6 +52,13 @@ ClientBundle CreateMockClient(asio::io_context& io_context) {
   return {std::move(client), socket_ptr};
 }
 
+std::unique_ptr<ServiceLinkPool> AdoptLinks(asio::io_context& io_context, common::ServiceType service,
+                                            std::unique_ptr<network::TcpClient> client) {
+  auto links = std::make_unique<ServiceLinkPool>(io_context, service);
+  links->AdoptLink(std::move(client));
+  return links;
+}
+
 void DrainIoContext(asio::io_context& io_context) {
   while (io_context.poll_one() > 0) {
   }
@@ -74,7 +82,8 @@ TEST(GatewayForwardingTest, ForwardMessageRequiresAuth_Unauthenticated_Rejected)
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kMoveReq),
                                        common::ServiceType::kGame, true);
   server.RegisterHandlers();
@@ -96,7 +105,8 @@ TEST(GatewayForwardingTest, ForwardMessageRequiresAuth_Authenticated_Allowed) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kMoveReq),
                                        common::ServiceType::kGame, true);
   server.RegisterHandlers();
@@ -114,13 +124,13 @@ TEST(GatewayForwardingTest, ForwardMessageRequiresAuth_Authenticated_Allowed) {
   ASSERT_EQ(writes.size(), 1u);
   network::Packet packet{};
   ASSERT_TRUE(DecodeSinglePacket(writes.front(), &packet));
-  EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage));
+  EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame));
 
-  common::RoutedMessageData routed;
-  ASSERT_TRUE(common::ParseRoutedMessage(packet.payload, &routed));
+  common::RoutedFrameView routed;
+  ASSERT_TRUE(common::PeelRoutedFrame(packet.payload, &routed));
   EXPECT_EQ(routed.client_id, 101u);
   EXPECT_EQ(routed.msg_id, static_cast<uint16_t>(common::MsgId::kMoveReq));
-  EXPECT_EQ(routed.payload, payload);
+  EXPECT_EQ(std::vector<uint8_t>(routed.payload.begin(), routed.payload.end()), payload);
 }
 
 TEST(GatewayForwardingTest, ForwardMessageNoAuthRequired_AlwaysAllowed) {
@@ -129,7 +139,8 @@ TEST(GatewayForwardingTest, ForwardMessageNoAuthRequired_AlwaysAllowed) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto db_client = CreateMockClient(io_context);
-  server.db_client_ = std::move(db_client.client);
+  server.db_links_ = AdoptLinks(io_context, common::ServiceType::kDb,
+                                std::move(db_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kLoginReq),
                                        common::ServiceType::kDb, false);
   server.RegisterHandlers();
@@ -152,7 +163,8 @@ TEST(GatewayForwardingTest, ForwardToUnknownService_DropsMessage) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
   server.RegisterHandlers();
 
   auto session = CreateSession(io_context, 103).session;
@@ -171,7 +183,8 @@ TEST(GatewayForwardingTest, ForwardToDisconnectedService_DropsMessage) {
 
   auto world_client = CreateMockClient(io_context);
   world_client.client->connected_.store(false);
-  server.world_client_ = std::move(world_client.client);
+  server.world_links_ = AdoptLinks(io_context, common::ServiceType::kWorld,
+                                   std::move(world_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kCreateRoleReq),
                                        common::ServiceType::kWorld, true);
   server.RegisterHandlers();
@@ -193,7 +206,8 @@ TEST(GatewayForwardingTest, ForwardWithInvalidMsgId_DropsMessage) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto db_client = CreateMockClient(io_context);
-  server.db_client_ = std::move(db_client.client);
+  server.db_links_ = AdoptLinks(io_context, common::ServiceType::kDb,
+                                std::move(db_client.client));
   server.RegisterHandlers();
 
   auto session = CreateSession(io_context, 105).session;
@@ -211,23 +225,26 @@ TEST(GatewayForwardingTest, IsServiceConnectedReturnsCorrectState) {
   GatewayServer server;
 
   auto world_client = CreateMockClient(io_context);
-  server.world_client_ = std::move(world_client.client);
+  server.world_links_ = AdoptLinks(io_context, common::ServiceType::kWorld,
+                                   std::move(world_client.client));
   EXPECT_TRUE(server.IsServiceConnected(common::ServiceType::kWorld));
 
-  server.world_client_->connected_.store(false);
+  server.world_links_->GetLink(0)->connected_.store(false);
   EXPECT_FALSE(server.IsServiceConnected(common::ServiceType::kWorld));
 }
 
-TEST(GatewayForwardingTest, GetServiceClientReturnsCorrectClient) {
+TEST(GatewayForwardingTest, GetServiceLinksReturnsCorrectPool) {
   asio::io_context io_context;
   GatewayServer server;
 
   auto db_client = CreateMockClient(io_context);
   auto* raw_ptr = db_client.client.get();
-  server.db_client_ = std::move(db_client.client);
+  server.db_links_ = AdoptLinks(io_context, common::ServiceType::kDb,
+                                std::move(db_client.client));
 
-  EXPECT_EQ(server.GetServiceClient(common::ServiceType::kDb), raw_ptr);
-  EXPECT_EQ(server.GetServiceClient(common::ServiceType::kWorld), nullptr);
+  ASSERT_NE(server.GetServiceLinks(common::ServiceType::kDb), nullptr);
+  EXPECT_EQ(server.GetServiceLinks(common::ServiceType::kDb)->GetLink(0), raw_ptr);
+  EXPECT_EQ(server.GetServiceLinks(common::ServiceType::kWorld), nullptr);
 }
 
 struct RouteParam {
@@ -245,9 +262,12 @@ TEST_P(GatewayRouteParamTest, ForwardRoutesToExpectedService) {
   auto world_client = CreateMockClient(io_context);
   auto game_client = CreateMockClient(io_context);
   auto db_client = CreateMockClient(io_context);
-  server.world_client_ = std::move(world_client.client);
-  server.game_client_ = std::move(game_client.client);
-  server.db_client_ = std::move(db_client.client);
+  server.world_links_ = AdoptLinks(io_context, common::ServiceType::kWorld,
+                                   std::move(world_client.client));
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
+  server.db_links_ = AdoptLinks(io_context, common::ServiceType::kDb,
+                                std::move(db_client.client));
 
   const auto param = GetParam();
   server.message_router_.RegisterRoute(param.msg_id, param.target, false);
@@ -7,6 +7,7 @@
 
 #include "common/enums.h"
 #include "common/internal_message_helper.h"
+#include "common/routed_envelope.h"
 #include "network/packet_codec.h"
 #include "network/tcp_connection.h"
 #include "network/tcp_session.h"
@@ -51,6 +52,13 @@ ClientBundle CreateMockClient(asio::io_context& io_context) {
   return {std::move(client), socket_ptr};
 }
 
+std::unique_ptr<ServiceLinkPool> AdoptLinks(asio::io_context& io_context, common::ServiceType service,
+                                            std::unique_ptr<network::TcpClient> client) {
+  auto links = std::make_unique<ServiceLinkPool>(io_context, service);
+  links->AdoptLink(std::move(client));
+  return links;
+}
+
 void DrainIoContext(asio::io_context& io_context) {
   while (io_context.poll_one() > 0) {
   }
@@ -70,8 +78,7 @@ void RegisterSession(network::NetworkManager* manager,
   if (!manager || !session) {
     return;
   }
-  std::lock_guard<std::mutex> lock(manager->mutex_);
-  manager->sessions_[session->GetSessionId()] = session;
+  manager->sessions_.Insert(session);
 }
 
 }  // namespace
@@ -83,7 +90,8 @@ TEST(GatewayFullFlowTest, ClientConnect_Login_RouteToDb_ReceiveResponse) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto db_client = CreateMockClient(io_context);
-  server.db_client_ = std::move(db_client.client);
+  server.db_links_ = AdoptLinks(io_context, common::ServiceType::kDb,
+                                std::move(db_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kLoginReq),
                                        common::ServiceType::kDb, false);
   server.RegisterHandlers();
@@ -101,19 +109,19 @@ TEST(GatewayFullFlowTest, ClientConnect_Login_RouteToDb_ReceiveResponse) {
   ASSERT_EQ(service_writes.size(), 1u);
   network::Packet routed_packet{};
   ASSERT_TRUE(DecodeSinglePacket(service_writes.front(), &routed_packet));
-  EXPECT_EQ(routed_packet.msg_id, static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage));
+  EXPECT_EQ(routed_packet.msg_id, static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame));
 
-  common::RoutedMessageData routed;
-  ASSERT_TRUE(common::ParseRoutedMessage(routed_packet.payload, &routed));
+  common::RoutedFrameView routed;
+  ASSERT_TRUE(common::PeelRoutedFrame(routed_packet.payload, &routed));
   EXPECT_EQ(routed.client_id, 1001u);
   EXPECT_EQ(routed.msg_id, static_cast<uint16_t>(common::MsgId::kLoginReq));
 
   const std::vector<uint8_t> login_rsp_payload{9, 9};
   const auto response_payload =
-      common::BuildRoutedMessage(1001u, static_cast<uint16_t>(common::MsgId::kLoginRsp),
-                                 login_rsp_payload);
-  network::Packet service_packet{
-      static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage), response_payload};
+      common::BuildRoutedFrame(1001u, static_cast<uint16_t>(common::MsgId::kLoginRsp),
+                               login_rsp_payload);
+  const network::PacketView service_packet{
+      static_cast<uint16_t>(common::InternalMsgId::kRoutedFrame), response_payload};
 
   server.OnServicePacket(common::ServiceType::kDb, service_packet);
   DrainIoContext(io_context);
@@ -132,7 +140,8 @@ TEST(GatewayFullFlowTest, AuthenticatedClient_MoveRequest_ForwardsToGame) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kMoveReq),
                                        common::ServiceType::kGame, true);
   server.RegisterHandlers();
@@ -154,7 +163,8 @@ TEST(GatewayFullFlowTest, UnauthenticatedClient_MoveRequest_Rejected) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
   server.message_router_.RegisterRoute(static_cast<uint16_t>(common::MsgId::kMoveReq),
                                        common::ServiceType::kGame, true);
   server.RegisterHandlers();
@@ -177,7 +187,8 @@ TEST(GatewayFullFlowTest, MultipleClients_IndependentRouting) {
   server.network_ = std::make_unique<network::NetworkManager>(io_context);
 
   auto world_client = CreateMockClient(io_context);
-  server.world_client_ = std::move(world_client.client);
+  server.world_links_ = AdoptLinks(io_context, common::ServiceType::kWorld,
+                                   std::move(world_client.client));
 
   auto session_a = CreateSession(io_context, 3001);
   auto session_b = CreateSession(io_context, 3002);
@@ -193,12 +204,13 @@ TEST(GatewayFullFlowTest, MultipleClients_IndependentRouting) {
       common::BuildRoutedMessage(3002u, static_cast<uint16_t>(common::MsgId::kChatRsp),
                                  payload_b);
 
+  // Legacy FlatBuffers RoutedMessage replies are still accepted.
   server.OnServicePacket(common::ServiceType::kWorld,
-                         network::Packet{
+                         network::PacketView{
                              static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage),
                              response_a});
   server.OnServicePacket(common::ServiceType::kWorld,
-                         network::Packet{
+                         network::PacketView{
                              static_cast<uint16_t>(common::InternalMsgId::kRoutedMessage),
                              response_b});
   DrainIoContext(io_context);
@@ -43,6 +43,13 @@ ClientBundle CreateMockClient(asio::io_context& io_context) {
   return {std::move(client)};
 }
 
+std::unique_ptr<ServiceLinkPool> AdoptLinks(asio::io_context& io_context, common::ServiceType service,
+                                            std::unique_ptr<network::TcpClient> client) {
+  auto links = std::make_unique<ServiceLinkPool>(io_context, service);
+  links->AdoptLink(std::move(client));
+  return links;
+}
+
 void DrainIoContext(asio::io_context& io_context) {
   while (io_context.poll_one() > 0) {
   }
@@ -86,7 +93,8 @@ TEST(GatewayPerformanceTest, MessageForwarding_ThroughputBaseline) {
   GatewayServer server;
 
   auto game_client = CreateMockClient(io_context);
-  server.game_client_ = std::move(game_client.client);
+  server.game_links_ = AdoptLinks(io_context, common::ServiceType::kGame,
+                                  std::move(game_client.client));
 
   constexpr int kMessages = 10000;
   const std::vector<uint8_t> payload{1, 2, 3, 4};
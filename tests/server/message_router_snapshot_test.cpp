@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/enums.h"
+#include "gateway/message_router.h"
+
+namespace mir2::gateway {
+
+class MessageRouterSnapshotTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    router_ = std::make_unique<MessageRouter>();
+  }
+
+  void TearDown() override {
+    router_.reset();
+  }
+
+  std::string CreateTempConfig(const std::string& content) {
+    const auto timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("message_router_test_" + std::to_string(timestamp) + ".yaml");
+    std::ofstream output(path);
+    output << content;
+    output.close();
+    return path.string();
+  }
+
+  std::unique_ptr<MessageRouter> router_;
+};
+
+TEST_F(MessageRouterSnapshotTest, LoadRoutesFromConfigPriority) {
+  const std::string config = R"(
+message_routes:
+  - msg_id: 1001
+    service: db
+    priority: critical
+  - msg_id: 2010
+    service: game
+    priority: low
+  - msg_id: 3001
+    service: game
+)";
+  const auto path = CreateTempConfig(config);
+
+  ASSERT_TRUE(router_->LoadRoutesFromConfig(path));
+  EXPECT_EQ(router_->GetPriority(1001), MessagePriority::kCritical);
+  EXPECT_EQ(router_->GetPriority(2010), MessagePriority::kLow);
+  EXPECT_EQ(router_->GetPriority(3001), MessagePriority::kNormal);
+  EXPECT_EQ(router_->GetPriority(9999), MessagePriority::kNormal);
+
+  std::filesystem::remove(path);
+}
+
+TEST_F(MessageRouterSnapshotTest, FailedReloadKeepsPreviousRoutes) {
+  router_->RegisterRoute(1001, common::ServiceType::kWorld, true);
+  const auto path = CreateTempConfig("message_routes:\n  - msg_id: [1001\n");
+
+  EXPECT_FALSE(router_->LoadRoutesFromConfig(path));
+  EXPECT_EQ(router_->GetRouteCount(), 1u);
+  const auto target = router_->GetRouteTarget(1001);
+  ASSERT_TRUE(target.has_value());
+  EXPECT_EQ(*target, common::ServiceType::kWorld);
+
+  std::filesystem::remove(path);
+}
+
+TEST_F(MessageRouterSnapshotTest, RegisterRouteOverwritesWithoutGrowingCount) {
+  router_->RegisterRoute(60011, common::ServiceType::kWorld, false);
+  router_->RegisterRoute(60011, common::ServiceType::kGame, true);
+
+  EXPECT_EQ(router_->GetRouteCount(), 1u);
+  const auto target = router_->GetRouteTarget(60011);
+  ASSERT_TRUE(target.has_value());
+  EXPECT_EQ(*target, common::ServiceType::kGame);
+  EXPECT_TRUE(router_->RequiresAuth(60011));
+}
+
+TEST_F(MessageRouterSnapshotTest, LookupReturnsWholeRoute) {
+  router_->RegisterRoute(2010, common::ServiceType::kGame, true, MessagePriority::kLow);
+
+  const auto route = router_->Lookup(2010);
+  ASSERT_TRUE(route.has_value());
+  EXPECT_EQ(route->msg_id, 2010);
+  EXPECT_EQ(route->target_service, common::ServiceType::kGame);
+  EXPECT_TRUE(route->require_auth);
+  EXPECT_EQ(route->priority, MessagePriority::kLow);
+  EXPECT_FALSE(router_->Lookup(2011).has_value());
+}
+
+TEST_F(MessageRouterSnapshotTest, RegisterRoutesAppliesBatch) {
+  router_->RegisterRoute(1001, common::ServiceType::kDb, false);
+  router_->RegisterRoutes({
+      {1001, common::ServiceType::kDb, false, MessagePriority::kCritical},
+      {2001, common::ServiceType::kWorld, true},
+      {3001, common::ServiceType::kGame, true, MessagePriority::kLow},
+  });
+
+  EXPECT_EQ(router_->GetRouteCount(), 3u);
+  EXPECT_EQ(router_->GetPriority(1001), MessagePriority::kCritical);
+  EXPECT_EQ(router_->GetRouteTarget(2001), common::ServiceType::kWorld);
+  EXPECT_TRUE(router_->RequiresAuth(3001));
+
+  router_->RegisterRoutes({});
+  EXPECT_EQ(router_->GetRouteCount(), 3u);
+}
+
+TEST_F(MessageRouterSnapshotTest, LookupSeesOneSnapshotWhileRouteChanges) {
+  const MessageRoute world_route{4001, common::ServiceType::kWorld, false, MessagePriority::kLow};
+  const MessageRoute game_route{4001, common::ServiceType::kGame, true, MessagePriority::kCritical};
+  router_->RegisterRoutes({world_route});
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([this, &stop]() {
+      while (!stop.load()) {
+        // Target, auth and priority always come from the same published route.
+        const auto route = router_->Lookup(4001);
+        ASSERT_TRUE(route.has_value());
+        const bool is_game = route->target_service == common::ServiceType::kGame;
+        EXPECT_EQ(route->require_auth, is_game);
+        EXPECT_EQ(route->priority,
+                  is_game ? MessagePriority::kCritical : MessagePriority::kLow);
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    router_->RegisterRoutes({i % 2 == 0 ? game_route : world_route});
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+TEST_F(MessageRouterSnapshotTest, LookupsDuringReloadSeeCompleteTables) {
+  const auto path = CreateTempConfig(R"(
+message_routes:
+  - msg_id: 1001
+    service: world
+  - msg_id: 3001
+    service: game
+    require_auth: true
+)");
+  router_->RegisterRoute(1001, common::ServiceType::kWorld, false);
+  router_->RegisterRoute(3001, common::ServiceType::kGame, true);
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([this, &stop]() {
+      while (!stop.load()) {
+        // Every published snapshot holds both routes, so a reader never sees a gap.
+        EXPECT_TRUE(router_->GetRouteTarget(1001).has_value());
+        EXPECT_TRUE(router_->RequiresAuth(3001));
+      }
+    });
+  }
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(router_->LoadRoutesFromConfig(path));
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_F(MessageRouterSnapshotTest, LookupsSurviveManyPublishes) {
+  router_->RegisterRoute(5001, common::ServiceType::kWorld, true);
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([this, &stop]() {
+      while (!stop.load()) {
+        // Replaced snapshots are kept alive, so a lookup never reads a freed table.
+        const auto route = router_->Lookup(5001);
+        ASSERT_TRUE(route.has_value());
+        EXPECT_TRUE(route->require_auth);
+      }
+    });
+  }
+  for (int i = 0; i < 2000; ++i) {
+    router_->RegisterRoute(5001, common::ServiceType::kWorld, true);
+    if (i % 100 == 0) {
+      std::this_thread::yield();
+    }
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(router_->GetRouteCount(), 1u);
+}
+
+}  // namespace mir2::gateway
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/mpsc_queue.h"
+
+namespace mir2::core {
+
+TEST(BoundedMpscQueueTest, CapacityRoundsUpToPowerOfTwo) {
+  BoundedMpscQueue<int> queue(100);
+  EXPECT_EQ(queue.Capacity(), 128u);
+}
+
+TEST(BoundedMpscQueueTest, PopsInPushOrder) {
+  BoundedMpscQueue<int> queue(8);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(queue.TryPush(int{i}));
+  }
+  EXPECT_EQ(queue.ApproxSize(), 5u);
+
+  int value = -1;
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(queue.TryPop(&value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(&value));
+  EXPECT_EQ(queue.ApproxSize(), 0u);
+}
+
+TEST(BoundedMpscQueueTest, RejectsPushWhenFull) {
+  BoundedMpscQueue<std::unique_ptr<int>> queue(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPush(std::make_unique<int>(i)));
+  }
+  auto overflow = std::make_unique<int>(99);
+  EXPECT_FALSE(queue.TryPush(std::move(overflow)));
+  // A rejected value is left with the caller.
+  ASSERT_NE(overflow, nullptr);
+  EXPECT_EQ(*overflow, 99);
+
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(queue.TryPop(&value));
+  EXPECT_EQ(*value, 0);
+  EXPECT_TRUE(queue.TryPush(std::move(overflow)));
+}
+
+TEST(BoundedMpscQueueTest, WrapsAroundManyTimes) {
+  BoundedMpscQueue<uint64_t> queue(4);
+  uint64_t value = 0;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(queue.TryPush(uint64_t{i}));
+    ASSERT_TRUE(queue.TryPop(&value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(BoundedMpscQueueTest, TryConsumeReusesSlotStorageAcrossWraps) {
+  BoundedMpscQueue<std::vector<uint8_t>> queue(2);
+  std::vector<const uint8_t*> buffers;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_TRUE(queue.TryPushWith([&](std::vector<uint8_t>& slot) {
+        slot.assign(64, static_cast<uint8_t>(round));
+      }));
+    }
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_TRUE(queue.TryConsume([&](std::vector<uint8_t>& slot) {
+        EXPECT_EQ(slot.size(), 64u);
+        EXPECT_EQ(slot.front(), static_cast<uint8_t>(round));
+        if (round == 0) {
+          buffers.push_back(slot.data());
+        } else {
+          // The slot keeps its allocation, so later rounds write into the same buffer.
+          EXPECT_EQ(slot.data(), buffers[static_cast<size_t>(i)]);
+        }
+        slot.clear();
+      }));
+    }
+  }
+  EXPECT_FALSE(queue.TryConsume([](std::vector<uint8_t>&) { FAIL(); }));
+}
+
+TEST(BoundedMpscQueueTest, TryConsumeReleasesSlotWhenConsumerThrows) {
+  BoundedMpscQueue<int> queue(2);
+  ASSERT_TRUE(queue.TryPushWith([](int& slot) { slot = 1; }));
+  ASSERT_TRUE(queue.TryPushWith([](int& slot) { slot = 2; }));
+  EXPECT_FALSE(queue.TryPushWith([](int&) { FAIL(); }));
+
+  EXPECT_THROW(queue.TryConsume([](int&) { throw std::runtime_error("handler failed"); }),
+               std::runtime_error);
+
+  // The throwing consume still handed the slot back and advanced past it.
+  EXPECT_TRUE(queue.TryPushWith([](int& slot) { slot = 3; }));
+  int value = 0;
+  ASSERT_TRUE(queue.TryConsume([&](int& slot) { value = slot; }));
+  EXPECT_EQ(value, 2);
+  ASSERT_TRUE(queue.TryConsume([&](int& slot) { value = slot; }));
+  EXPECT_EQ(value, 3);
+}
+
+TEST(BoundedMpscQueueTest, ConcurrentProducersKeepPerProducerOrder) {
+  constexpr int kProducers = 4;
+  constexpr uint64_t kPerProducer = 20000;
+  BoundedMpscQueue<uint64_t> queue(1024);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < kProducers; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (uint64_t seq = 0; seq < kPerProducer; ++seq) {
+        const uint64_t value = (static_cast<uint64_t>(producer) << 32) | seq;
+        while (!queue.TryPush(uint64_t{value})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint64_t> next_seq(kProducers, 0);
+  uint64_t received = 0;
+  uint64_t value = 0;
+  while (received < kProducers * kPerProducer) {
+    if (!queue.TryPop(&value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto producer = static_cast<size_t>(value >> 32);
+    ASSERT_LT(producer, next_seq.size());
+    EXPECT_EQ(value & 0xFFFFFFFFu, next_seq[producer]);
+    ++next_seq[producer];
+    ++received;
+  }
+  for (auto& thread : producers) {
+    thread.join();
+  }
+  for (uint64_t seq : next_seq) {
+    EXPECT_EQ(seq, kPerProducer);
+  }
+  EXPECT_FALSE(queue.TryPop(&value));
+}
+
+TEST(BoundedMpscQueueTest, ConcurrentInPlacePushAndConsume) {
+  constexpr int kProducers = 4;
+  constexpr uint64_t kPerProducer = 20000;
+  BoundedMpscQueue<std::vector<uint64_t>> queue(256);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < kProducers; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (uint64_t seq = 0; seq < kPerProducer; ++seq) {
+        const uint64_t value = (static_cast<uint64_t>(producer) << 32) | seq;
+        while (!queue.TryPushWith([value](std::vector<uint64_t>& slot) { slot.assign(4, value); })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint64_t> next_seq(kProducers, 0);
+  uint64_t received = 0;
+  while (received < kProducers * kPerProducer) {
+    const bool consumed = queue.TryConsume([&](std::vector<uint64_t>& slot) {
+      ASSERT_EQ(slot.size(), 4u);
+      const uint64_t value = slot.front();
+      EXPECT_EQ(slot.back(), value);
+      const auto producer = static_cast<size_t>(value >> 32);
+      ASSERT_LT(producer, next_seq.size());
+      EXPECT_EQ(value & 0xFFFFFFFFu, next_seq[producer]);
+      ++next_seq[producer];
+      slot.clear();
+    });
+    if (!consumed) {
+      std::this_thread::yield();
+      continue;
+    }
+    ++received;
+  }
+  for (auto& thread : producers) {
+    thread.join();
+  }
+  for (uint64_t seq : next_seq) {
+    EXPECT_EQ(seq, kPerProducer);
+  }
+}
+
+}  // namespace mir2::core
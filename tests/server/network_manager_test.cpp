@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include "network/network_manager.h"
+
+namespace mir2::network {
+
+namespace {
+
+bool WaitFor(const std::function<bool()>& predicate) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(NetworkManagerTest, SessionOpenedHandlerRunsOnceBeforeSessionStarts) {
+  asio::io_context io_context;
+  auto guard = asio::make_work_guard(io_context);
+  NetworkManager network(io_context);
+
+  std::atomic<int> opened{0};
+  std::atomic<bool> registered_before_start{false};
+  std::atomic<uint64_t> opened_id{0};
+  network.SetSessionOpenedHandler([&](const std::shared_ptr<TcpSession>& session) {
+    // The session is already looked up by id but has not started reading yet.
+    registered_before_start.store(network.GetSession(session->GetSessionId()) == session &&
+                                  session->GetState() == TcpSession::SessionState::kInit);
+    opened_id.store(session->GetSessionId());
+    opened.fetch_add(1);
+  });
+
+  ASSERT_TRUE(network.Start("127.0.0.1", 0, 4));
+  const uint16_t port = network.GetListenPort();
+  ASSERT_NE(port, 0);
+  std::thread io_thread([&io_context]() { io_context.run(); });
+
+  asio::io_context client_context;
+  asio::ip::tcp::socket client(client_context);
+  client.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+
+  ASSERT_TRUE(WaitFor([&]() { return opened.load() == 1; }));
+  EXPECT_TRUE(registered_before_start.load());
+  EXPECT_NE(opened_id.load(), 0u);
+  EXPECT_EQ(network.GetConnectionCount(), 1u);
+
+  client.close();
+  network.Stop();
+  guard.reset();
+  io_context.stop();
+  io_thread.join();
+  EXPECT_EQ(opened.load(), 1);
+}
+
+TEST(NetworkManagerTest, SessionClosedHandlerRunsAfterSessionIsRemoved) {
+  asio::io_context io_context;
+  auto guard = asio::make_work_guard(io_context);
+  NetworkManager network(io_context);
+
+  std::atomic<uint64_t> opened_id{0};
+  std::atomic<uint64_t> closed_id{0};
+  std::atomic<int> closed{0};
+  std::atomic<bool> removed_before_handler{false};
+  network.SetSessionOpenedHandler([&](const std::shared_ptr<TcpSession>& session) {
+    opened_id.store(session->GetSessionId());
+  });
+  network.SetSessionClosedHandler([&](const std::shared_ptr<TcpSession>& session) {
+    removed_before_handler.store(network.GetSession(session->GetSessionId()) == nullptr);
+    closed_id.store(session->GetSessionId());
+    closed.fetch_add(1);
+  });
+
+  ASSERT_TRUE(network.Start("127.0.0.1", 0, 4));
+  const uint16_t port = network.GetListenPort();
+  ASSERT_NE(port, 0);
+  std::thread io_thread([&io_context]() { io_context.run(); });
+
+  asio::io_context client_context;
+  asio::ip::tcp::socket client(client_context);
+  client.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+  ASSERT_TRUE(WaitFor([&]() { return opened_id.load() != 0; }));
+
+  // The peer hanging up closes the session on the server side.
+  client.close();
+  ASSERT_TRUE(WaitFor([&]() { return closed.load() == 1; }));
+  EXPECT_EQ(closed_id.load(), opened_id.load());
+  EXPECT_TRUE(removed_before_handler.load());
+
+  network.Stop();
+  guard.reset();
+  io_context.stop();
+  io_thread.join();
+  EXPECT_EQ(closed.load(), 1);
+}
+
+}  // namespace mir2::network
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "network/receive_buffer.h"
+
+namespace mir2::network {
+
+TEST(ReceiveBufferTest, AppendConsumeKeepsUnreadBytesContiguous) {
+  ReceiveBuffer buffer(16);
+  const std::vector<uint8_t> first{1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(buffer.Append(first.data(), first.size()));
+  buffer.Consume(4);
+  ASSERT_EQ(buffer.Size(), 2u);
+
+  // Needs compaction: only 10 bytes of tail room would otherwise remain after growth.
+  const std::vector<uint8_t> second{7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+  ASSERT_TRUE(buffer.Append(second.data(), second.size()));
+  ASSERT_EQ(buffer.Size(), 16u);
+  EXPECT_EQ(buffer.Data()[0], 5);
+  EXPECT_EQ(buffer.Data()[1], 6);
+  EXPECT_EQ(buffer.Data()[15], 20);
+}
+
+TEST(ReceiveBufferTest, AppendBeyondCapacityFailsWithoutModifying) {
+  ReceiveBuffer buffer(8);
+  const std::vector<uint8_t> data{1, 2, 3, 4, 5};
+  ASSERT_TRUE(buffer.Append(data.data(), data.size()));
+  EXPECT_FALSE(buffer.Append(data.data(), data.size()));
+  EXPECT_EQ(buffer.Size(), data.size());
+  EXPECT_EQ(buffer.Data()[4], 5);
+}
+
+TEST(ReceiveBufferTest, ConsumeAllResetsCursors) {
+  ReceiveBuffer buffer(8);
+  const std::vector<uint8_t> data{1, 2, 3, 4, 5, 6, 7, 8};
+  ASSERT_TRUE(buffer.Append(data.data(), data.size()));
+  buffer.Consume(data.size());
+  EXPECT_TRUE(buffer.Empty());
+  // Full capacity is available again without compaction.
+  EXPECT_TRUE(buffer.Append(data.data(), data.size()));
+  EXPECT_EQ(buffer.Size(), data.size());
+}
+
+}  // namespace mir2::network
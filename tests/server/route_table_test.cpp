@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <asio/io_context.hpp>
+
+#include "gateway/route_table.h"
+#include "mocks/mock_socket.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace mir2::gateway {
+
+namespace {
+
+std::shared_ptr<network::TcpSession> CreateSession(asio::io_context& io_context, uint64_t id) {
+  auto connection = std::make_shared<network::TcpConnection>(
+      std::make_unique<network::MockSocket>(io_context.get_executor()), id);
+  return std::make_shared<network::TcpSession>(connection);
+}
+
+}  // namespace
+
+TEST(RouteTableTest, InsertFindErase) {
+  asio::io_context io_context;
+  RouteTable table;
+  auto first = CreateSession(io_context, 1);
+  auto second = CreateSession(io_context, 1 + RouteTable::kShardCount);  // same shard as key 1
+
+  EXPECT_EQ(table.Insert(1, first), nullptr);
+  EXPECT_EQ(table.Insert(1 + RouteTable::kShardCount, second), nullptr);
+  EXPECT_EQ(table.Size(), 2u);
+  EXPECT_EQ(table.Find(1), first);
+  EXPECT_EQ(table.Find(1 + RouteTable::kShardCount), second);
+  EXPECT_EQ(table.Find(2), nullptr);
+
+  EXPECT_TRUE(table.Erase(1, first));
+  EXPECT_FALSE(table.Erase(1, first));
+  EXPECT_EQ(table.Find(1), nullptr);
+  EXPECT_EQ(table.Size(), 1u);
+}
+
+TEST(RouteTableTest, InsertReturnsReplacedSession) {
+  asio::io_context io_context;
+  RouteTable table;
+  auto original = CreateSession(io_context, 5);
+  auto replacement = CreateSession(io_context, 6);
+
+  EXPECT_EQ(table.Insert(100, original), nullptr);
+  EXPECT_EQ(table.Insert(100, replacement), original);
+  EXPECT_EQ(table.Size(), 1u);
+  EXPECT_EQ(table.Find(100), replacement);
+
+  // A stale owner cannot remove the route that replaced it.
+  EXPECT_FALSE(table.Erase(100, original));
+  EXPECT_EQ(table.Find(100), replacement);
+}
+
+TEST(RouteTableTest, EraseIfVisitsEveryShard) {
+  asio::io_context io_context;
+  RouteTable table;
+  std::vector<std::shared_ptr<network::TcpSession>> sessions;
+  for (uint64_t id = 1; id <= 200; ++id) {
+    sessions.push_back(CreateSession(io_context, id));
+    table.Insert(id, sessions.back());
+  }
+
+  const size_t erased = table.EraseIf(
+      [](uint64_t key, const std::shared_ptr<network::TcpSession>&) { return key % 2 == 0; });
+  EXPECT_EQ(erased, 100u);
+  EXPECT_EQ(table.Size(), 100u);
+  for (uint64_t id = 1; id <= 200; ++id) {
+    EXPECT_EQ(table.Find(id) != nullptr, id % 2 == 1);
+  }
+}
+
+TEST(RouteTableTest, ConcurrentLookupsDuringCleanup) {
+  asio::io_context io_context;
+  RouteTable table;
+  std::vector<std::shared_ptr<network::TcpSession>> sessions;
+  for (uint64_t id = 1; id <= 1000; ++id) {
+    sessions.push_back(CreateSession(io_context, id));
+    table.Insert(id, sessions.back());
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> misses{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        for (uint64_t id = 1; id <= 1000; ++id) {
+          if (!table.Find(id)) {
+            misses.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+  for (int round = 0; round < 50; ++round) {
+    table.EraseIf([](uint64_t, const std::shared_ptr<network::TcpSession>&) { return false; });
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(misses.load(), 0u);
+  EXPECT_EQ(table.Size(), 1000u);
+}
+
+TEST(SessionSlotsTest, StoreFindClear) {
+  asio::io_context io_context;
+  SessionSlots slots;
+  auto session = CreateSession(io_context, 42);
+
+  EXPECT_EQ(slots.Find(42), nullptr);
+  EXPECT_TRUE(slots.Store(42, session));
+  EXPECT_EQ(slots.Find(42), session);
+  // Same slot, different connection id: the cached session is not returned.
+  EXPECT_EQ(slots.Find(42 + SessionSlots::kSlotCount), nullptr);
+
+  slots.Clear(42, CreateSession(io_context, 42));
+  EXPECT_EQ(slots.Find(42), session);
+  slots.Clear(42, session);
+  EXPECT_EQ(slots.Find(42), nullptr);
+}
+
+TEST(SessionSlotsTest, CollisionKeepsLiveSessionAndReplacesClosedOne) {
+  asio::io_context io_context;
+  SessionSlots slots;
+  const uint64_t old_id = 7;
+  const uint64_t new_id = old_id + SessionSlots::kSlotCount;
+  auto old_session = CreateSession(io_context, old_id);
+  auto new_session = CreateSession(io_context, new_id);
+
+  ASSERT_TRUE(slots.Store(old_id, old_session));
+  EXPECT_FALSE(slots.Store(new_id, new_session));
+  EXPECT_EQ(slots.Find(old_id), old_session);
+  EXPECT_EQ(slots.Find(new_id), nullptr);
+
+  old_session->HandleDisconnect(old_id);
+  EXPECT_TRUE(slots.Store(new_id, new_session));
+  EXPECT_EQ(slots.Find(new_id), new_session);
+  EXPECT_EQ(slots.Find(old_id), nullptr);
+}
+
+}  // namespace mir2::gateway
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+
+#include <asio/io_context.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/enums.h"
+#include "mocks/mock_socket.h"
+#include "network/packet_codec.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+#include "server/common/routed_envelope.h"
+
+namespace mir2::common {
+
+namespace {
+
+std::vector<uint8_t> ToVector(std::span<const uint8_t> bytes) {
+  return std::vector<uint8_t>(bytes.begin(), bytes.end());
+}
+
+void DrainIoContext(asio::io_context& io_context) {
+  while (io_context.poll_one() > 0) {
+  }
+  io_context.restart();
+}
+
+}  // namespace
+
+TEST(RoutedEnvelopeTest, BuildAndPeelRoundTrip) {
+  const std::vector<uint8_t> payload{1, 2, 3, 4, 5};
+  const auto frame = BuildRoutedFrame(0x1122334455667788ULL, 1234, payload);
+  ASSERT_EQ(frame.size(), RoutedEnvelope::kSize + payload.size());
+
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(frame, &view));
+  EXPECT_EQ(view.client_id, 0x1122334455667788ULL);
+  EXPECT_EQ(view.msg_id, 1234);
+  EXPECT_EQ(ToVector(view.payload), payload);
+  // The payload view points into the frame; nothing is copied.
+  EXPECT_EQ(view.payload.data(), frame.data() + RoutedEnvelope::kSize);
+}
+
+TEST(RoutedEnvelopeTest, EmptyPayload) {
+  const auto frame = BuildRoutedFrame(7, 42, {});
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(frame, &view));
+  EXPECT_EQ(view.client_id, 7u);
+  EXPECT_TRUE(view.payload.empty());
+}
+
+TEST(RoutedEnvelopeTest, RejectsTruncatedOrMismatchedLength) {
+  const std::vector<uint8_t> payload{9, 9, 9};
+  auto frame = BuildRoutedFrame(7, 42, payload);
+  RoutedFrameView view;
+
+  EXPECT_FALSE(PeelRoutedFrame(std::span<const uint8_t>(frame.data(), RoutedEnvelope::kSize - 1),
+                               &view));
+  EXPECT_FALSE(PeelRoutedFrame(std::span<const uint8_t>(frame.data(), frame.size() - 1), &view));
+  frame.push_back(0);
+  EXPECT_FALSE(PeelRoutedFrame(frame, &view));
+}
+
+TEST(RoutedEnvelopeTest, SessionSendRoutedWritesFrameInOneBuffer) {
+  asio::io_context io_context;
+  auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+  auto* socket = mock_socket.get();
+  auto connection = std::make_shared<network::TcpConnection>(std::move(mock_socket), 1);
+  auto session = std::make_shared<network::TcpSession>(connection);
+  session->Start();
+
+  const std::vector<uint8_t> payload{4, 3, 2, 1};
+  session->SendRouted(5001, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  DrainIoContext(io_context);
+
+  ASSERT_EQ(socket->GetWrites().size(), 1u);
+  network::Packet packet;
+  ASSERT_EQ(network::PacketCodec::Decode(socket->GetWrites().front().data(),
+                                         socket->GetWrites().front().size(), &packet),
+            network::DecodeStatus::kOk);
+  EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(InternalMsgId::kRoutedFrame));
+  EXPECT_EQ(packet.payload, BuildRoutedFrame(5001, static_cast<uint16_t>(MsgId::kChatRsp), payload));
+}
+
+TEST(RoutedEnvelopeTest, SplitBatchYieldsFramesInOrder) {
+  std::vector<uint8_t> batch;
+  AppendRoutedFrame(&batch, 1, 10, std::vector<uint8_t>{1, 2, 3});
+  AppendRoutedFrame(&batch, 2, 20, {});
+  AppendRoutedFrame(&batch, 3, 30, std::vector<uint8_t>{4});
+
+  std::vector<std::span<const uint8_t>> frames;
+  ASSERT_TRUE(SplitRoutedBatch(batch, &frames));
+  ASSERT_EQ(frames.size(), 3u);
+  const uint64_t expected_clients[] = {1, 2, 3};
+  const uint16_t expected_msgs[] = {10, 20, 30};
+  for (size_t i = 0; i < frames.size(); ++i) {
+    RoutedFrameView view;
+    ASSERT_TRUE(PeelRoutedFrame(frames[i], &view));
+    EXPECT_EQ(view.client_id, expected_clients[i]);
+    EXPECT_EQ(view.msg_id, expected_msgs[i]);
+  }
+  EXPECT_TRUE(SplitRoutedBatch({}, &frames));
+  EXPECT_TRUE(frames.empty());
+}
+
+TEST(RoutedEnvelopeTest, SplitBatchRejectsTruncatedFrame) {
+  std::vector<uint8_t> batch;
+  AppendRoutedFrame(&batch, 1, 10, std::vector<uint8_t>{1, 2, 3});
+  AppendRoutedFrame(&batch, 2, 20, std::vector<uint8_t>{4, 5});
+
+  std::vector<std::span<const uint8_t>> frames;
+  EXPECT_FALSE(SplitRoutedBatch(std::span<const uint8_t>(batch.data(), batch.size() - 1), &frames));
+  EXPECT_FALSE(SplitRoutedBatch(std::span<const uint8_t>(batch.data(), batch.size() - 10), &frames));
+}
+
+TEST(RoutedEnvelopeTest, SessionBatchesRoutedFramesUntilFlush) {
+  asio::io_context io_context;
+  auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+  auto* socket = mock_socket.get();
+  auto connection = std::make_shared<network::TcpConnection>(std::move(mock_socket), 1);
+  auto session = std::make_shared<network::TcpSession>(connection);
+  session->SetRoutedBatchBytes(16 * 1024);
+  session->Start();
+
+  const std::vector<uint8_t> payload{7, 7};
+  for (uint64_t client_id = 1; client_id <= 4; ++client_id) {
+    session->SendRouted(client_id, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  }
+  DrainIoContext(io_context);
+  EXPECT_TRUE(socket->GetWrites().empty());
+
+  session->Flush();
+  DrainIoContext(io_context);
+  ASSERT_EQ(socket->GetWrites().size(), 1u);
+  network::Packet packet;
+  ASSERT_EQ(network::PacketCodec::Decode(socket->GetWrites().front().data(),
+                                         socket->GetWrites().front().size(), &packet),
+            network::DecodeStatus::kOk);
+  EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(InternalMsgId::kRoutedBatch));
+
+  std::vector<std::span<const uint8_t>> frames;
+  ASSERT_TRUE(SplitRoutedBatch(packet.payload, &frames));
+  ASSERT_EQ(frames.size(), 4u);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    RoutedFrameView view;
+    ASSERT_TRUE(PeelRoutedFrame(frames[i], &view));
+    EXPECT_EQ(view.client_id, i + 1);
+    EXPECT_EQ(ToVector(view.payload), payload);
+  }
+
+  // An empty batch writes nothing.
+  session->Flush();
+  DrainIoContext(io_context);
+  EXPECT_EQ(socket->GetWrites().size(), 1u);
+}
+
+TEST(RoutedEnvelopeTest, SessionBatchFlushesEarlyAtLimit) {
+  asio::io_context io_context;
+  auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+  auto* socket = mock_socket.get();
+  auto connection = std::make_shared<network::TcpConnection>(std::move(mock_socket), 1);
+  auto session = std::make_shared<network::TcpSession>(connection);
+  // Two 64-byte frames fill the batch.
+  session->SetRoutedBatchBytes(2 * (RoutedEnvelope::kSize + 48));
+  session->Start();
+
+  const std::vector<uint8_t> payload(48, 1);
+  session->SendRouted(1, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  DrainIoContext(io_context);
+  EXPECT_TRUE(socket->GetWrites().empty());
+  session->SendRouted(2, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  DrainIoContext(io_context);
+  EXPECT_EQ(socket->GetWrites().size(), 1u);
+}
+
+TEST(RoutedEnvelopeTest, MulticastRoundTrip) {
+  const std::vector<uint64_t> recipients{11, 22, 0x0102030405060708ULL};
+  const std::vector<uint8_t> payload{9, 8, 7};
+  std::vector<uint8_t> frame;
+  AppendRoutedMulticast(&frame, recipients, 321, payload);
+
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(frame, &view));
+  EXPECT_EQ(view.flags & kRoutedFlagMulticast, kRoutedFlagMulticast);
+
+  RoutedMulticastView multicast;
+  ASSERT_TRUE(PeelRoutedMulticast(view, &multicast));
+  EXPECT_EQ(multicast.msg_id, 321);
+  ASSERT_EQ(multicast.recipient_count, recipients.size());
+  for (size_t i = 0; i < recipients.size(); ++i) {
+    EXPECT_EQ(multicast.RecipientAt(i), recipients[i]);
+  }
+  EXPECT_EQ(ToVector(multicast.payload), payload);
+
+  // A unicast frame is not a multicast.
+  const auto unicast = BuildRoutedFrame(1, 321, payload);
+  ASSERT_TRUE(PeelRoutedFrame(unicast, &view));
+  EXPECT_FALSE(PeelRoutedMulticast(view, &multicast));
+}
+
+TEST(RoutedEnvelopeTest, MulticastRejectsRecipientOverflow) {
+  std::vector<uint8_t> frame;
+  AppendRoutedMulticast(&frame, std::vector<uint64_t>{1, 2}, 5, {});
+  // Claim more recipients than the body holds.
+  frame[RoutedEnvelope::kSize] = 3;
+
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(frame, &view));
+  RoutedMulticastView multicast;
+  EXPECT_FALSE(PeelRoutedMulticast(view, &multicast));
+}
+
+TEST(RoutedEnvelopeTest, SessionMulticastCarriesPayloadOnce) {
+  asio::io_context io_context;
+  auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+  auto* socket = mock_socket.get();
+  auto connection = std::make_shared<network::TcpConnection>(std::move(mock_socket), 1);
+  auto session = std::make_shared<network::TcpSession>(connection);
+  session->Start();
+
+  std::vector<uint64_t> recipients;
+  for (uint64_t client_id = 1; client_id <= 200; ++client_id) {
+    recipients.push_back(client_id);
+  }
+  const std::vector<uint8_t> payload(64, 0xAB);
+  session->SendRoutedMulticast(recipients, static_cast<uint16_t>(MsgId::kEntityMove), payload);
+  DrainIoContext(io_context);
+
+  ASSERT_EQ(socket->GetWrites().size(), 1u);
+  network::Packet packet;
+  ASSERT_EQ(network::PacketCodec::Decode(socket->GetWrites().front().data(),
+                                         socket->GetWrites().front().size(), &packet),
+            network::DecodeStatus::kOk);
+  EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(InternalMsgId::kRoutedFrame));
+  // Envelope + count header + ids + one copy of the payload.
+  EXPECT_EQ(packet.payload.size(),
+            RoutedEnvelope::kSize + 8 + recipients.size() * sizeof(uint64_t) + payload.size());
+
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(packet.payload, &view));
+  RoutedMulticastView multicast;
+  ASSERT_TRUE(PeelRoutedMulticast(view, &multicast));
+  EXPECT_EQ(multicast.recipient_count, recipients.size());
+  EXPECT_EQ(ToVector(multicast.payload), payload);
+}
+
+TEST(RoutedEnvelopeTest, BatchKeepsUnicastAndMulticastInOrder) {
+  asio::io_context io_context;
+  auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+  auto* socket = mock_socket.get();
+  auto connection = std::make_shared<network::TcpConnection>(std::move(mock_socket), 1);
+  auto session = std::make_shared<network::TcpSession>(connection);
+  session->SetRoutedBatchBytes(16 * 1024);
+  session->Start();
+
+  const std::vector<uint8_t> payload{1};
+  session->SendRouted(1, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  session->SendRoutedMulticast(std::vector<uint64_t>{1, 2}, static_cast<uint16_t>(MsgId::kEntityMove),
+                               payload);
+  session->SendRouted(2, static_cast<uint16_t>(MsgId::kChatRsp), payload);
+  session->Flush();
+  DrainIoContext(io_context);
+
+  ASSERT_EQ(socket->GetWrites().size(), 1u);
+  network::Packet packet;
+  ASSERT_EQ(network::PacketCodec::Decode(socket->GetWrites().front().data(),
+                                         socket->GetWrites().front().size(), &packet),
+            network::DecodeStatus::kOk);
+  std::vector<std::span<const uint8_t>> frames;
+  ASSERT_TRUE(SplitRoutedBatch(packet.payload, &frames));
+  ASSERT_EQ(frames.size(), 3u);
+  RoutedFrameView view;
+  ASSERT_TRUE(PeelRoutedFrame(frames[0], &view));
+  EXPECT_EQ(view.flags, 0);
+  ASSERT_TRUE(PeelRoutedFrame(frames[1], &view));
+  EXPECT_EQ(view.flags, kRoutedFlagMulticast);
+  ASSERT_TRUE(PeelRoutedFrame(frames[2], &view));
+  EXPECT_EQ(view.client_id, 2u);
+}
+
+}  // namespace mir2::common
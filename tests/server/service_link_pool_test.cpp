@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/enums.h"
+#include "network/packet_codec.h"
+#include "network/tcp_connection.h"
+#include "mocks/mock_socket.h"
+#include "server/common/routed_envelope.h"
+
+#define private public
+#include "gateway/service_link_pool.h"
+#include "network/tcp_client.h"
+#undef private
+
+namespace mir2::gateway {
+
+namespace {
+
+constexpr uint16_t kTestMsgId = 0x1234;
+
+struct PoolBundle {
+  std::unique_ptr<ServiceLinkPool> pool;
+  std::vector<network::MockSocket*> sockets;
+};
+
+PoolBundle CreatePool(asio::io_context& io_context, size_t link_count,
+                      size_t routed_batch_bytes = 0) {
+  PoolBundle bundle;
+  bundle.pool = std::make_unique<ServiceLinkPool>(io_context, common::ServiceType::kGame);
+  bundle.pool->SetRoutedBatchBytes(routed_batch_bytes);
+  for (size_t i = 0; i < link_count; ++i) {
+    auto client = std::make_unique<network::TcpClient>(io_context);
+    auto mock_socket = std::make_unique<network::MockSocket>(io_context.get_executor());
+    bundle.sockets.push_back(mock_socket.get());
+    client->connection_ =
+        std::make_shared<network::TcpConnection>(std::move(mock_socket), static_cast<uint64_t>(i + 1));
+    client->connected_.store(true);
+    bundle.pool->AdoptLink(std::move(client));
+  }
+  return bundle;
+}
+
+void DrainIoContext(asio::io_context& io_context) {
+  while (io_context.poll_one() > 0) {
+  }
+  io_context.restart();
+}
+
+// Every frame in these tests carries an empty payload, so frames have a fixed size.
+size_t CountFrames(const network::MockSocket* socket) {
+  const size_t frame_size = network::PacketCodec::Encode(kTestMsgId, nullptr, 0).size();
+  size_t bytes = 0;
+  for (const auto& write : socket->GetWrites()) {
+    bytes += write.size();
+  }
+  return bytes / frame_size;
+}
+
+}  // namespace
+
+TEST(ServiceLinkPoolTest, SelectLinkIsStablePerClient) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 4);
+
+  for (uint64_t client_id = 1; client_id <= 1000; ++client_id) {
+    const size_t link = bundle.pool->SelectLink(client_id);
+    EXPECT_LT(link, 4u);
+    EXPECT_EQ(bundle.pool->SelectLink(client_id), link);
+  }
+}
+
+TEST(ServiceLinkPoolTest, ClientsSpreadAcrossLinks) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 4);
+
+  std::vector<size_t> per_link(4, 0);
+  constexpr uint64_t kClients = 20000;
+  for (uint64_t client_id = 1; client_id <= kClients; ++client_id) {
+    ++per_link[bundle.pool->SelectLink(client_id)];
+  }
+  for (size_t count : per_link) {
+    // 64 virtual nodes per link keep each share well within +/-40% of even.
+    EXPECT_GT(count, kClients / 4 * 6 / 10);
+    EXPECT_LT(count, kClients / 4 * 14 / 10);
+  }
+}
+
+TEST(ServiceLinkPoolTest, SendUsesOwningLink) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 3);
+
+  const uint64_t client_id = 42;
+  const size_t owner = bundle.pool->SelectLink(client_id);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, std::vector<uint8_t>{}));
+  }
+  DrainIoContext(io_context);
+
+  for (size_t link = 0; link < bundle.sockets.size(); ++link) {
+    EXPECT_EQ(CountFrames(bundle.sockets[link]), link == owner ? 5u : 0u);
+  }
+}
+
+TEST(ServiceLinkPoolTest, DisconnectedLinkOnlyMovesItsOwnClients) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 4);
+
+  std::vector<size_t> owners;
+  for (uint64_t client_id = 1; client_id <= 2000; ++client_id) {
+    owners.push_back(bundle.pool->SelectLink(client_id));
+  }
+
+  constexpr size_t kDownLink = 2;
+  bundle.pool->GetLink(kDownLink)->connected_.store(false);
+
+  for (uint64_t client_id = 1; client_id <= 2000; ++client_id) {
+    const size_t owner = owners[client_id - 1];
+    if (owner == kDownLink) {
+      continue;
+    }
+    // Clients of healthy links keep their link and therefore their ordering.
+    EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, std::vector<uint8_t>{}));
+  }
+  DrainIoContext(io_context);
+  EXPECT_EQ(CountFrames(bundle.sockets[kDownLink]), 0u);
+  size_t delivered = 0;
+  for (size_t link = 0; link < bundle.sockets.size(); ++link) {
+    const size_t expected =
+        static_cast<size_t>(std::count(owners.begin(), owners.end(), link));
+    if (link != kDownLink) {
+      EXPECT_EQ(CountFrames(bundle.sockets[link]), expected);
+      delivered += expected;
+    }
+  }
+  EXPECT_GT(delivered, 0u);
+
+  // A client of the downed link fails over to a connected one.
+  const auto moved = std::find(owners.begin(), owners.end(), kDownLink);
+  ASSERT_NE(moved, owners.end());
+  EXPECT_TRUE(bundle.pool->Send(static_cast<uint64_t>(moved - owners.begin()) + 1, kTestMsgId,
+                                std::vector<uint8_t>{}));
+}
+
+TEST(ServiceLinkPoolTest, SendFailsWhenAllLinksDown) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 2);
+  for (size_t link = 0; link < bundle.pool->GetLinkCount(); ++link) {
+    bundle.pool->GetLink(link)->connected_.store(false);
+  }
+
+  EXPECT_FALSE(bundle.pool->IsConnected());
+  EXPECT_FALSE(bundle.pool->Send(7, kTestMsgId, std::vector<uint8_t>{}));
+}
+
+TEST(ServiceLinkPoolTest, RoutedFramesBatchPerLinkUntilFlush) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 2, 16 * 1024);
+
+  const std::vector<uint8_t> payload{1, 2, 3};
+  std::vector<size_t> frames_per_link(2, 0);
+  for (uint64_t client_id = 1; client_id <= 20; ++client_id) {
+    EXPECT_TRUE(bundle.pool->SendRouted(client_id, kTestMsgId, payload));
+    ++frames_per_link[bundle.pool->SelectLink(client_id)];
+  }
+  DrainIoContext(io_context);
+  for (const auto* socket : bundle.sockets) {
+    EXPECT_TRUE(socket->GetWrites().empty());
+  }
+
+  bundle.pool->Flush();
+  DrainIoContext(io_context);
+  for (size_t link = 0; link < bundle.sockets.size(); ++link) {
+    if (frames_per_link[link] == 0) {
+      EXPECT_TRUE(bundle.sockets[link]->GetWrites().empty());
+      continue;
+    }
+    ASSERT_EQ(bundle.sockets[link]->GetWrites().size(), 1u);
+    const auto& write = bundle.sockets[link]->GetWrites().front();
+    network::Packet packet;
+    ASSERT_EQ(network::PacketCodec::Decode(write.data(), write.size(), &packet),
+              network::DecodeStatus::kOk);
+    EXPECT_EQ(packet.msg_id, static_cast<uint16_t>(common::InternalMsgId::kRoutedBatch));
+    std::vector<std::span<const uint8_t>> frames;
+    ASSERT_TRUE(common::SplitRoutedBatch(packet.payload, &frames));
+    EXPECT_EQ(frames.size(), frames_per_link[link]);
+  }
+}
+
+TEST(ServiceLinkPoolTest, LoadFollowsQueuedBytesPerLink) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 2);
+  bundle.pool->SetOverloadLimits(1000, 0);
+
+  const uint64_t client_id = 42;
+  const size_t owner = bundle.pool->SelectLink(client_id);
+  uint64_t other_client = 1;
+  while (bundle.pool->SelectLink(other_client) == owner) {
+    ++other_client;
+  }
+
+  const std::vector<uint8_t> payload(600, 0xAB);
+  EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, payload));
+  bundle.pool->UpdateLoad(1000);
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kNormal);
+
+  EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, payload));
+  bundle.pool->UpdateLoad(1000);
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kBusy);
+  // Only clients hashed to the backed-up link see its load.
+  EXPECT_EQ(bundle.pool->GetLoad(other_client), LinkLoad::kNormal);
+
+  EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, payload));
+  EXPECT_TRUE(bundle.pool->Send(client_id, kTestMsgId, payload));
+  bundle.pool->UpdateLoad(1000);
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kOverloaded);
+
+  DrainIoContext(io_context);
+  bundle.pool->UpdateLoad(1000);
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kNormal);
+}
+
+TEST(ServiceLinkPoolTest, LoadFollowsFailoverLink) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 2);
+  bundle.pool->SetOverloadLimits(1000, 0);
+
+  const uint64_t client_id = 42;
+  const size_t owner = bundle.pool->SelectLink(client_id);
+  const size_t fallback = 1 - owner;
+  uint64_t fallback_client = 1;
+  while (bundle.pool->SelectLink(fallback_client) != fallback) {
+    ++fallback_client;
+  }
+
+  // Back up the fallback link, then take the owner down.
+  const std::vector<uint8_t> payload(1200, 0xAB);
+  EXPECT_TRUE(bundle.pool->Send(fallback_client, kTestMsgId, payload));
+  bundle.pool->UpdateLoad(1000);
+  ASSERT_EQ(bundle.pool->GetLoad(fallback_client), LinkLoad::kBusy);
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kNormal);
+
+  bundle.pool->GetLink(owner)->connected_.store(false);
+  // Admission sees the load of the link Send would actually use.
+  EXPECT_EQ(bundle.pool->GetLoad(client_id), LinkLoad::kBusy);
+  EXPECT_EQ(bundle.pool->PickLink(client_id), bundle.pool->GetLink(fallback));
+}
+
+TEST(ServiceLinkPoolTest, LoadFollowsBacklogAge) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 1);
+  bundle.pool->SetOverloadLimits(1 << 20, 100);
+
+  EXPECT_TRUE(bundle.pool->Send(7, kTestMsgId, std::vector<uint8_t>{}));
+  bundle.pool->UpdateLoad(1000);
+  EXPECT_EQ(bundle.pool->GetLoad(7), LinkLoad::kNormal);
+  bundle.pool->UpdateLoad(1100);
+  EXPECT_EQ(bundle.pool->GetLoad(7), LinkLoad::kBusy);
+  bundle.pool->UpdateLoad(1200);
+  EXPECT_EQ(bundle.pool->GetLoad(7), LinkLoad::kOverloaded);
+
+  DrainIoContext(io_context);
+  bundle.pool->UpdateLoad(1300);
+  EXPECT_EQ(bundle.pool->GetLoad(7), LinkLoad::kNormal);
+}
+
+TEST(ServiceLinkPoolTest, LoadStaysNormalWhenOverloadDisabled) {
+  asio::io_context io_context;
+  auto bundle = CreatePool(io_context, 1);
+
+  const std::vector<uint8_t> payload(4096, 0xCD);
+  EXPECT_TRUE(bundle.pool->Send(7, kTestMsgId, payload));
+  bundle.pool->UpdateLoad(1000);
+  bundle.pool->UpdateLoad(60000);
+  EXPECT_EQ(bundle.pool->GetLoad(7), LinkLoad::kNormal);
+}
+
+}  // namespace mir2::gateway
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <asio/io_context.hpp>
+
+#include "mocks/mock_socket.h"
+#include "network/session_registry.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace mir2::network {
+
+namespace {
+
+std::shared_ptr<TcpSession> CreateSession(asio::io_context& io_context, uint64_t id) {
+  auto connection = std::make_shared<TcpConnection>(
+      std::make_unique<MockSocket>(io_context.get_executor()), id);
+  return std::make_shared<TcpSession>(connection);
+}
+
+}  // namespace
+
+TEST(SessionRegistryTest, InsertFindErase) {
+  asio::io_context io_context;
+  SessionRegistry registry;
+  auto first = CreateSession(io_context, 1);
+  auto second = CreateSession(io_context, 1 + SessionRegistry::kShardCount);  // same shard as id 1
+
+  registry.Insert(first);
+  registry.Insert(second);
+  EXPECT_EQ(registry.Size(), 2u);
+  EXPECT_EQ(registry.Find(1), first);
+  EXPECT_EQ(registry.Find(1 + SessionRegistry::kShardCount), second);
+  EXPECT_EQ(registry.Find(2), nullptr);
+
+  EXPECT_TRUE(registry.Erase(1));
+  EXPECT_FALSE(registry.Erase(1));
+  EXPECT_EQ(registry.Find(1), nullptr);
+  EXPECT_EQ(registry.Find(1 + SessionRegistry::kShardCount), second);
+  EXPECT_EQ(registry.Size(), 1u);
+}
+
+TEST(SessionRegistryTest, InsertReplacesExistingId) {
+  asio::io_context io_context;
+  SessionRegistry registry;
+  auto original = CreateSession(io_context, 5);
+  auto replacement = CreateSession(io_context, 5);
+
+  registry.Insert(original);
+  registry.Insert(replacement);
+  EXPECT_EQ(registry.Size(), 1u);
+  EXPECT_EQ(registry.Find(5), replacement);
+}
+
+TEST(SessionRegistryTest, ForEachVisitsEveryShard) {
+  asio::io_context io_context;
+  SessionRegistry registry;
+  for (uint64_t id = 1; id <= 100; ++id) {
+    registry.Insert(CreateSession(io_context, id));
+  }
+
+  uint64_t id_sum = 0;
+  size_t visited = 0;
+  registry.ForEach([&](const std::shared_ptr<TcpSession>& session) {
+    id_sum += session->GetSessionId();
+    ++visited;
+  });
+  EXPECT_EQ(visited, 100u);
+  EXPECT_EQ(id_sum, 5050u);
+
+  // Snapshot can be mutated against freely.
+  for (const auto& session : registry.Snapshot()) {
+    registry.Erase(session->GetSessionId());
+  }
+  EXPECT_EQ(registry.Size(), 0u);
+}
+
+TEST(SessionRegistryTest, ConcurrentLookupsDuringChurn) {
+  asio::io_context io_context;
+  SessionRegistry registry;
+  std::vector<std::shared_ptr<TcpSession>> stable;
+  for (uint64_t id = 1; id <= 32; ++id) {
+    stable.push_back(CreateSession(io_context, id));
+    registry.Insert(stable.back());
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> misses{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&]() {
+      while (!stop.load()) {
+        for (uint64_t id = 1; id <= 32; ++id) {
+          if (!registry.Find(id)) {
+            misses.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+
+  for (uint64_t id = 1000; id < 3000; ++id) {
+    registry.Insert(CreateSession(io_context, id));
+    registry.Erase(id);
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(misses.load(), 0u);
+  EXPECT_EQ(registry.Size(), 32u);
+}
+
+}  // namespace mir2::network
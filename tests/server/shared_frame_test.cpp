@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <asio/io_context.hpp>
+
+#include "mocks/mock_socket.h"
+#include "network/packet_codec.h"
+#include "network/shared_frame.h"
+#include "network/tcp_connection.h"
+#include "network/tcp_session.h"
+
+namespace mir2::network {
+
+namespace {
+
+std::vector<uint8_t> BuildPayload(size_t size) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>((i * 31) & 0xFF);
+  }
+  return payload;
+}
+
+std::vector<uint8_t> Concat(const std::array<uint8_t, PacketHeaderV2::kSize>& header,
+                            const SharedFrame& frame) {
+  std::vector<uint8_t> bytes(header.begin(), header.end());
+  bytes.insert(bytes.end(), frame.GetPayload(), frame.GetPayload() + frame.GetPayloadSize());
+  return bytes;
+}
+
+}  // namespace
+
+TEST(SharedFrameTest, V1BytesMatchEncode) {
+  const auto payload = BuildPayload(200);
+  const auto frame = SharedFrame::Create(42, payload);
+  ASSERT_TRUE(frame->IsValid());
+  EXPECT_EQ(*frame->GetBytes(), PacketCodec::Encode(42, payload.data(), payload.size()));
+}
+
+TEST(SharedFrameTest, V2HeaderMatchesEncodeV2) {
+  for (const size_t size : {size_t{0}, size_t{1}, size_t{17}, size_t{1500}, size_t{65536}}) {
+    const auto payload = BuildPayload(size);
+    const auto frame = SharedFrame::Create(77, payload);
+    ASSERT_TRUE(frame->IsValid());
+    for (const uint16_t sequence : {uint16_t{0}, uint16_t{1}, uint16_t{0xBEEF}, uint16_t{0xFFFF}}) {
+      const auto expected = PacketCodec::EncodeV2(77, payload.data(), payload.size(), sequence);
+      EXPECT_EQ(Concat(frame->BuildHeaderV2(sequence), *frame), expected)
+          << "size=" << size << " sequence=" << sequence;
+    }
+  }
+}
+
+TEST(SharedFrameTest, OversizedPayloadIsInvalid) {
+  const auto payload = BuildPayload(mir2::common::kMaxPayloadSize + 1);
+  const auto frame = SharedFrame::Create(1, payload);
+  EXPECT_FALSE(frame->IsValid());
+  EXPECT_EQ(frame->GetPayloadSize(), 0u);
+}
+
+TEST(SharedFrameTest, SessionsShareFrameAndKeepOwnSequence) {
+  asio::io_context io_context;
+  auto v1_socket = std::make_unique<MockSocket>(io_context.get_executor());
+  auto v2_socket = std::make_unique<MockSocket>(io_context.get_executor());
+  MockSocket* v1_mock = v1_socket.get();
+  MockSocket* v2_mock = v2_socket.get();
+  auto v1_session = std::make_shared<TcpSession>(
+      std::make_shared<TcpConnection>(std::move(v1_socket), 1));
+  auto v2_session = std::make_shared<TcpSession>(
+      std::make_shared<TcpConnection>(std::move(v2_socket), 2));
+  v2_session->SetProtocolVersion(ProtocolVersion::kV2);
+  v1_session->Start();
+  v2_session->Start();
+
+  // Advance the V2 session's sequence so the shared frame must patch a non-zero value.
+  const std::vector<uint8_t> warmup{0x01};
+  v2_session->Send(5, warmup);
+
+  const auto payload = BuildPayload(64);
+  const auto frame = SharedFrame::Create(100, payload);
+  v1_session->SendFrame(frame);
+  v2_session->SendFrame(frame);
+  io_context.run();
+
+  ASSERT_EQ(v1_mock->GetWrites().size(), 1u);
+  EXPECT_EQ(v1_mock->GetWrites().front(), PacketCodec::Encode(100, payload.data(), payload.size()));
+
+  // Both sends land in the same coalesced write.
+  auto expected = PacketCodec::EncodeV2(5, warmup.data(), warmup.size(), 0);
+  const auto framed = PacketCodec::EncodeV2(100, payload.data(), payload.size(), 1);
+  expected.insert(expected.end(), framed.begin(), framed.end());
+  ASSERT_EQ(v2_mock->GetWrites().size(), 1u);
+  EXPECT_EQ(v2_mock->GetWrites().front(), expected);
+}
+
+}  // namespace mir2::network
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include <asio/error.hpp>
 #include <asio/io_context.hpp>
 
+#include "common/protocol/payload_compression.h"
 #include "mocks/mock_socket.h"
 #include "network/packet_codec.h"
 #include "network/tcp_connection.h"
@@ -21,6 +24,20 @@ std::shared_ptr<TcpConnection> CreateConnection(asio::io_context& io_context,
   return std::make_shared<TcpConnection>(std::move(mock_socket), 1);
 }
 
+PooledBuffer MakeBuffer(size_t size, uint8_t fill) {
+  auto buffer = BufferPool::Acquire(size);
+  std::fill(buffer.Data(), buffer.Data() + size, fill);
+  return buffer;
+}
+
+size_t TotalWritten(const MockSocket& socket) {
+  size_t total = 0;
+  for (const auto& write : socket.GetWrites()) {
+    total += write.size();
+  }
+  return total;
+}
+
 }  // namespace
 
 TEST(TcpConnectionTest, ReadV1PacketTriggersHandler) {
@@ -39,10 +56,10 @@ TEST(TcpConnectionTest, ReadV1PacketTriggersHandler) {
   Packet received{};
   bool called = false;
   session->SetMessageHandler([&](const std::shared_ptr<TcpSession>& active_session,
-                                 const Packet& packet) {
+                                 const PacketView& packet) {
     ASSERT_TRUE(active_session);
     EXPECT_EQ(active_session->GetSessionId(), 1u);
-    received = packet;
+    received = packet.ToOwned();
     called = true;
   });
 
@@ -75,10 +92,10 @@ TEST(TcpConnectionTest, ReadV2PacketTriggersHandler) {
   Packet received{};
   bool called = false;
   session->SetMessageHandler([&](const std::shared_ptr<TcpSession>& active_session,
-                                 const Packet& packet) {
+                                 const PacketView& packet) {
     ASSERT_TRUE(active_session);
     EXPECT_EQ(active_session->GetSessionId(), 1u);
-    received = packet;
+    received = packet.ToOwned();
     called = true;
   });
 
@@ -95,6 +112,47 @@ TEST(TcpConnectionTest, ReadV2PacketTriggersHandler) {
   EXPECT_EQ(received.payload, payload);
 }
 
+TEST(TcpConnectionTest, PipelinedPacketsSplitAcrossReadsAreDelivered) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  auto session = std::make_shared<TcpSession>(connection);
+  std::weak_ptr<TcpSession> weak_session = session;
+
+  connection->SetReadHandler([weak_session](const uint8_t* data, size_t size) {
+    if (auto locked = weak_session.lock()) {
+      locked->HandleBytes(data, size);
+    }
+  });
+
+  std::vector<Packet> received;
+  session->SetMessageHandler([&](const std::shared_ptr<TcpSession>&, const PacketView& packet) {
+    received.push_back(packet.ToOwned());
+  });
+
+  session->Start();
+
+  std::vector<uint8_t> stream;
+  for (uint8_t i = 0; i < 20; ++i) {
+    std::vector<uint8_t> payload(i, i);
+    const auto encoded = PacketCodec::Encode(i, payload.data(), payload.size());
+    stream.insert(stream.end(), encoded.begin(), encoded.end());
+  }
+  // Odd-sized chunks so headers and payloads straddle read boundaries.
+  for (size_t offset = 0; offset < stream.size(); offset += 7) {
+    const size_t end = std::min(stream.size(), offset + 7);
+    mock_socket->PushReadData(std::vector<uint8_t>(stream.begin() + offset, stream.begin() + end));
+  }
+
+  io_context.run();
+
+  ASSERT_EQ(received.size(), 20u);
+  for (uint8_t i = 0; i < 20; ++i) {
+    EXPECT_EQ(received[i].msg_id, i);
+    EXPECT_EQ(received[i].payload, std::vector<uint8_t>(i, i));
+  }
+}
+
 TEST(TcpConnectionTest, SendWritesEncodedPacket) {
   asio::io_context io_context;
   MockSocket* mock_socket = nullptr;
@@ -113,6 +171,140 @@ TEST(TcpConnectionTest, SendWritesEncodedPacket) {
   EXPECT_EQ(writes.front(), expected);
 }
 
+TEST(TcpConnectionTest, BurstSendsCoalesceIntoSingleWrite) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  auto session = std::make_shared<TcpSession>(connection);
+
+  session->Start();
+
+  std::vector<uint8_t> expected;
+  for (uint8_t i = 0; i < 40; ++i) {
+    std::vector<uint8_t> payload{i, static_cast<uint8_t>(i + 1)};
+    session->Send(200, payload);
+    const auto encoded = PacketCodec::Encode(200, payload.data(), payload.size());
+    expected.insert(expected.end(), encoded.begin(), encoded.end());
+  }
+  io_context.run();
+
+  const auto& writes = mock_socket->GetWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(writes.front(), expected);
+}
+
+TEST(TcpConnectionTest, CorkedSendsWaitForFlush) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  SendPolicy policy;
+  policy.cork = true;
+  connection->ApplySendPolicy(policy);
+  auto session = std::make_shared<TcpSession>(connection);
+  session->Start();
+
+  std::vector<uint8_t> expected;
+  for (uint8_t i = 0; i < 5; ++i) {
+    std::vector<uint8_t> payload{i};
+    session->Send(201, payload);
+    const auto encoded = PacketCodec::Encode(201, payload.data(), payload.size());
+    expected.insert(expected.end(), encoded.begin(), encoded.end());
+  }
+  io_context.run();
+  EXPECT_TRUE(mock_socket->GetWrites().empty());
+
+  session->Flush();
+  io_context.restart();
+  io_context.run();
+  ASSERT_EQ(mock_socket->GetWrites().size(), 1u);
+  EXPECT_EQ(mock_socket->GetWrites().front(), expected);
+}
+
+TEST(TcpConnectionTest, CorkByteThresholdFlushesEarly) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  SendPolicy policy;
+  policy.cork = true;
+  policy.cork_bytes = 100;
+  connection->ApplySendPolicy(policy);
+
+  const std::vector<uint8_t> frame(60, 0x11);
+  connection->SendRaw(frame);
+  io_context.run();
+  EXPECT_TRUE(mock_socket->GetWrites().empty());
+
+  connection->SendRaw(frame);
+  io_context.restart();
+  io_context.run();
+  ASSERT_EQ(mock_socket->GetWrites().size(), 1u);
+  EXPECT_EQ(mock_socket->GetWrites().front().size(), 120u);
+}
+
+TEST(TcpConnectionTest, SendPolicyControlsNoDelay) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  SendPolicy policy;
+  connection->ApplySendPolicy(policy);
+  EXPECT_TRUE(mock_socket->NoDelay());
+
+  policy.tcp_nodelay = false;
+  connection->ApplySendPolicy(policy);
+  EXPECT_FALSE(mock_socket->NoDelay());
+}
+
+TEST(TcpConnectionTest, CoalescedWriteRespectsBatchBudget) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  const std::vector<uint8_t> chunk(40 * 1024, 0xAB);
+  for (int i = 0; i < 3; ++i) {
+    connection->SendRaw(chunk);
+  }
+  io_context.run();
+
+  const auto& writes = mock_socket->GetWrites();
+  ASSERT_EQ(writes.size(), 3u);
+  for (const auto& write : writes) {
+    EXPECT_EQ(write.size(), chunk.size());
+  }
+  EXPECT_FALSE(mock_socket->IsClosed());
+}
+
+TEST(TcpConnectionTest, WriteQueueOverHighWaterMarkCloses) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  bool disconnected = false;
+  connection->SetDisconnectHandler([&](uint64_t) { disconnected = true; });
+
+  const std::vector<uint8_t> chunk(256 * 1024, 0xCD);
+  for (int i = 0; i < 5; ++i) {
+    connection->SendRaw(chunk);
+  }
+  io_context.run();
+
+  EXPECT_TRUE(disconnected);
+  EXPECT_TRUE(mock_socket->IsClosed());
+}
+
+TEST(TcpConnectionTest, SingleOversizedFrameStillSent) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  const std::vector<uint8_t> large(2 * 1024 * 1024, 0xEF);
+  connection->SendRaw(large);
+  io_context.run();
+
+  ASSERT_EQ(mock_socket->GetWrites().size(), 1u);
+  EXPECT_EQ(mock_socket->GetWrites().front().size(), large.size());
+  EXPECT_FALSE(mock_socket->IsClosed());
+}
+
 TEST(TcpConnectionTest, ReadErrorTriggersDisconnect) {
   asio::io_context io_context;
   MockSocket* mock_socket = nullptr;
@@ -164,4 +356,161 @@ TEST(TcpConnectionTest, RateLimitExceededMarksSessionLimited) {
   EXPECT_NE(session->GetState(), TcpSession::SessionState::kActive);
 }
 
+TEST(TcpConnectionTest, CompressionNegotiatedByPeerFlag) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  auto session = std::make_shared<TcpSession>(connection);
+  std::weak_ptr<TcpSession> weak_session = session;
+  connection->SetReadHandler([weak_session](const uint8_t* data, size_t size) {
+    if (auto locked = weak_session.lock()) {
+      locked->HandleBytes(data, size);
+    }
+  });
+
+  std::vector<Packet> received;
+  session->SetMessageHandler([&](const std::shared_ptr<TcpSession>&, const PacketView& packet) {
+    received.push_back(packet.ToOwned());
+  });
+  session->SetProtocolVersion(ProtocolVersion::kV2);
+  session->SetCompressionThreshold(64);
+  session->Start();
+
+  // Large but compressible payload; sent uncompressed until the peer advertises support.
+  const std::vector<uint8_t> large(1024, 0x42);
+  session->Send(7, large);
+  io_context.run();
+  ASSERT_EQ(mock_socket->GetWrites().size(), 1u);
+  EXPECT_EQ(mock_socket->GetWrites()[0],
+            PacketCodec::EncodeV2(7, large.data(), large.size(), 0, 0x04));
+
+  // The peer advertises support and sends a compressed packet of its own.
+  std::vector<uint8_t> compressed;
+  ASSERT_TRUE(mir2::common::CompressPayload(large.data(), large.size(), &compressed));
+  mock_socket->PushReadData(
+      PacketCodec::EncodeV2(9, compressed.data(), compressed.size(), 0, 0x02 | 0x04));
+  io_context.restart();
+  io_context.run();
+  EXPECT_TRUE(session->PeerAcceptsCompression());
+  ASSERT_EQ(received.size(), 1u);
+  EXPECT_EQ(received[0].msg_id, 9u);
+  EXPECT_EQ(received[0].payload, large);
+
+  session->Send(7, large);
+  io_context.restart();
+  io_context.run();
+  ASSERT_EQ(mock_socket->GetWrites().size(), 2u);
+  const auto& write = mock_socket->GetWrites()[1];
+  EXPECT_LT(write.size(), large.size());
+
+  Packet decoded{};
+  uint8_t flags = 0;
+  ASSERT_EQ(PacketCodec::DecodeV2(write.data(), write.size(), &decoded, nullptr, &flags),
+            DecodeStatus::kOk);
+  EXPECT_EQ(flags, 0x02 | 0x04);
+  std::vector<uint8_t> restored;
+  ASSERT_TRUE(mir2::common::DecompressPayload(decoded.payload, &restored));
+  EXPECT_EQ(restored, large);
+}
+
+TEST(TcpConnectionTest, CompressedPacketRejectedWhenDisabled) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+  auto session = std::make_shared<TcpSession>(connection);
+  std::weak_ptr<TcpSession> weak_session = session;
+  connection->SetReadHandler([weak_session](const uint8_t* data, size_t size) {
+    if (auto locked = weak_session.lock()) {
+      locked->HandleBytes(data, size);
+    }
+  });
+
+  bool called = false;
+  session->SetMessageHandler(
+      [&](const std::shared_ptr<TcpSession>&, const PacketView&) { called = true; });
+  session->Start();
+
+  const std::vector<uint8_t> large(512, 0x11);
+  std::vector<uint8_t> compressed;
+  ASSERT_TRUE(mir2::common::CompressPayload(large.data(), large.size(), &compressed));
+  mock_socket->PushReadData(
+      PacketCodec::EncodeV2(9, compressed.data(), compressed.size(), 0, 0x02));
+  io_context.run();
+
+  EXPECT_FALSE(called);
+  EXPECT_TRUE(mock_socket->IsClosed());
+}
+
+TEST(TcpConnectionTest, ReplaceableStateKeepsOnlyLatestUnsent) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  connection->SendBuffer(MakeBuffer(4, 0xA1));
+  connection->SendBuffer(MakeBuffer(4, 0x01), 7);
+  connection->SendBuffer(MakeBuffer(4, 0xB2));
+  connection->SendBuffer(MakeBuffer(4, 0x02), 7);
+  connection->SendBuffer(MakeBuffer(4, 0x31), 8);
+  io_context.run();
+
+  // The stale update for key 7 is dropped; the newer one goes after the reliable message.
+  std::vector<uint8_t> expected;
+  for (const uint8_t fill : {0xA1, 0xB2, 0x02, 0x31}) {
+    expected.insert(expected.end(), 4, fill);
+  }
+  ASSERT_EQ(mock_socket->GetWrites().size(), 1u);
+  EXPECT_EQ(mock_socket->GetWrites().front(), expected);
+}
+
+TEST(TcpConnectionTest, ReplaceableStateShedInsteadOfClosing) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  bool disconnected = false;
+  connection->SetDisconnectHandler([&](uint64_t) { disconnected = true; });
+
+  // 2 MB of distinct entity state arriving faster than it can be written.
+  constexpr size_t kUpdateSize = 1024;
+  for (uint64_t key = 1; key <= 2048; ++key) {
+    connection->SendBuffer(MakeBuffer(kUpdateSize, static_cast<uint8_t>(key % 251)), key);
+  }
+  const std::vector<uint8_t> reliable(64, 0xEE);
+  connection->SendRaw(reliable);
+  io_context.run();
+
+  EXPECT_FALSE(disconnected);
+  EXPECT_FALSE(mock_socket->IsClosed());
+  // Exactly the replaceable budget's worth of the newest state survives, oldest shed first.
+  std::vector<uint8_t> stream;
+  for (const auto& write : mock_socket->GetWrites()) {
+    stream.insert(stream.end(), write.begin(), write.end());
+  }
+  ASSERT_EQ(stream.size(), 256 * kUpdateSize + reliable.size());
+  EXPECT_TRUE(std::equal(reliable.begin(), reliable.end(), stream.end() - reliable.size()));
+  EXPECT_EQ(*(stream.end() - reliable.size() - 1), static_cast<uint8_t>(2048 % 251));
+  EXPECT_EQ(stream.front(), static_cast<uint8_t>((2048 - 255) % 251));
+}
+
+TEST(TcpConnectionTest, ReliableOverflowShedsStateBeforeClosing) {
+  asio::io_context io_context;
+  MockSocket* mock_socket = nullptr;
+  auto connection = CreateConnection(io_context, &mock_socket);
+
+  bool disconnected = false;
+  connection->SetDisconnectHandler([&](uint64_t) { disconnected = true; });
+
+  for (uint64_t key = 1; key <= 100; ++key) {
+    connection->SendBuffer(MakeBuffer(1024, 0x11), key);
+  }
+  const std::vector<uint8_t> chunk(256 * 1024, 0xCD);
+  for (int i = 0; i < 4; ++i) {
+    connection->SendRaw(chunk);
+  }
+  io_context.run();
+
+  EXPECT_FALSE(disconnected);
+  EXPECT_EQ(TotalWritten(*mock_socket), 4 * chunk.size());
+}
+
 }  // namespace mir2::network
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include "network/tcp_server.h"
+
+namespace mir2::network {
+
+namespace {
+
+/**
+ * Runs each io_context on its own thread, mirroring Application's per-core mode.
+ */
+class PerCoreContexts {
+ public:
+  explicit PerCoreContexts(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      contexts_.push_back(std::make_unique<asio::io_context>(1));
+      guards_.push_back(asio::make_work_guard(*contexts_.back()));
+    }
+  }
+
+  ~PerCoreContexts() { Stop(); }
+
+  void Run() {
+    for (auto& context : contexts_) {
+      threads_.emplace_back([&context]() { context->run(); });
+    }
+  }
+
+  void Stop() {
+    guards_.clear();
+    for (auto& context : contexts_) {
+      context->stop();
+    }
+    for (auto& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    threads_.clear();
+  }
+
+  std::vector<asio::io_context*> Pointers() const {
+    std::vector<asio::io_context*> pointers;
+    for (const auto& context : contexts_) {
+      pointers.push_back(context.get());
+    }
+    return pointers;
+  }
+
+  asio::io_context& At(size_t index) { return *contexts_[index]; }
+
+ private:
+  std::vector<std::unique_ptr<asio::io_context>> contexts_;
+  std::vector<asio::executor_work_guard<asio::io_context::executor_type>> guards_;
+  std::vector<std::thread> threads_;
+};
+
+bool WaitFor(const std::function<bool()>& predicate) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(TcpServerTest, SharedContextUsesSingleAcceptor) {
+  asio::io_context io_context;
+  TcpServer server(io_context);
+  ASSERT_TRUE(server.Start("127.0.0.1", 0, 10));
+  EXPECT_EQ(server.GetAcceptorCount(), 1u);
+  EXPECT_NE(server.GetListenPort(), 0);
+  server.Stop();
+}
+
+TEST(TcpServerTest, PerCoreConnectionsArePinnedToAcceptingContext) {
+  constexpr size_t kCores = 2;
+  constexpr int kClients = 16;
+  PerCoreContexts cores(kCores);
+
+  asio::io_context unused;
+  TcpServer server(unused);
+  server.SetIoContexts(cores.Pointers());
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<TcpConnection>> accepted;
+  std::atomic<int> pinned{0};
+  server.SetConnectHandler([&](const std::shared_ptr<TcpConnection>& connection) {
+    for (size_t i = 0; i < kCores; ++i) {
+      // The socket must belong to a per-core context, never the fallback one.
+      if (connection->GetExecutor() == IoExecutor(cores.At(i).get_executor())) {
+        pinned.fetch_add(1);
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    accepted.push_back(connection);
+  });
+
+  ASSERT_TRUE(server.Start("127.0.0.1", 0, kClients));
+#ifdef SO_REUSEPORT
+  EXPECT_EQ(server.GetAcceptorCount(), kCores);
+#else
+  EXPECT_EQ(server.GetAcceptorCount(), 1u);
+#endif
+  const uint16_t port = server.GetListenPort();
+  ASSERT_NE(port, 0);
+  cores.Run();
+
+  asio::io_context client_context;
+  std::vector<asio::ip::tcp::socket> clients;
+  for (int i = 0; i < kClients; ++i) {
+    clients.emplace_back(client_context);
+    clients.back().connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+  }
+
+  ASSERT_TRUE(WaitFor([&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return accepted.size() == static_cast<size_t>(kClients);
+  }));
+  EXPECT_EQ(pinned.load(), kClients);
+
+  server.Stop();
+  cores.Stop();
+}
+
+}  // namespace mir2::network
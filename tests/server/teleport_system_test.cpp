@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <vector>
+
 using namespace mir2::ecs;
 using namespace mir2::game::map;
 
@@ -146,3 +149,29 @@ TEST_F(TeleportSystemTest, TeleportToInvalidPosition) {
   auto* map = scene_manager_.GetMapByEntity(entity);
   EXPECT_EQ(map->GetMapId(), 1);
 }
+
+// 测试注入的执行入口：传送在入口执行前不生效
+TEST_F(TeleportSystemTest, CrossMapTeleportRunsThroughInjectedSink) {
+  std::vector<std::function<void()>> deferred;
+  TeleportSystem deferring_system(scene_manager_, event_bus_,
+                                  [&deferred](std::function<void()> apply) {
+                                    deferred.push_back(std::move(apply));
+                                  });
+
+  auto entity = registry_.create();
+  registry_.emplace<CharacterStateComponent>(entity, uint32_t{1}, mir2::common::Position{10, 10});
+  scene_manager_.AddEntityToMap(1, entity, 10, 10);
+
+  deferring_system.RequestTeleport(TeleportCommand{entity, 2, 50, 50});
+  deferring_system.Update(registry_, 0.0f);
+
+  // 仅入队，实体仍在地图1
+  ASSERT_EQ(deferred.size(), 1u);
+  EXPECT_EQ(scene_manager_.GetMapByEntity(entity)->GetMapId(), 1);
+  EXPECT_EQ(registry_.get<CharacterStateComponent>(entity).map_id, 1u);
+
+  // 执行推迟的操作（对应合并阶段）后传送完成
+  deferred.front()();
+  EXPECT_EQ(scene_manager_.GetMapByEntity(entity)->GetMapId(), 2);
+  EXPECT_EQ(registry_.get<CharacterStateComponent>(entity).map_id, 2u);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "core/timer.h"
+
+namespace mir2::core {
+
+TEST(TickBudgetTest, ZeroBudgetIsNeverExhausted) {
+  TickBudget budget;
+  budget.Begin(std::chrono::microseconds(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_FALSE(budget.Exhausted());
+}
+
+TEST(TickBudgetTest, ExhaustedAfterBudgetElapses) {
+  TickBudget budget;
+  budget.Begin(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(3));
+  EXPECT_TRUE(budget.Exhausted());
+  EXPECT_GE(budget.Elapsed(), std::chrono::milliseconds(1));
+}
+
+TEST(TickBudgetTest, BeginRestartsTheClock) {
+  TickBudget budget;
+  budget.Begin(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(3));
+  ASSERT_TRUE(budget.Exhausted());
+
+  budget.Begin(std::chrono::seconds(10));
+  EXPECT_FALSE(budget.Exhausted());
+  EXPECT_LT(budget.Elapsed(), std::chrono::seconds(10));
+}
+
+}  // namespace mir2::core
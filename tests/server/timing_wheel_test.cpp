@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "network/timing_wheel.h"
+
+namespace mir2::network {
+
+namespace {
+
+std::vector<uint64_t> AdvanceTo(TimingWheel& wheel, int64_t now_ms) {
+  std::vector<uint64_t> expired;
+  wheel.Advance(now_ms, expired);
+  std::sort(expired.begin(), expired.end());
+  return expired;
+}
+
+}  // namespace
+
+TEST(TimingWheelTest, FiresAtDeadlineNotBefore) {
+  TimingWheel wheel(100, 1000);
+  wheel.Schedule(1, 1000 + 30000);
+
+  EXPECT_TRUE(AdvanceTo(wheel, 1000 + 29999).empty());
+  EXPECT_EQ(AdvanceTo(wheel, 1000 + 30000), std::vector<uint64_t>{1});
+  EXPECT_EQ(wheel.Size(), 0u);
+}
+
+TEST(TimingWheelTest, RescheduleMovesDeadline) {
+  TimingWheel wheel(100, 0);
+  wheel.Schedule(7, 500);
+  wheel.Schedule(7, 90000);
+  EXPECT_EQ(wheel.Size(), 1u);
+
+  EXPECT_TRUE(AdvanceTo(wheel, 89900).empty());
+  EXPECT_EQ(AdvanceTo(wheel, 90000), std::vector<uint64_t>{7});
+}
+
+TEST(TimingWheelTest, CancelRemovesEntry) {
+  TimingWheel wheel(100, 0);
+  wheel.Schedule(1, 1000);
+  wheel.Schedule(2, 1000);
+  EXPECT_TRUE(wheel.Cancel(1));
+  EXPECT_FALSE(wheel.Cancel(1));
+
+  EXPECT_EQ(AdvanceTo(wheel, 1000), std::vector<uint64_t>{2});
+}
+
+TEST(TimingWheelTest, PastDeadlineReportedOnNextAdvance) {
+  TimingWheel wheel(100, 5000);
+  wheel.Schedule(3, 4000);
+  EXPECT_EQ(AdvanceTo(wheel, 5000), std::vector<uint64_t>{3});
+}
+
+TEST(TimingWheelTest, LongDeadlinesCascadeThroughLevels) {
+  TimingWheel wheel(1, 0);
+  const std::vector<int64_t> deadlines = {255, 256, 257, 16383, 16384, 1 << 20, (1 << 20) + 1,
+                                          (int64_t{1} << 26) + 5};
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    wheel.Schedule(i, deadlines[i]);
+  }
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    EXPECT_TRUE(AdvanceTo(wheel, deadlines[i] - 1).empty()) << deadlines[i];
+    EXPECT_EQ(AdvanceTo(wheel, deadlines[i]), std::vector<uint64_t>{i}) << deadlines[i];
+  }
+}
+
+TEST(TimingWheelTest, MatchesReferenceUnderRandomLoad) {
+  std::mt19937_64 rng(42);
+  TimingWheel wheel(10, 0);
+  std::unordered_map<uint64_t, int64_t> reference;
+  int64_t now_ms = 0;
+  for (int step = 0; step < 20000; ++step) {
+    const uint64_t id = rng() % 500;
+    switch (rng() % 3) {
+      case 0:
+      case 1: {
+        const int64_t deadline = now_ms + static_cast<int64_t>(rng() % 200000);
+        wheel.Schedule(id, deadline);
+        reference[id] = deadline;
+        break;
+      }
+      default:
+        EXPECT_EQ(wheel.Cancel(id), reference.erase(id) != 0);
+        break;
+    }
+    now_ms += static_cast<int64_t>(rng() % 50);
+
+    std::vector<uint64_t> expected;
+    for (auto it = reference.begin(); it != reference.end();) {
+      // Expiry is tick-granular: deadlines round up to the next 10ms tick.
+      if ((it->second + 9) / 10 * 10 <= now_ms) {
+        expected.push_back(it->first);
+        it = reference.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(AdvanceTo(wheel, now_ms), expected) << "step " << step;
+  }
+  EXPECT_EQ(wheel.Size(), reference.size());
+}
+
+}  // namespace mir2::network